@@ -0,0 +1,8 @@
+#version 460 core
+
+flat in vec3 EdgeColor;
+out vec4 FragColor;
+
+void main() {
+    FragColor = vec4(EdgeColor, 1.0);
+}
@@ -0,0 +1,28 @@
+#version 460 core
+
+layout (location = 0) in vec3 aPos;
+
+// std140 blocks (see UniformBlocks.h)
+layout (std140, binding = 0) uniform CameraBlock {
+    mat4 view;
+    mat4 projection;
+    vec3 viewPos;
+};
+
+// Per-object block, bound at the object's offset in the uniform ring
+layout (std140, binding = 3) uniform ObjectBlock {
+    mat4 model;
+    mat4 normalMatrix;  // Unused
+    vec3 objectColor;
+};
+
+flat out vec3 EdgeColor;
+
+void main() {
+    EdgeColor = objectColor;
+    gl_Position = projection * view * model * vec4(aPos, 1.0);
+
+    // Pull the lines slightly towards the camera so they win the depth test
+    // against the faces they lie on
+    gl_Position.z -= 0.0002 * gl_Position.w;
+}
@@ -4,29 +4,36 @@ in vec3 FragPos;
 in vec3 Normal;
 in vec2 TexCoord;
 in float SolutionValue;
+flat in vec3 ObjectColor;
 
 out vec4 FragColor;
 
-struct Light {
-    vec3 direction;
-    vec3 color;
+// std140 blocks (see UniformBlocks.h)
+layout (std140, binding = 0) uniform CameraBlock {
+    mat4 view;
+    mat4 projection;
+    vec3 viewPos;
+};
+
+layout (std140, binding = 1) uniform LightingBlock {
+    vec3 direction;   // Normalized
     float ambient;
+    vec3 color;
     float diffuse;
+    vec3 rimColor;
     float specular;
+    float rimStrength;
+    bool hasTexture;
+} light;
+
+// Solution visualization
+layout (std140, binding = 2) uniform SolutionBlock {
+    bool showSolution;
+    float solutionMin;
+    float solutionMax;
 };
 
-uniform Light light;
-uniform vec3 viewPos;
-uniform vec3 objectColor;
-uniform float rimStrength;
-uniform vec3 rimColor;
-uniform sampler2D diffuseMap;
-uniform bool hasTexture;
-
-// Solution visualization uniforms
-uniform bool showSolution;
-uniform float solutionMin;
-uniform float solutionMax;
+layout (binding = 0) uniform sampler2D diffuseMap;
 
 // Blue-white-red colormap for solution visualization
 vec3 solutionColormap(float value) {
@@ -54,16 +61,16 @@ void main() {
         norm = -norm;
     }
 
-    vec3 lightDir = normalize(-light.direction);
+    vec3 lightDir = -light.direction;
 
     // Get base color based on mode
     vec3 baseColor;
     if (showSolution) {
         baseColor = solutionColormap(SolutionValue);
-    } else if (hasTexture) {
+    } else if (light.hasTexture) {
         baseColor = texture(diffuseMap, TexCoord).rgb;
     } else {
-        baseColor = objectColor;
+        baseColor = ObjectColor;
     }
 
     // Ambient
@@ -81,7 +88,7 @@ void main() {
     // Rim/Fresnel lighting - highlights edges facing away from viewer
     float rim = 1.0 - max(dot(viewDir, norm), 0.0);
     rim = smoothstep(0.4, 1.0, rim);  // Sharpen the rim
-    vec3 rimLight = rimStrength * rim * rimColor;
+    vec3 rimLight = light.rimStrength * rim * light.rimColor;
 
     vec3 result = (ambient + diffuse + specular) * baseColor + rimLight;
     FragColor = vec4(result, 1.0);
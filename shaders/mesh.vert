@@ -9,17 +9,28 @@ out vec3 FragPos;
 out vec3 Normal;
 out vec2 TexCoord;
 out float SolutionValue;
+flat out vec3 ObjectColor;
 
-uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
-uniform mat3 normalMatrix;
+// std140 blocks (see UniformBlocks.h)
+layout (std140, binding = 0) uniform CameraBlock {
+    mat4 view;
+    mat4 projection;
+    vec3 viewPos;
+};
+
+// Per-object block, bound at the object's offset in the uniform ring
+layout (std140, binding = 3) uniform ObjectBlock {
+    mat4 model;
+    mat4 normalMatrix;  // mat3 stored as mat4 columns
+    vec3 objectColor;
+};
 
 void main() {
     FragPos = vec3(model * vec4(aPos, 1.0));
-    Normal = normalMatrix * aNormal;
+    Normal = mat3(normalMatrix) * aNormal;
     TexCoord = aTexCoord;
     SolutionValue = aSolutionValue;
+    ObjectColor = objectColor;
 
     gl_Position = projection * view * vec4(FragPos, 1.0);
 }
@@ -0,0 +1,43 @@
+#version 460 core
+
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aNormal;
+layout (location = 2) in vec2 aTexCoord;
+layout (location = 3) in float aSolutionValue;
+
+out vec3 FragPos;
+out vec3 Normal;
+out vec2 TexCoord;
+out float SolutionValue;
+flat out vec3 ObjectColor;
+
+// Per-object data; an instanced command's instances are consecutive entries
+// starting at its baseInstance
+struct ObjectData {
+    mat4 model;
+    mat4 normalMatrix;  // mat3 stored as mat4 columns
+    vec4 color;
+};
+
+layout (std430, binding = 0) readonly buffer ObjectBuffer {
+    ObjectData objects[];
+};
+
+// std140 blocks (see UniformBlocks.h)
+layout (std140, binding = 0) uniform CameraBlock {
+    mat4 view;
+    mat4 projection;
+    vec3 viewPos;
+};
+
+void main() {
+    ObjectData object = objects[gl_BaseInstance + gl_InstanceID];
+
+    FragPos = vec3(object.model * vec4(aPos, 1.0));
+    Normal = mat3(object.normalMatrix) * aNormal;
+    TexCoord = aTexCoord;
+    SolutionValue = aSolutionValue;
+    ObjectColor = object.color.rgb;
+
+    gl_Position = projection * view * vec4(FragPos, 1.0);
+}
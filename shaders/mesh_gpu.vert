@@ -0,0 +1,100 @@
+#version 460 core
+
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aNormal;
+layout (location = 2) in vec2 aTexCoord;
+layout (location = 3) in float aSolutionValue;
+
+out vec3 FragPos;
+out vec3 Normal;
+out vec2 TexCoord;
+out float SolutionValue;
+flat out vec3 ObjectColor;
+
+// Must match cull.comp and cluster_cull.comp
+struct ObjectRecord {
+    mat4 model;
+    mat4 normalMatrix;
+    vec4 color;
+    vec4 boundsMin;
+    vec4 boundsMax;
+    uint lodCount;
+    uint group;
+    uint flags;
+    uint reserved;
+};
+
+struct MeshRange {
+    uint firstIndex;
+    uint indexCount;
+    int baseVertex;
+    uint wideIndices;
+    uint clusterCount;
+    uint reserved0;
+    uint reserved1;
+    uint reserved2;
+    vec4 positionOffset;
+    vec4 positionScale;
+};
+
+const uint FLAG_SELECTED = 2u;
+const uint FLAG_HOVERED = 4u;
+const uint RANGES_PER_OBJECT = 8u;
+
+layout (std430, binding = 0) readonly buffer ObjectBuffer {
+    ObjectRecord objects[];
+};
+
+layout (std430, binding = 1) readonly buffer RangeBuffer {
+    MeshRange ranges[];
+};
+
+layout (std430, binding = 2) readonly buffer LodStateBuffer {
+    uint currentLod[];
+};
+
+// std140 blocks (see UniformBlocks.h)
+layout (std140, binding = 0) uniform CameraBlock {
+    mat4 view;
+    mat4 projection;
+    vec3 viewPos;
+};
+
+uniform bool lodDebugColors;
+
+// Green -> Yellow -> Orange -> Red for LOD 0-5 (as in Renderer)
+const vec3 LOD_DEBUG_COLORS[6] = vec3[](
+    vec3(0.2, 1.0, 0.3),
+    vec3(0.6, 1.0, 0.2),
+    vec3(1.0, 1.0, 0.2),
+    vec3(1.0, 0.7, 0.2),
+    vec3(1.0, 0.4, 0.2),
+    vec3(1.0, 0.2, 0.2)
+);
+
+void main() {
+    // Written by the cull pass as the command's baseInstance
+    uint rangeIndex = uint(gl_BaseInstance);
+    uint id = rangeIndex / RANGES_PER_OBJECT;
+
+    // Stored positions may be quantized within the mesh bounds
+    vec3 position = ranges[rangeIndex].positionOffset.xyz + aPos * ranges[rangeIndex].positionScale.xyz;
+    FragPos = vec3(objects[id].model * vec4(position, 1.0));
+    Normal = mat3(objects[id].normalMatrix) * aNormal;
+    TexCoord = aTexCoord;
+    SolutionValue = aSolutionValue;
+
+    vec3 color = objects[id].color.rgb;
+    if (lodDebugColors && objects[id].lodCount > 0u) {
+        color = LOD_DEBUG_COLORS[min(currentLod[id], 5u)];
+    }
+    if ((objects[id].flags & FLAG_SELECTED) != 0u) {
+        color = mix(color, vec3(1.0, 0.5, 0.0), 0.5);
+    }
+    if ((objects[id].flags & FLAG_HOVERED) != 0u) {
+        color = mix(color, vec3(1.0), 0.25);
+    }
+    ObjectColor = color;
+
+    gl_Position = projection * view * vec4(FragPos, 1.0);
+}
@@ -1,15 +1,13 @@
 #version 460 core
 
 in vec2 TexCoord;
+in vec4 Color;
 out vec4 FragColor;
 
 uniform sampler2D fontTexture;
-uniform vec4 textColor;
-uniform vec4 bgColor;
 
 void main() {
+    // Glyph coverage; quads sample the font's solid cell
     float alpha = texture(fontTexture, TexCoord).r;
-
-    // Mix background and text color based on font alpha
-    FragColor = mix(bgColor, textColor, alpha);
+    FragColor = Color * alpha;
 }
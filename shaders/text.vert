@@ -2,8 +2,10 @@
 
 layout (location = 0) in vec2 aPos;
 layout (location = 1) in vec2 aTexCoord;
+layout (location = 2) in vec4 aColor;
 
 out vec2 TexCoord;
+out vec4 Color;
 
 uniform vec2 screenSize;
 
@@ -13,4 +15,5 @@ void main() {
     ndc.y = -ndc.y; // Flip Y so origin is top-left
     gl_Position = vec4(ndc, 0.0, 1.0);
     TexCoord = aTexCoord;
+    Color = aColor;
 }
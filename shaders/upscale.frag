@@ -0,0 +1,14 @@
+#version 460 core
+
+in vec2 vUV;
+out vec4 FragColor;
+
+uniform sampler2D sceneTexture;
+uniform vec2 uvScale;
+
+void main() {
+    // Bilinear upscale; stay half a texel inside the rendered region so
+    // filtering never reads texels outside it
+    vec2 limit = uvScale - 0.5 / vec2(textureSize(sceneTexture, 0));
+    FragColor = vec4(texture(sceneTexture, min(vUV, limit)).rgb, 1.0);
+}
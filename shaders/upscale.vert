@@ -0,0 +1,12 @@
+#version 460 core
+
+out vec2 vUV;
+
+uniform vec2 uvScale;  // Rendered fraction of the scene texture
+
+void main() {
+    // Full-screen triangle from the vertex index; no vertex buffer
+    vec2 pos = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+    vUV = pos * uvScale;
+    gl_Position = vec4(pos * 2.0 - 1.0, 0.0, 1.0);
+}
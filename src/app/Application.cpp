@@ -1,14 +1,31 @@
 #include "Application.h"
 #include "mesh/MeshLoader.h"
 #include "mesh/MeshData.h"
+#include "mesh/ObjLoader.h"
+#include "geometry/MeshOptimizer.h"
+#include "geometry/MeshSplitter.h"
 #include "async/LODTask.h"
 #include "async/SubdivisionTask.h"
+#include "async/BVHTask.h"
+#include "async/FeatureEdgeTask.h"
 #include <iostream>
 #include <algorithm>
+#include <unordered_set>
 #include <GLFW/glfw3.h>
 
+namespace {
+    constexpr int REDRAW_SETTLE_FRAMES = 2;     // GPU-driven stats arrive one frame late
+    constexpr double PROGRESS_INTERVAL = 0.1;   // Progress overlay refresh while tasks run
+    constexpr double IDLE_TIMEOUT = 0.5;        // Longest wait when nothing happens
+    constexpr double READBACK_POLL_INTERVAL = 0.002;  // While a GPU readback is in flight
+
+    // Mesh results applied per frame; each may start a large staged upload
+    constexpr size_t MESH_APPLIES_PER_FRAME = 4;
+}
+
 Application::Application(int width, int height, const std::string& title,
-                         float creaseAngle, const std::string& defaultTexture)
+                         float creaseAngle, const std::string& defaultTexture,
+                         const std::string& cacheDirectory)
     : m_camera(5.0f)
     , m_creaseAngle(creaseAngle)
     , m_defaultTexturePath(defaultTexture)
@@ -16,16 +33,37 @@ Application::Application(int width, int height, const std::string& title,
     m_window = std::make_unique<Window>(width, height, title);
     m_renderer = std::make_unique<Renderer>();
     m_renderer->init(width, height, m_defaultTexturePath);
+    m_stagingRing = std::make_unique<StagingRing>();
+    m_stagingRing->init();
     m_subdivisionManager = std::make_unique<SubdivisionManager>();
     m_lodManager = std::make_unique<LODManager>();
+    m_bvhManager = std::make_unique<BVHManager>();
+    m_featureEdgeManager = std::make_unique<FeatureEdgeManager>();
     m_multipatchManager = std::make_unique<MultiPatchManager>();
+    m_geometryCache = std::make_unique<GeometryCache>(cacheDirectory);
+    m_textureManager = std::make_unique<TextureManager>();
+
+    // Subdivision and tessellation results reach the GPU through the staging ring
+    m_subdivisionManager->setStagingRing(m_stagingRing.get());
+    m_multipatchManager->setStagingRing(m_stagingRing.get());
 
     // Pass managers to renderer for progress display
     m_renderer->setSubdivisionManager(m_subdivisionManager.get());
     m_renderer->setLODManager(m_lodManager.get());
     m_renderer->setMultiPatchManager(m_multipatchManager.get());
+    m_renderer->setTextureManager(m_textureManager.get());
+
+    // Finished background tasks wake the main loop out of waitEvents()
+    m_subdivisionManager->setCompletionCallback(Window::postEmptyEvent);
+    m_lodManager->setCompletionCallback(Window::postEmptyEvent);
+    m_bvhManager->setCompletionCallback(Window::postEmptyEvent);
+    m_featureEdgeManager->setCompletionCallback(Window::postEmptyEvent);
+    m_multipatchManager->setCompletionCallback(Window::postEmptyEvent);
+    m_textureManager->setCompletionCallback(Window::postEmptyEvent);
+    m_stagingRing->setWakeCallback(Window::postEmptyEvent);
 
     setupCallbacks();
+    requestRedraw();
 }
 
 void Application::setupCallbacks() {
@@ -45,6 +83,11 @@ void Application::setupCallbacks() {
         onScroll(xoffset, yoffset);
     });
 
+    // Window uncovered or damaged
+    m_window->setRefreshCallback([this]() {
+        requestRedraw();
+    });
+
     m_window->setResizeCallback([this](int width, int height) {
         onResize(width, height);
     });
@@ -61,21 +104,82 @@ int Application::run(const std::vector<std::string>& meshPaths) {
         focusOnScene();
     }
 
+    // Event-driven loop: draw only when something changed, otherwise block
+    // until input arrives, a background task finishes or the timeout expires
     while (!m_window->shouldClose()) {
         m_timer.update();
         processInput();
         update(m_timer.getDeltaTimeF());
-        render();
-        m_window->swapBuffers();
-        m_window->pollEvents();
+
+        // GPU-driven stats and visibility (and with them texture requests)
+        // only change through the readback; show a changed result once
+        if (m_renderer->pollReadback()) {
+            m_redrawFrames = std::max(m_redrawFrames, 1);
+        }
+
+        if (needsRedraw()) {
+            render();
+            m_window->swapBuffers();
+            m_renderedRevision = SceneObject::getLatestRevision();
+            m_lastRenderTime = m_timer.getTime();
+            if (m_redrawFrames > 0) {
+                --m_redrawFrames;
+            }
+        }
+
+        // Going idle: the last frame must be a still one at full resolution,
+        // not one upscaled from the scale the motion left behind
+        if (m_redrawFrames == 0 && !isAnimating() && m_renderer->isResolutionReduced()) {
+            m_redrawFrames = 1;
+        }
+
+        if (isAnimating() || m_redrawFrames > 0) {
+            m_window->pollEvents();
+        } else if (m_renderer->hasPendingReadback()) {
+            // Not blocking for long: the readback may start texture decodes
+            m_window->waitEvents(READBACK_POLL_INTERVAL);
+        } else if (hasBackgroundWork()) {
+            m_window->waitEvents(PROGRESS_INTERVAL);
+        } else {
+            m_window->waitEvents(IDLE_TIMEOUT);
+        }
     }
 
     return 0;
 }
 
+void Application::requestRedraw() {
+    m_redrawFrames = std::max(m_redrawFrames, REDRAW_SETTLE_FRAMES);
+}
+
+bool Application::needsRedraw() const {
+    if (m_redrawFrames > 0 || isAnimating()) {
+        return true;
+    }
+    // Any object change the renderer mirrors (meshes, LODs, selection, ...)
+    if (SceneObject::getLatestRevision() != m_renderedRevision) {
+        return true;
+    }
+    return hasBackgroundWork() && m_timer.getTime() - m_lastRenderTime >= PROGRESS_INTERVAL;
+}
+
+bool Application::isAnimating() const {
+    return isInteracting() || m_renderer->isRefining() ||
+           m_textureManager->hasPendingUploads() || m_scene.hasPendingUploads() ||
+           m_stagingRing->hasPendingWork();
+}
+
+bool Application::hasBackgroundWork() const {
+    return m_subdivisionManager->hasPendingWork() || m_lodManager->hasPendingWork() ||
+           m_bvhManager->hasPendingWork() || m_featureEdgeManager->hasPendingWork() ||
+           m_multipatchManager->hasPendingWork() || m_textureManager->hasPendingWork();
+}
+
 void Application::processInput() {
     // Arrow keys for camera orbit (continuous while held)
     const float orbitSpeed = 2.0f;
+    m_keyOrbiting = m_window->isKeyPressed(GLFW_KEY_LEFT) || m_window->isKeyPressed(GLFW_KEY_RIGHT) ||
+                    m_window->isKeyPressed(GLFW_KEY_UP) || m_window->isKeyPressed(GLFW_KEY_DOWN);
 
     if (m_window->isKeyPressed(GLFW_KEY_LEFT)) {
         m_camera.orbit(orbitSpeed, 0.0f);
@@ -95,14 +199,34 @@ void Application::update(float deltaTime) {
     // Update camera animation
     m_cameraAnimation.update(deltaTime, m_camera);
 
+    // Results applied below change what is drawn
+    int completed = 0;
+
     // Process completed subdivision tasks (GPU upload on main thread)
-    m_subdivisionManager->processCompletedTasks();
+    completed += m_subdivisionManager->processCompletedTasks(MESH_APPLIES_PER_FRAME);
 
     // Process completed LOD generation tasks
-    m_lodManager->processCompletedTasks();
+    completed += m_lodManager->processCompletedTasks();
+
+    // Attach triangle BVHs built for picking
+    completed += m_bvhManager->processCompletedTasks();
+
+    // Upload feature edges for the edge overlay
+    completed += m_featureEdgeManager->processCompletedTasks();
 
     // Process completed tessellation tasks for multipatch
-    m_multipatchManager->processCompletedTasks();
+    completed += m_multipatchManager->processCompletedTasks(MESH_APPLIES_PER_FRAME);
+
+    // Upload decoded textures and release ones over the VRAM budget
+    completed += m_textureManager->processCompletedTasks();
+    m_textureManager->update();
+
+    // Copy staged mesh data into its buffers, a bounded amount per frame
+    m_stagingRing->update();
+
+    if (completed > 0) {
+        requestRedraw();
+    }
 
     // Auto-enable solution visualization when Poisson solving completes
     if (m_multipatchManager->isSolutionReady()) {
@@ -110,9 +234,12 @@ void Application::update(float deltaTime) {
         m_renderer->setSolutionVisualization(true);
     }
 
-    // Update multipatch tessellation based on view
-    m_multipatchManager->updateTessellation(m_camera, m_window->getAspectRatio(),
-                                            m_window->getWidth(), m_window->getHeight());
+    // Update multipatch tessellation based on view; deferred while the camera
+    // moves so retessellation does not compete with interaction
+    if (!m_renderer->isInteractiveQuality() || !isInteracting()) {
+        m_multipatchManager->updateTessellation(m_camera, m_window->getAspectRatio(),
+                                                m_window->getWidth(), m_window->getHeight());
+    }
 
     // Check for objects that need LOD regeneration (after subdivision)
     for (const auto& obj : m_scene.getObjects()) {
@@ -120,6 +247,21 @@ void Application::update(float deltaTime) {
             obj->clearLODRegenerationFlag();
             generateLODForObject(obj.get());
         }
+
+        // Rebuild the picking BVH whenever the mesh data was replaced
+        if (obj->needsTriangleBVH()) {
+            obj->clearTriangleBVHFlag();
+            m_bvhManager->submitTask(std::make_unique<BVHTask>(
+                obj.get(), obj->getName(), obj->getMeshData(), obj->getMeshDataVersion()));
+        }
+
+        // Feature edges are extracted from the same mesh data
+        if (obj->needsFeatureEdges()) {
+            obj->clearFeatureEdgesFlag();
+            m_featureEdgeManager->submitTask(std::make_unique<FeatureEdgeTask>(
+                obj.get(), obj->getName(), obj->getMeshData(), obj->getMeshDataVersion(),
+                m_featureEdgeAngle));
+        }
     }
 
     // Update scene objects (checks for completed async GPU uploads)
@@ -129,10 +271,18 @@ void Application::update(float deltaTime) {
 void Application::render() {
     // Update animation state for help overlay
     m_renderer->setAnimationState(m_cameraAnimation.isPlaying(), m_cameraAnimation.isLoaded());
+    m_renderer->setInteracting(isInteracting());
 
     m_renderer->render(m_scene, m_camera, m_window->getAspectRatio());
 }
 
+bool Application::isInteracting() const {
+    // A scroll is a single event; treat the camera as moving briefly after it
+    constexpr double SCROLL_SETTLE_TIME = 0.15;
+    const bool scrolling = m_lastScrollTime >= 0.0 && m_timer.getTime() - m_lastScrollTime < SCROLL_SETTLE_TIME;
+    return m_leftMouseDown || m_middleMouseDown || m_keyOrbiting || scrolling || m_cameraAnimation.isPlaying();
+}
+
 void Application::onKeyPressed(int key, int scancode, int action, int mods) {
     (void)scancode;
     (void)mods;
@@ -154,7 +304,7 @@ void Application::onKeyPressed(int key, int scancode, int action, int mods) {
                 }
                 break;
             case GLFW_KEY_W:
-                m_renderer->toggleWireframe();
+                m_renderer->cycleWireframeMode();
                 break;
             case GLFW_KEY_F:
             case GLFW_KEY_SPACE:
@@ -175,15 +325,30 @@ void Application::onKeyPressed(int key, int scancode, int action, int mods) {
             case GLFW_KEY_G:
                 m_renderer->toggleFrustumCulling();
                 break;
+            case GLFW_KEY_O:
+                m_renderer->toggleOcclusionCulling();
+                break;
+            case GLFW_KEY_M:
+                m_renderer->toggleClusterCulling();
+                break;
+            case GLFW_KEY_R:
+                m_renderer->toggleDynamicResolution();
+                break;
             case GLFW_KEY_L:
                 m_renderer->toggleLOD();
                 break;
             case GLFW_KEY_K:
                 m_renderer->toggleLODDebugColors();
                 break;
+            case GLFW_KEY_I:
+                m_renderer->toggleInteractiveQuality();
+                break;
             case GLFW_KEY_T:
                 m_renderer->toggleTextures();
                 break;
+            case GLFW_KEY_B:
+                m_renderer->cycleDrawPath();
+                break;
             case GLFW_KEY_P:
                 // Poisson solving / solution visualization toggle
                 if (m_multipatchManager->hasSolution()) {
@@ -201,10 +366,13 @@ void Application::onKeyPressed(int key, int scancode, int action, int mods) {
                 break;
         }
     }
+
+    requestRedraw();
 }
 
 void Application::onMouseButton(int button, int action, int mods) {
     (void)mods;
+    requestRedraw();
 
     if (button == GLFW_MOUSE_BUTTON_LEFT) {
         m_leftMouseDown = (action == GLFW_PRESS);
@@ -247,30 +415,61 @@ void Application::onMouseMove(double xpos, double ypos) {
 
     if (m_leftMouseDown) {
         m_camera.orbit(static_cast<float>(-deltaX), static_cast<float>(deltaY));
+        requestRedraw();
     }
 
     if (m_middleMouseDown) {
         m_camera.pan(static_cast<float>(deltaX), static_cast<float>(deltaY));
+        requestRedraw();
+    }
+
+    // Highlight the object under the cursor (not while dragging the camera)
+    if (!m_leftMouseDown && !m_middleMouseDown) {
+        updateHover(xpos, ypos);
     }
 
     m_lastMouseX = xpos;
     m_lastMouseY = ypos;
 }
 
+void Application::updateHover(double mouseX, double mouseY) {
+    int hoveredIndex = m_renderer->pick(
+        m_scene, m_camera, m_window->getAspectRatio(),
+        static_cast<int>(mouseX), static_cast<int>(mouseY)
+    );
+
+    SceneObject* hovered = hoveredIndex >= 0 ? m_scene.getObject(hoveredIndex) : nullptr;
+    if (hovered == m_hoveredObject) {
+        return;
+    }
+
+    if (m_hoveredObject) {
+        m_hoveredObject->setHovered(false);
+    }
+    if (hovered) {
+        hovered->setHovered(true);
+    }
+    m_hoveredObject = hovered;
+}
+
 void Application::onScroll(double xoffset, double yoffset) {
     (void)xoffset;
     m_camera.zoom(static_cast<float>(yoffset));
+    m_lastScrollTime = m_timer.getTime();
+    requestRedraw();
 }
 
 void Application::onResize(int width, int height) {
     m_renderer->resize(width, height);
+    requestRedraw();
 }
 
 bool Application::loadMesh(const std::string& path) {
     // Check if this is a multipatch file (G+Smo XML)
+    std::string ext;
     size_t dotPos = path.rfind('.');
     if (dotPos != std::string::npos) {
-        std::string ext = path.substr(dotPos);
+        ext = path.substr(dotPos);
         std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
 
         if (ext == ".xml") {
@@ -279,6 +478,62 @@ bool Application::loadMesh(const std::string& path) {
         }
     }
 
+    // Extract filename from path for naming
+    std::string name = path;
+    size_t lastSlash = path.find_last_of("/\\");
+    if (lastSlash != std::string::npos) {
+        name = path.substr(lastSlash + 1);
+    }
+
+    uint64_t cacheKey = m_geometryCache->isEnabled() ? m_geometryCache->keyForFile(path) : 0;
+
+    // Cache hit: skip parsing and simplification, upload LODs from the mapping
+    if (m_splitMode == SplitMode::None) {
+        if (auto entry = m_geometryCache->open(cacheKey)) {
+            MeshData meshData = entry->toMeshData(0);
+            if (addInstance(name, meshData)) {
+                return true;
+            }
+
+            SceneObject* obj = m_scene.addObject(name);
+            obj->setMeshData(meshData);
+            obj->setCacheKey(cacheKey);
+            assignObjectColor(obj);
+            assignObjectTexture(obj);
+            m_geometryLibrary.add(obj->getGeometry());
+
+            if (entry->hasLODChain()) {
+                obj->applyLODLevels(entry->uploadLODLevels());
+            } else {
+                generateLODForObject(obj);
+            }
+            std::cout << "Loaded " << name << " from cache" << std::endl;
+            return true;
+        }
+    }
+
+    // One object per OBJ shape/group
+    if (m_splitMode == SplitMode::Shapes && ext == ".obj") {
+        ObjLoader loader;
+        std::vector<ObjShape> shapes;
+        if (!loader.loadShapes(path, shapes)) {
+            return false;
+        }
+
+        std::vector<MeshData*> meshes;
+        for (ObjShape& shape : shapes) {
+            meshes.push_back(&shape.data);
+        }
+        optimizeMeshes(name, meshes);
+
+        for (size_t i = 0; i < shapes.size(); ++i) {
+            uint64_t partKey = cacheKey ? GeometryCache::deriveKey(cacheKey, "shape:" + std::to_string(i)) : 0;
+            addMeshObject(name + ":" + shapes[i].name, shapes[i].data, partKey, false);
+        }
+        std::cout << "Split " << name << " into " << shapes.size() << " shapes" << std::endl;
+        return true;
+    }
+
     // Standard mesh loading
     auto loader = MeshLoader::createForFile(path);
     if (!loader) {
@@ -291,19 +546,119 @@ bool Application::loadMesh(const std::string& path) {
         return false;
     }
 
-    // Extract filename from path for naming
-    std::string name = path;
-    size_t lastSlash = path.find_last_of("/\\");
-    if (lastSlash != std::string::npos) {
-        name = path.substr(lastSlash + 1);
+    // One object per connected component
+    if (m_splitMode == SplitMode::Components) {
+        std::vector<MeshData> parts = MeshSplitter::splitConnectedComponents(meshData);
+        if (parts.size() > 1) {
+            std::vector<MeshData*> meshes;
+            for (MeshData& part : parts) {
+                meshes.push_back(&part);
+            }
+            optimizeMeshes(name, meshes);
+
+            for (size_t i = 0; i < parts.size(); ++i) {
+                uint64_t partKey = cacheKey ? GeometryCache::deriveKey(cacheKey, "component:" + std::to_string(i)) : 0;
+                addMeshObject(name + "#" + std::to_string(i), parts[i], partKey, false);
+            }
+            std::cout << "Split " << name << " into " << parts.size() << " components" << std::endl;
+            return true;
+        }
+    }
+
+    // Chunks small enough for 16-bit indices, each culled on its own
+    if (m_splitMode == SplitMode::Chunks) {
+        std::vector<MeshData> parts = MeshSplitter::splitChunks(meshData);
+        if (parts.size() > 1) {
+            std::vector<MeshData*> meshes;
+            for (MeshData& part : parts) {
+                meshes.push_back(&part);
+            }
+            optimizeMeshes(name, meshes);
+
+            for (size_t i = 0; i < parts.size(); ++i) {
+                uint64_t partKey = cacheKey ? GeometryCache::deriveKey(cacheKey, "chunk:" + std::to_string(i)) : 0;
+                addMeshObject(name + "#" + std::to_string(i), parts[i], partKey, false);
+            }
+            std::cout << "Split " << name << " into " << parts.size() << " chunks" << std::endl;
+            return true;
+        }
+    }
+
+    optimizeMeshes(name, {&meshData});
+    addMeshObject(name, meshData, cacheKey, true);
+    return true;
+}
+
+void Application::optimizeMeshes(const std::string& name, const std::vector<MeshData*>& meshes) {
+    // Triangle-weighted, so the ACMR is that of the parts drawn together
+    double missesBefore = 0.0;
+    double missesAfter = 0.0;
+    size_t triangles = 0;
+
+    #pragma omp parallel for schedule(dynamic, 1) reduction(+:missesBefore, missesAfter, triangles)
+    for (size_t i = 0; i < meshes.size(); ++i) {
+        const size_t meshTriangles = meshes[i]->indices.size() / 3;
+        const MeshOptimizer::Result result = MeshOptimizer::optimize(*meshes[i]);
+        missesBefore += static_cast<double>(result.acmrBefore) * meshTriangles;
+        missesAfter += static_cast<double>(result.acmrAfter) * meshTriangles;
+        triangles += meshTriangles;
+    }
+
+    if (triangles > 0 && MeshOptimizer::getMode() != MeshOptimizer::Mode::Off) {
+        std::cout << "Optimized " << name << ": vertex cache ACMR " << missesBefore / triangles
+                  << " -> " << missesAfter / triangles << std::endl;
+    }
+}
+
+SceneObject* Application::addInstance(const std::string& name, const MeshData& meshData) {
+    glm::vec3 offset(0.0f);
+    auto geometry = m_geometryLibrary.find(meshData, offset);
+    if (!geometry) {
+        return nullptr;
+    }
+
+    // Shares mesh, LOD chain and BVH; only the transform and colour are new
+    SceneObject* obj = m_scene.addObject(name);
+    obj->setGeometry(std::move(geometry));
+    obj->setPosition(offset);
+    assignObjectColor(obj);
+    assignObjectTexture(obj);
+    std::cout << "Instanced " << name << " (same geometry as an earlier mesh)" << std::endl;
+    return obj;
+}
+
+SceneObject* Application::addMeshObject(const std::string& name, const MeshData& meshData,
+                                        uint64_t cacheKey, bool cacheBaseMesh) {
+    if (SceneObject* instance = addInstance(name, meshData)) {
+        return instance;
     }
 
     SceneObject* obj = m_scene.addObject(name);
     obj->setMeshData(meshData);
+    obj->setCacheKey(cacheKey);
+    assignObjectColor(obj);
+    assignObjectTexture(obj);
+    m_geometryLibrary.add(obj->getGeometry());
 
     // Generate LOD levels automatically for the loaded mesh
-    generateLODForObject(obj);
+    // (the LOD task writes the cache entry once the chain is built)
+    if (!generateLODForObject(obj) && cacheBaseMesh && cacheKey != 0) {
+        // Too small for LODs: cache the base mesh directly
+        m_geometryCache->store(cacheKey, meshData);
+    }
+
+    return obj;
+}
 
+void Application::assignObjectTexture(SceneObject* obj) {
+    // Shared per path; decoded in the background once the object is first drawn
+    const std::string& texturePath = obj->getMeshData().texturePath;
+    if (!texturePath.empty()) {
+        obj->setTexture(m_textureManager->acquire(texturePath));
+    }
+}
+
+void Application::assignObjectColor(SceneObject* obj) {
     // Assign different colors to each object
     static const glm::vec3 colors[] = {
         {0.8f, 0.3f, 0.3f},  // Red
@@ -317,8 +672,6 @@ bool Application::loadMesh(const std::string& path) {
     };
     size_t colorIndex = (m_scene.getObjectCount() - 1) % 8;
     obj->setColor(colors[colorIndex]);
-
-    return true;
 }
 
 void Application::focusOnScene() {
@@ -334,11 +687,17 @@ void Application::focusOnScene() {
 void Application::subdivideSelected(bool smooth) {
     bool anyQueued = false;
 
+    // Instances share their mesh: subdivide each geometry once, which refines
+    // all of its instances
+    std::unordered_set<const SharedGeometry*> queued;
+
     // Subdivide selected objects first
     for (const auto& obj : m_scene.getObjects()) {
-        if (obj->isSelected() && obj->canSubdivide()) {
+        if (obj->isSelected() && obj->canSubdivide() && queued.insert(obj->getGeometry().get()).second) {
             auto task = std::make_unique<SubdivisionTask>(
                 obj.get(), obj->getName(), obj->getMeshData(), smooth, m_creaseAngle);
+            task->cache = m_geometryCache.get();
+            task->cacheKey = obj->getCacheKey();
             m_subdivisionManager->submitTask(std::move(task));
             anyQueued = true;
         }
@@ -346,30 +705,38 @@ void Application::subdivideSelected(bool smooth) {
 
     // If nothing was selected, subdivide only visible objects (in frustum)
     if (!anyQueued) {
-        for (const auto& obj : m_scene.getObjects()) {
-            if (obj->canSubdivide() && m_renderer->isVisible(obj->getWorldBounds())) {
+        std::vector<uint32_t> visible;
+        m_renderer->collectVisible(m_scene, visible);
+        for (uint32_t index : visible) {
+            SceneObject* obj = m_scene.getObject(index);
+            if (obj->canSubdivide() && queued.insert(obj->getGeometry().get()).second) {
                 auto task = std::make_unique<SubdivisionTask>(
-                    obj.get(), obj->getName(), obj->getMeshData(), smooth, m_creaseAngle);
+                    obj, obj->getName(), obj->getMeshData(), smooth, m_creaseAngle);
+                task->cache = m_geometryCache.get();
+                task->cacheKey = obj->getCacheKey();
                 m_subdivisionManager->submitTask(std::move(task));
             }
         }
     }
 }
 
-void Application::generateLODForObject(SceneObject* obj) {
+bool Application::generateLODForObject(SceneObject* obj) {
     if (!obj || !obj->canSubdivide()) {
-        return;
+        return false;
     }
 
     // Only generate LOD if mesh has enough triangles to benefit
     const MeshData& meshData = obj->getMeshData();
     uint32_t triangleCount = static_cast<uint32_t>(meshData.indices.size() / 3);
     if (triangleCount < 100) {
-        return;
+        return false;
     }
 
     auto task = std::make_unique<LODTask>(obj, obj->getName(), meshData);
+    task->cache = m_geometryCache.get();
+    task->cacheKey = obj->getCacheKey();
     m_lodManager->submitTask(std::move(task));
+    return true;
 }
 
 bool Application::loadAnimation(const std::string& path) {
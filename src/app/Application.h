@@ -4,25 +4,44 @@
 #include "core/Timer.h"
 #include "renderer/Renderer.h"
 #include "renderer/Camera.h"
+#include "renderer/StagingRing.h"
 #include "scene/Scene.h"
+#include "scene/GeometryLibrary.h"
 #include "mesh/Mesh.h"
 #include "geometry/SubdivisionManager.h"
+#include "geometry/BVHManager.h"
+#include "geometry/FeatureEdgeManager.h"
 #include "lod/LODManager.h"
 #include "multipatch/MultiPatchManager.h"
 #include "animation/CameraAnimation.h"
+#include "cache/GeometryCache.h"
+#include "core/TextureManager.h"
 #include <memory>
 #include <string>
 #include <vector>
 
+// How a loaded file is turned into scene objects
+enum class SplitMode {
+    None,        // One object per file
+    Shapes,      // One object per OBJ shape/group
+    Components,  // One object per connected component
+    Chunks       // One object per chunk of at most 65,536 vertices
+};
+
 class Application {
 public:
     Application(int width, int height, const std::string& title,
                 float creaseAngle = 180.0f,
-                const std::string& defaultTexture = "assets/textures/default_grid.png");
+                const std::string& defaultTexture = "assets/textures/default_grid.png",
+                const std::string& cacheDirectory = "");
     ~Application() = default;
 
     int run(const std::vector<std::string>& meshPaths = {});
     bool loadAnimation(const std::string& path);
+    void setSplitMode(SplitMode mode) { m_splitMode = mode; }
+    void setTextureBudget(size_t bytes) { m_textureManager->setMemoryBudget(bytes); }
+    void setFeatureEdgeAngle(float degrees) { m_featureEdgeAngle = degrees; }
+    void setDynamicResolution(const DynamicResolution::Settings& settings) { m_renderer->setDynamicResolution(settings); }
 
 private:
     void setupCallbacks();
@@ -30,6 +49,12 @@ private:
     void update(float deltaTime);
     void render();
 
+    // On-demand rendering: frames are drawn only when something changed
+    void requestRedraw();
+    bool needsRedraw() const;
+    bool isAnimating() const;        // Needs a frame every vsync
+    bool hasBackgroundWork() const;  // Tasks running; progress overlays need refreshing
+
     void onKeyPressed(int key, int scancode, int action, int mods);
     void onMouseButton(int button, int action, int mods);
     void onMouseMove(double xpos, double ypos);
@@ -37,27 +62,52 @@ private:
     void onResize(int width, int height);
 
     bool loadMesh(const std::string& path);
+    // Reorder loaded meshes for the GPU (in parallel) and report the ACMR
+    void optimizeMeshes(const std::string& name, const std::vector<MeshData*>& meshes);
+    // Object sharing loaded geometry identical to meshData (null if there is none)
+    SceneObject* addInstance(const std::string& name, const MeshData& meshData);
+    SceneObject* addMeshObject(const std::string& name, const MeshData& meshData,
+                               uint64_t cacheKey, bool cacheBaseMesh);
+    void assignObjectColor(SceneObject* obj);
+    void assignObjectTexture(SceneObject* obj);
     void focusOnScene();
     void subdivideSelected(bool smooth);
-    void generateLODForObject(SceneObject* obj);
+    bool generateLODForObject(SceneObject* obj);  // Returns true if a task was queued
+    void updateHover(double mouseX, double mouseY);
+    bool isInteracting() const;  // Camera driven by mouse, keys, scroll or animation
 
     std::unique_ptr<Window> m_window;
     std::unique_ptr<Renderer> m_renderer;
+    std::unique_ptr<StagingRing> m_stagingRing;    // Outlives the managers whose workers fill it
     std::unique_ptr<SubdivisionManager> m_subdivisionManager;
     std::unique_ptr<LODManager> m_lodManager;
+    std::unique_ptr<BVHManager> m_bvhManager;
+    std::unique_ptr<FeatureEdgeManager> m_featureEdgeManager;
     std::unique_ptr<MultiPatchManager> m_multipatchManager;
+    std::unique_ptr<GeometryCache> m_geometryCache;
+    std::unique_ptr<TextureManager> m_textureManager;
     Camera m_camera;
     Scene m_scene;
+    GeometryLibrary m_geometryLibrary;  // Load-time instancing of duplicate meshes
     Timer m_timer;
 
+    int m_redrawFrames{0};            // Frames still to draw after the last change
+    uint64_t m_renderedRevision{0};   // SceneObject revision the last frame showed
+    double m_lastRenderTime{0.0};
+
     bool m_leftMouseDown{false};
     bool m_middleMouseDown{false};
     bool m_rightMouseDown{false};
     double m_lastMouseX{0.0};
     double m_lastMouseY{0.0};
+    bool m_keyOrbiting{false};
+    double m_lastScrollTime{-1.0};
+    SceneObject* m_hoveredObject{nullptr};
 
     float m_creaseAngle{180.0f};
+    float m_featureEdgeAngle{FeatureEdges::DEFAULT_ANGLE};
     std::string m_defaultTexturePath;
+    SplitMode m_splitMode{SplitMode::None};
 
     CameraAnimation m_cameraAnimation;
 };
@@ -0,0 +1,253 @@
+#include "BakeRunner.h"
+#include "cache/GeometryCache.h"
+#include "geometry/MeshOptimizer.h"
+#include "geometry/Subdivision.h"
+#include "lod/LODGenerator.h"
+#include "mesh/MeshLoader.h"
+#include <nlohmann/json.hpp>
+#include <omp.h>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <utility>
+
+using json = nlohmann::json;
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    double millisecondsSince(Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    json timingsToJson(double load, double subdivide,
+                       double lod, double optimize, double write) {
+        return json{
+            {"load", load},
+            {"subdivide", subdivide},
+            {"lod", lod},
+            {"optimize", optimize},
+            {"write", write},
+            {"total", load + subdivide + lod + optimize + write}
+        };
+    }
+}
+
+BakeRunner::BakeRunner(BakeOptions options)
+    : m_options(std::move(options))
+{
+}
+
+int BakeRunner::run() {
+    if (m_options.inputs.empty()) {
+        std::cerr << "Bake error: no input files" << std::endl;
+        return 1;
+    }
+
+    std::cout << "Baking " << m_options.inputs.size() << " file(s) on "
+              << omp_get_max_threads() << " threads -> " << m_options.outputDirectory << std::endl;
+
+    std::vector<InputResult> results(m_options.inputs.size());
+    const auto start = Clock::now();
+
+    // One input per thread; inner OpenMP loops (subdivision) run serially
+    // inside, which is the better split for many small parts
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (size_t i = 0; i < m_options.inputs.size(); ++i) {
+        results[i] = bakeOne(m_options.inputs[i]);
+
+        #pragma omp critical(bake_log)
+        {
+            const InputResult& r = results[i];
+            if (r.success) {
+                std::cout << "  " << r.path << ": " << r.outputTriangles << " tris, "
+                          << r.lodLevels << " LODs, ACMR " << r.acmrBefore << " -> " << r.acmrAfter
+                          << " (" << static_cast<int>(r.timings.total()) << " ms)" << std::endl;
+            } else {
+                std::cerr << "  " << r.path << ": FAILED (" << r.error << ")" << std::endl;
+            }
+        }
+    }
+
+    const double wallSeconds = millisecondsSince(start) / 1000.0;
+
+    bool allOk = true;
+    for (const auto& r : results) {
+        allOk = allOk && r.success;
+    }
+
+    if (!writeReport(results, wallSeconds)) {
+        return 1;
+    }
+    return allOk ? 0 : 1;
+}
+
+BakeRunner::InputResult BakeRunner::bakeOne(const std::string& path) const {
+    InputResult result;
+    result.path = path;
+
+    std::error_code ec;
+    result.inputBytes = std::filesystem::file_size(path, ec);
+    if (ec) {
+        result.error = "cannot read file";
+        return result;
+    }
+
+    try {
+        // ========== Load ==========
+        auto stageStart = Clock::now();
+        auto loader = MeshLoader::createForFile(path);
+        if (!loader) {
+            result.error = "no loader for this file type";
+            return result;
+        }
+
+        MeshData mesh;
+        if (!loader->load(path, mesh) || mesh.indices.empty()) {
+            result.error = "load failed";
+            return result;
+        }
+        result.inputTriangles = static_cast<uint32_t>(mesh.indices.size() / 3);
+        result.timings.load = millisecondsSince(stageStart);
+
+        // Stages run in the viewer's order (optimize, then the LOD chain from
+        // the optimized mesh, which is also what gets subdivided) and every
+        // level is written under the key the viewer looks up for it, so the
+        // output directory works as a --cache
+        GeometryCache cache(m_options.outputDirectory);
+        uint64_t key = cache.keyForFile(path);
+        if (key == 0) {
+            result.error = "cannot read file";
+            return result;
+        }
+
+        for (int level = 0; ; ++level) {
+            // ========== Vertex cache optimization ==========
+            stageStart = Clock::now();
+            const MeshOptimizer::Result optimized = MeshOptimizer::optimize(mesh);
+            result.acmrBefore = optimized.acmrBefore;
+            result.acmrAfter = optimized.acmrAfter;
+            result.timings.optimize += millisecondsSince(stageStart);
+
+            // ========== LOD chain ==========
+            stageStart = Clock::now();
+            std::vector<LODLevel> lodLevels;
+            if (mesh.indices.size() / 3 >= 100) {  // Same cut-off as the viewer
+                lodLevels = LODGenerator::generate(mesh);
+            }
+            result.lodLevels = static_cast<uint32_t>(lodLevels.size());
+            result.timings.lod += millisecondsSince(stageStart);
+
+            // ========== Write ==========
+            stageStart = Clock::now();
+            if (!cache.store(key, mesh, lodLevels)) {
+                result.error = "write failed";
+                return result;
+            }
+            result.timings.write += millisecondsSince(stageStart);
+
+            if (level == m_options.subdivisionLevels) {
+                break;
+            }
+
+            // ========== Subdivide ==========
+            stageStart = Clock::now();
+            mesh = m_options.smooth
+                ? Subdivision::loopSubdivide(mesh, m_options.creaseAngle)
+                : Subdivision::midpointSubdivide(mesh);
+            key = GeometryCache::deriveKey(key,
+                GeometryCache::subdivisionOperation(m_options.smooth, m_options.creaseAngle));
+            result.timings.subdivide += millisecondsSince(stageStart);
+        }
+
+        result.outputTriangles = static_cast<uint32_t>(mesh.indices.size() / 3);
+        result.outputVertices = static_cast<uint32_t>(mesh.vertices.size());
+        result.success = true;
+    } catch (const std::exception& e) {
+        result.error = e.what();
+    }
+
+    return result;
+}
+
+bool BakeRunner::writeReport(const std::vector<InputResult>& results, double wallSeconds) const {
+    json files = json::array();
+    StageTimings totals;
+    uint64_t totalBytes = 0;
+    uint64_t totalInputTriangles = 0;
+    uint64_t totalOutputTriangles = 0;
+    size_t succeeded = 0;
+
+    for (const auto& r : results) {
+        json entry{
+            {"path", r.path},
+            {"success", r.success},
+            {"inputBytes", r.inputBytes},
+            {"inputTriangles", r.inputTriangles},
+            {"outputTriangles", r.outputTriangles},
+            {"outputVertices", r.outputVertices},
+            {"lodLevels", r.lodLevels},
+            {"acmrBefore", r.acmrBefore},
+            {"acmrAfter", r.acmrAfter},
+            {"timingsMs", timingsToJson(r.timings.load, r.timings.subdivide,
+                                        r.timings.lod, r.timings.optimize, r.timings.write)}
+        };
+        if (!r.success) {
+            entry["error"] = r.error;
+        }
+        files.push_back(std::move(entry));
+
+        totals.load += r.timings.load;
+        totals.subdivide += r.timings.subdivide;
+        totals.lod += r.timings.lod;
+        totals.optimize += r.timings.optimize;
+        totals.write += r.timings.write;
+
+        if (r.success) {
+            ++succeeded;
+            totalBytes += r.inputBytes;
+            totalInputTriangles += r.inputTriangles;
+            totalOutputTriangles += r.outputTriangles;
+        }
+    }
+
+    const double safeWall = wallSeconds > 0.0 ? wallSeconds : 1e-9;
+
+    json report{
+        {"threads", omp_get_max_threads()},
+        {"inputs", results.size()},
+        {"succeeded", succeeded},
+        {"failed", results.size() - succeeded},
+        {"subdivisionLevels", m_options.subdivisionLevels},
+        {"outputDirectory", m_options.outputDirectory},
+        {"wallSeconds", wallSeconds},
+        {"throughput", {
+            {"filesPerSecond", succeeded / safeWall},
+            {"inputMegabytesPerSecond", totalBytes / (1024.0 * 1024.0) / safeWall},
+            {"inputTrianglesPerSecond", totalInputTriangles / safeWall},
+            {"outputTrianglesPerSecond", totalOutputTriangles / safeWall}
+        }},
+        // Summed over threads (CPU time per stage, not wall time)
+        {"stageTotalsMs", timingsToJson(totals.load, totals.subdivide,
+                                        totals.lod, totals.optimize, totals.write)},
+        {"files", std::move(files)}
+    };
+
+    std::string reportPath = m_options.reportPath;
+    if (reportPath.empty()) {
+        std::error_code ec;
+        std::filesystem::create_directories(m_options.outputDirectory, ec);
+        reportPath = (std::filesystem::path(m_options.outputDirectory) / "bake_report.json").string();
+    }
+
+    std::ofstream out(reportPath);
+    if (!out.is_open()) {
+        std::cerr << "Bake error: cannot write report " << reportPath << std::endl;
+        return false;
+    }
+    out << report.dump(2) << std::endl;
+    std::cout << "Baked " << succeeded << "/" << results.size() << " file(s) in "
+              << wallSeconds << " s, report written to " << reportPath << std::endl;
+    return true;
+}
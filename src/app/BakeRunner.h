@@ -0,0 +1,57 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+// Options for the headless bake mode (--bake)
+struct BakeOptions {
+    std::vector<std::string> inputs;
+    std::string outputDirectory{"baked"};  // Receives geometry cache entries
+    std::string reportPath;                // JSON report ("" = <outputDirectory>/bake_report.json)
+    int subdivisionLevels{0};
+    bool smooth{true};                     // Loop (true) or midpoint subdivision
+    float creaseAngle{180.0f};
+};
+
+// Windowless batch preprocessing: load -> vertex-cache optimization -> LOD
+// chain -> write, then subdivide -> optimize -> LOD chain -> write for each
+// subdivision level. Inputs are processed in parallel and every level is
+// written under the viewer's cache key, so the directory can be passed to the
+// viewer with --cache. Needs no GL context.
+class BakeRunner {
+public:
+    explicit BakeRunner(BakeOptions options);
+
+    // Returns the process exit code (non-zero if any input failed)
+    int run();
+
+private:
+    struct StageTimings {
+        double load{0.0};
+        double subdivide{0.0};
+        double lod{0.0};
+        double optimize{0.0};
+        double write{0.0};
+
+        double total() const { return load + subdivide + lod + optimize + write; }
+    };
+
+    struct InputResult {
+        std::string path;
+        bool success{false};
+        std::string error;
+        uint64_t inputBytes{0};
+        uint32_t inputTriangles{0};
+        uint32_t outputTriangles{0};
+        uint32_t outputVertices{0};
+        uint32_t lodLevels{0};
+        float acmrBefore{0.0f};
+        float acmrAfter{0.0f};
+        StageTimings timings;
+    };
+
+    InputResult bakeOne(const std::string& path) const;
+    bool writeReport(const std::vector<InputResult>& results, double wallSeconds) const;
+
+    BakeOptions m_options;
+};
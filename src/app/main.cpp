@@ -1,8 +1,13 @@
 #include "Application.h"
+#include "BakeRunner.h"
+#include "core/Shader.h"
+#include "geometry/MeshOptimizer.h"
+#include "mesh/VertexFormat.h"
 #include <iostream>
 #include <vector>
 #include <cstring>
 #include <cstdlib>
+#include <algorithm>
 
 void printUsage(const char* progName) {
     std::cout << "Usage: " << progName << " [options] [mesh files...]\n"
@@ -10,21 +15,46 @@ void printUsage(const char* progName) {
               << "  --angle <degrees>  Crease angle threshold for subdivision (default: 180)\n"
               << "                     Edges with dihedral angle > threshold are kept sharp\n"
               << "                     Use lower values (e.g., 30) to preserve sharp edges\n"
+              << "  --edge-angle <degrees>  Crease angle for the feature edge overlay (default: 30)\n"
               << "  --texture <path>   Default texture for all objects (default: assets/textures/default_grid.png)\n"
               << "                     Built-in options: default_grid, checker, uv_test, brushed_metal, wood, concrete\n"
               << "  --animation <file> Load camera animation from JSON file\n"
+              << "  --cache <dir>      Cache processed geometry (mesh + LODs) in <dir>\n"
+              << "                     and compiled shaders in <dir>/shaders (default: shader_cache)\n"
+              << "  --split <mode>     Load parts as separate objects: shapes (OBJ groups), components\n"
+              << "                     or chunks (at most 65536 vertices, 16-bit indices)\n"
+              << "  --texture-budget <MB>  GPU memory for mesh textures before unused ones are released (default: 256)\n"
+              << "  --frame-target <ms>    Scene GPU time held by dynamic resolution (default: 16)\n"
+              << "  --min-scale <s>        Lowest dynamic resolution scale, 0.1-1 (default: 0.5)\n"
+              << "  --max-scale <s>        Highest dynamic resolution scale, 0.1-1 (default: 1)\n"
+              << "  --no-dynamic-res       Always render at native resolution\n"
+              << "  --full-vertices        Upload full-precision float vertices instead of the compact layout\n"
+              << "  --optimize <mode>      Mesh reordering for the GPU: off, cache (vertex cache, default)\n"
+              << "                         or overdraw (vertex cache plus overdraw clustering)\n"
               << "  --help             Show this help message\n"
+              << "\nBatch mode (no window):\n"
+              << "  --bake             Preprocess the mesh files and exit\n"
+              << "  --out <dir>        Output directory (default: baked), usable with --cache\n"
+              << "  --subdivide <n>    Subdivision levels before LOD generation (default: 0)\n"
+              << "  --midpoint         Use midpoint instead of Loop subdivision\n"
+              << "  --report <file>    JSON timing report (default: <out>/bake_report.json)\n"
               << "\nControls:\n"
               << "  Left Mouse Drag    Orbit camera\n"
               << "  Middle Mouse Drag  Pan camera\n"
               << "  Right Click        Select object\n"
+              << "  Mouse Hover        Highlight object under cursor\n"
               << "  Scroll Wheel       Zoom in/out\n"
               << "  A                  Toggle animation playback\n"
               << "  S                  Subdivide (Loop - smooth)\n"
               << "  D                  Subdivide (midpoint)\n"
-              << "  W                  Toggle wireframe\n"
+              << "  W                  Cycle wireframe (off, feature edges, full)\n"
               << "  T                  Toggle textures\n"
+              << "  B                  Cycle draw path (GPU-driven, per-object, batched)\n"
               << "  C                  Toggle back-face culling\n"
+              << "  O                  Toggle occlusion culling\n"
+              << "  M                  Toggle cluster culling (GPU-driven path)\n"
+              << "  R                  Toggle dynamic resolution\n"
+              << "  I                  Toggle interactive LOD (coarser while the camera moves)\n"
               << "  F                  Focus on scene\n"
               << "  H                  Toggle help overlay\n"
               << "  P                  Solve Poisson / Toggle solution view\n"
@@ -36,6 +66,13 @@ int main(int argc, char* argv[]) {
     float creaseAngle = 180.0f;
     std::string texturePath = "assets/textures/default_grid.png";
     std::string animationPath;
+    std::string cacheDirectory;
+    SplitMode splitMode = SplitMode::None;
+    size_t textureBudgetMB = 256;
+    float edgeAngle = FeatureEdges::DEFAULT_ANGLE;
+    DynamicResolution::Settings dynamicResolution;
+    bool bake = false;
+    BakeOptions bakeOptions;
 
     for (int i = 1; i < argc; ++i) {
         if (std::strcmp(argv[i], "--angle") == 0) {
@@ -69,6 +106,111 @@ int main(int argc, char* argv[]) {
                 std::cerr << "Error: --animation requires a file path\n";
                 return 1;
             }
+        } else if (std::strcmp(argv[i], "--cache") == 0) {
+            if (i + 1 < argc) {
+                cacheDirectory = argv[++i];
+            } else {
+                std::cerr << "Error: --cache requires a directory\n";
+                return 1;
+            }
+        } else if (std::strcmp(argv[i], "--split") == 0) {
+            if (i + 1 < argc) {
+                const char* mode = argv[++i];
+                if (std::strcmp(mode, "shapes") == 0) {
+                    splitMode = SplitMode::Shapes;
+                } else if (std::strcmp(mode, "components") == 0) {
+                    splitMode = SplitMode::Components;
+                } else if (std::strcmp(mode, "chunks") == 0) {
+                    splitMode = SplitMode::Chunks;
+                } else {
+                    std::cerr << "Error: --split expects 'shapes', 'components' or 'chunks'\n";
+                    return 1;
+                }
+            } else {
+                std::cerr << "Error: --split requires a mode\n";
+                return 1;
+            }
+        } else if (std::strcmp(argv[i], "--edge-angle") == 0) {
+            if (i + 1 < argc) {
+                edgeAngle = static_cast<float>(std::atof(argv[++i]));
+            } else {
+                std::cerr << "Error: --edge-angle requires a value\n";
+                return 1;
+            }
+        } else if (std::strcmp(argv[i], "--texture-budget") == 0) {
+            if (i + 1 < argc) {
+                textureBudgetMB = static_cast<size_t>(std::max(1, std::atoi(argv[++i])));
+            } else {
+                std::cerr << "Error: --texture-budget requires a value in MB\n";
+                return 1;
+            }
+        } else if (std::strcmp(argv[i], "--frame-target") == 0) {
+            if (i + 1 < argc) {
+                dynamicResolution.targetMs = static_cast<float>(std::atof(argv[++i]));
+            } else {
+                std::cerr << "Error: --frame-target requires a value in ms\n";
+                return 1;
+            }
+        } else if (std::strcmp(argv[i], "--min-scale") == 0) {
+            if (i + 1 < argc) {
+                dynamicResolution.minScale = static_cast<float>(std::atof(argv[++i]));
+            } else {
+                std::cerr << "Error: --min-scale requires a value\n";
+                return 1;
+            }
+        } else if (std::strcmp(argv[i], "--max-scale") == 0) {
+            if (i + 1 < argc) {
+                dynamicResolution.maxScale = static_cast<float>(std::atof(argv[++i]));
+            } else {
+                std::cerr << "Error: --max-scale requires a value\n";
+                return 1;
+            }
+        } else if (std::strcmp(argv[i], "--no-dynamic-res") == 0) {
+            dynamicResolution.enabled = false;
+        } else if (std::strcmp(argv[i], "--full-vertices") == 0) {
+            VertexFormat::setLayout(VertexFormat::Layout::Full);
+        } else if (std::strcmp(argv[i], "--optimize") == 0) {
+            if (i + 1 < argc) {
+                const char* mode = argv[++i];
+                if (std::strcmp(mode, "off") == 0) {
+                    MeshOptimizer::setMode(MeshOptimizer::Mode::Off);
+                } else if (std::strcmp(mode, "cache") == 0) {
+                    MeshOptimizer::setMode(MeshOptimizer::Mode::VertexCache);
+                } else if (std::strcmp(mode, "overdraw") == 0) {
+                    MeshOptimizer::setMode(MeshOptimizer::Mode::Overdraw);
+                } else {
+                    std::cerr << "Error: --optimize expects 'off', 'cache' or 'overdraw'\n";
+                    return 1;
+                }
+            } else {
+                std::cerr << "Error: --optimize requires a mode\n";
+                return 1;
+            }
+        } else if (std::strcmp(argv[i], "--bake") == 0) {
+            bake = true;
+        } else if (std::strcmp(argv[i], "--out") == 0) {
+            if (i + 1 < argc) {
+                bakeOptions.outputDirectory = argv[++i];
+            } else {
+                std::cerr << "Error: --out requires a directory\n";
+                return 1;
+            }
+        } else if (std::strcmp(argv[i], "--subdivide") == 0) {
+            if (i + 1 < argc) {
+                bakeOptions.subdivisionLevels = std::max(0, std::atoi(argv[++i]));
+            } else {
+                std::cerr << "Error: --subdivide requires a value\n";
+                return 1;
+            }
+        } else if (std::strcmp(argv[i], "--midpoint") == 0) {
+            bakeOptions.smooth = false;
+        } else if (std::strcmp(argv[i], "--report") == 0) {
+            if (i + 1 < argc) {
+                bakeOptions.reportPath = argv[++i];
+            } else {
+                std::cerr << "Error: --report requires a file path\n";
+                return 1;
+            }
         } else if (std::strcmp(argv[i], "--help") == 0 || std::strcmp(argv[i], "-h") == 0) {
             printUsage(argv[0]);
             return 0;
@@ -77,8 +219,24 @@ int main(int argc, char* argv[]) {
         }
     }
 
+    if (bake) {
+        bakeOptions.inputs = meshPaths;
+        bakeOptions.creaseAngle = creaseAngle;
+        return BakeRunner(std::move(bakeOptions)).run();
+    }
+
+    // Compiled shader programs are cached next to the geometry cache if there is one
+    if (!cacheDirectory.empty()) {
+        Shader::setBinaryCacheDirectory(cacheDirectory + "/shaders");
+    }
+
     try {
-        Application app(1280, 720, "OpenGL Mesh Viewer", creaseAngle, texturePath);
+        Application app(1280, 720, "OpenGL Mesh Viewer", creaseAngle, texturePath, cacheDirectory);
+
+        app.setSplitMode(splitMode);
+        app.setTextureBudget(textureBudgetMB * 1024 * 1024);
+        app.setFeatureEdgeAngle(edgeAngle);
+        app.setDynamicResolution(dynamicResolution);
 
         if (!animationPath.empty()) {
             app.loadAnimation(animationPath);
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "Progress.h"
+#include "mesh/MeshData.h"
+#include "geometry/TriangleBVH.h"
+#include <memory>
+#include <string>
+
+class SceneObject;
+
+// Phase names for progress display
+inline const char* BVH_PHASE_NAMES[] = {
+    "Starting...",
+    "Building triangle BVH"
+};
+
+constexpr int BVH_PHASE_COUNT = 1;
+
+// Triangle BVH build for CPU ray casts (picking, hover)
+struct BVHTask {
+    // Input mesh data (copied for thread safety)
+    MeshData inputData;
+
+    // Result (populated by worker thread)
+    std::shared_ptr<TriangleBVH> result;
+
+    // Progress tracking
+    Progress progress;
+
+    // Target scene object to apply result to
+    SceneObject* targetObject{nullptr};
+
+    // Object name for display
+    std::string objectName;
+
+    // Mesh data version the BVH is built from (stale results are dropped)
+    uint64_t meshVersion{0};
+
+    BVHTask() {
+        progress.totalPhases = BVH_PHASE_COUNT;
+        progress.phaseNames = BVH_PHASE_NAMES;
+    }
+
+    BVHTask(SceneObject* target, const std::string& name, const MeshData& data, uint64_t version)
+        : inputData(data)
+        , targetObject(target)
+        , objectName(name)
+        , meshVersion(version)
+    {
+        progress.totalPhases = BVH_PHASE_COUNT;
+        progress.phaseNames = BVH_PHASE_NAMES;
+        progress.reset();
+    }
+
+    // Required by TaskManager template
+    Progress& getProgress() { return progress; }
+    const Progress& getProgress() const { return progress; }
+};
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "Progress.h"
+#include "mesh/MeshData.h"
+#include "geometry/FeatureEdges.h"
+#include <memory>
+#include <string>
+
+class SceneObject;
+
+// Phase names for progress display
+inline const char* FEATURE_EDGE_PHASE_NAMES[] = {
+    "Starting...",
+    "Extracting feature edges"
+};
+
+constexpr int FEATURE_EDGE_PHASE_COUNT = 1;
+
+// Boundary and crease edge extraction for the edge overlay
+struct FeatureEdgeTask {
+    // Input mesh data (copied for thread safety)
+    MeshData inputData;
+
+    // Dihedral angle threshold in degrees
+    float angleThreshold{FeatureEdges::DEFAULT_ANGLE};
+
+    // Result (populated by worker thread, uploaded on the main thread)
+    std::shared_ptr<FeatureEdges> result;
+
+    // Progress tracking
+    Progress progress;
+
+    // Target scene object to apply result to
+    SceneObject* targetObject{nullptr};
+
+    // Object name for display
+    std::string objectName;
+
+    // Mesh data version the edges are built from (stale results are dropped)
+    uint64_t meshVersion{0};
+
+    FeatureEdgeTask() {
+        progress.totalPhases = FEATURE_EDGE_PHASE_COUNT;
+        progress.phaseNames = FEATURE_EDGE_PHASE_NAMES;
+    }
+
+    FeatureEdgeTask(SceneObject* target, const std::string& name, const MeshData& data,
+                    uint64_t version, float angle)
+        : inputData(data)
+        , angleThreshold(angle)
+        , targetObject(target)
+        , objectName(name)
+        , meshVersion(version)
+    {
+        progress.totalPhases = FEATURE_EDGE_PHASE_COUNT;
+        progress.phaseNames = FEATURE_EDGE_PHASE_NAMES;
+        progress.reset();
+    }
+
+    // Required by TaskManager template
+    Progress& getProgress() { return progress; }
+    const Progress& getProgress() const { return progress; }
+};
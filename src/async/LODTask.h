@@ -8,6 +8,7 @@
 #include <string>
 
 class SceneObject;
+class GeometryCache;
 
 // Phase names for progress display
 inline const char* LOD_PHASE_NAMES[] = {
@@ -45,6 +46,10 @@ struct LODTask {
     // Simplification progress for current phase
     SimplificationProgress simplificationProgress;
 
+    // Optional on-disk cache (LOD chain is read from / written to cacheKey)
+    GeometryCache* cache{nullptr};
+    uint64_t cacheKey{0};
+
     LODTask() {
         progress.totalPhases = LOD_PHASE_COUNT;
         progress.phaseNames = LOD_PHASE_NAMES;
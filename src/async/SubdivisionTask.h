@@ -2,9 +2,12 @@
 
 #include "Progress.h"
 #include "mesh/MeshData.h"
+#include <memory>
 #include <string>
 
 class SceneObject;
+class GeometryCache;
+class StagedMesh;
 
 // Phase names for progress display
 inline const char* SUBDIVISION_PHASE_NAMES[] = {
@@ -32,6 +35,9 @@ struct SubdivisionTask {
     // Result mesh data (populated by worker thread)
     MeshData resultData;
 
+    // Result copied into the staging ring by the worker (null: upload directly)
+    std::shared_ptr<StagedMesh> staged;
+
     // Progress tracking
     Progress progress;
 
@@ -45,6 +51,15 @@ struct SubdivisionTask {
     bool smooth{true};          // true = Loop, false = midpoint
     float creaseAngle{180.0f};   // Only used for Loop subdivision
 
+    // Optional on-disk cache: result is keyed by the input key plus parameters
+    GeometryCache* cache{nullptr};
+    uint64_t cacheKey{0};        // Key of the input mesh (0 = not cached)
+    uint64_t resultKey{0};       // Key of the subdivided mesh (set by worker)
+
+    // Vertex cache ACMR of the result before and after MeshOptimizer (set by worker; 0 = not optimized)
+    float acmrBefore{0.0f};
+    float acmrAfter{0.0f};
+
     SubdivisionTask() {
         progress.totalPhases = SUBDIVISION_PHASE_COUNT;
         progress.phaseNames = SUBDIVISION_PHASE_NAMES;
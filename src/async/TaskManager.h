@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Progress.h"
+#include <algorithm>
 #include <thread>
 #include <mutex>
 #include <condition_variable>
@@ -8,6 +9,9 @@
 #include <memory>
 #include <vector>
 #include <atomic>
+#include <functional>
+#include <iterator>
+#include <limits>
 #include <string>
 
 // Snapshot of progress values, safe to read after the lock is released
@@ -36,6 +40,8 @@ struct ProgressSnapshot {
 };
 
 // Template base class for background task managers
+// Tasks run in submission order on one worker thread by default; managers of
+// independent tasks may start several workers
 // TaskType must have:
 //   - Progress& getProgress()
 //   - std::string objectName
@@ -43,8 +49,10 @@ struct ProgressSnapshot {
 template<typename TaskType>
 class TaskManager {
 public:
-    TaskManager() {
-        m_workerThread = std::thread(&TaskManager::workerLoop, this);
+    explicit TaskManager(unsigned workerCount = 1) {
+        for (unsigned i = 0; i < std::max(workerCount, 1u); ++i) {
+            m_workerThreads.emplace_back(&TaskManager::workerLoop, this);
+        }
     }
 
     virtual ~TaskManager() {
@@ -65,14 +73,22 @@ public:
     }
 
     // Call each frame from main thread to process completed tasks
+    // At most maxTasks are taken; the rest wait for later frames
     // Returns the number of tasks that were completed and applied
-    int processCompletedTasks() {
+    int processCompletedTasks(size_t maxTasks = std::numeric_limits<size_t>::max()) {
         std::vector<std::unique_ptr<TaskType>> tasksToProcess;
 
-        // Grab completed tasks
+        // Grab completed tasks, oldest first
         {
             std::lock_guard<std::mutex> lock(m_completedMutex);
-            tasksToProcess.swap(m_completedTasks);
+            if (m_completedTasks.size() <= maxTasks) {
+                tasksToProcess.swap(m_completedTasks);
+            } else {
+                auto last = m_completedTasks.begin() + static_cast<std::ptrdiff_t>(maxTasks);
+                tasksToProcess.assign(std::make_move_iterator(m_completedTasks.begin()),
+                                      std::make_move_iterator(last));
+                m_completedTasks.erase(m_completedTasks.begin(), last);
+            }
         }
 
         int count = 0;
@@ -96,10 +112,10 @@ public:
 
     // Cancel all pending and active tasks
     void cancelAll() {
-        // Cancel active task
+        // Cancel active tasks
         {
             std::lock_guard<std::mutex> lock(m_activeMutex);
-            if (m_activeTask) {
+            if (!m_activeTasks.empty()) {
                 cancelActiveTask();
             }
         }
@@ -116,22 +132,39 @@ public:
     // Check if there's an active task
     bool isBusy() const {
         std::lock_guard<std::mutex> lock(m_activeMutex);
-        return m_activeTask != nullptr;
+        return !m_activeTasks.empty();
+    }
+
+    // Check for tasks that are queued, running, or finished but not yet applied
+    bool hasPendingWork() const {
+        {
+            std::lock_guard<std::mutex> lock(m_queueMutex);
+            if (!m_pendingTasks.empty()) return true;
+        }
+        if (isBusy()) return true;
+        std::lock_guard<std::mutex> lock(m_completedMutex);
+        return !m_completedTasks.empty();
+    }
+
+    // Called on the worker thread after each task finishes, e.g. to wake a
+    // main loop that waits for events. Set before submitting tasks.
+    void setCompletionCallback(std::function<void()> callback) {
+        m_completionCallback = std::move(callback);
     }
 
-    // Get a snapshot of the active task's progress (safe to use after call returns)
+    // Get a snapshot of the (oldest) active task's progress (safe to use after call returns)
     // Returns false if no active task
     bool getActiveProgressSnapshot(ProgressSnapshot& snapshot) const {
         std::lock_guard<std::mutex> lock(m_activeMutex);
-        if (!m_activeTask) return false;
-        snapshot = ProgressSnapshot::fromProgress(m_activeTask->getProgress());
+        if (m_activeTasks.empty()) return false;
+        snapshot = ProgressSnapshot::fromProgress(m_activeTasks.front()->getProgress());
         return true;
     }
 
     // Get active task's object name (for UI display)
     std::string getActiveObjectName() const {
         std::lock_guard<std::mutex> lock(m_activeMutex);
-        return m_activeTask ? m_activeTask->objectName : "";
+        return m_activeTasks.empty() ? "" : m_activeTasks.front()->objectName;
     }
 
     // Get number of queued tasks (not including active)
@@ -148,18 +181,20 @@ protected:
 
         m_shutdown.store(true, std::memory_order_release);
 
-        // Cancel active task (non-virtual: just set the cancel flag)
+        // Cancel active tasks (non-virtual: just set the cancel flags)
         {
             std::lock_guard<std::mutex> lock(m_activeMutex);
-            if (m_activeTask) {
-                m_activeTask->getProgress().cancel();
+            for (TaskType* task : m_activeTasks) {
+                task->getProgress().cancel();
             }
         }
 
         m_queueCondition.notify_all();
 
-        if (m_workerThread.joinable()) {
-            m_workerThread.join();
+        for (auto& worker : m_workerThreads) {
+            if (worker.joinable()) {
+                worker.join();
+            }
         }
     }
 
@@ -170,17 +205,18 @@ protected:
     // Returns true if successfully applied
     virtual bool applyTaskResult(TaskType& task) = 0;
 
-    // Cancel the active task (can be overridden for additional cleanup)
+    // Cancel the active tasks (can be overridden for additional cleanup)
     // Called with m_activeMutex held — safe to access getActiveTask()
     virtual void cancelActiveTask() {
-        if (m_activeTask) {
-            m_activeTask->getProgress().cancel();
+        for (TaskType* task : m_activeTasks) {
+            task->getProgress().cancel();
         }
     }
 
-    // Access the active task (only valid while m_activeMutex is held,
-    // i.e. from within cancelActiveTask() overrides)
-    TaskType* getActiveTask() const { return m_activeTask; }
+    // Access the (oldest) active task; the only one with a single worker
+    // (only valid while m_activeMutex is held, i.e. from within
+    // cancelActiveTask() overrides)
+    TaskType* getActiveTask() const { return m_activeTasks.empty() ? nullptr : m_activeTasks.front(); }
 
 private:
     void workerLoop() {
@@ -213,7 +249,7 @@ private:
                 // Set as active task
                 {
                     std::lock_guard<std::mutex> lock(m_activeMutex);
-                    m_activeTask = task.get();
+                    m_activeTasks.push_back(task.get());
                 }
 
                 // Process the task
@@ -222,7 +258,7 @@ private:
                 // Clear active task
                 {
                     std::lock_guard<std::mutex> lock(m_activeMutex);
-                    m_activeTask = nullptr;
+                    m_activeTasks.erase(std::find(m_activeTasks.begin(), m_activeTasks.end(), task.get()));
                 }
 
                 // Move to completed queue
@@ -230,12 +266,15 @@ private:
                     std::lock_guard<std::mutex> lock(m_completedMutex);
                     m_completedTasks.push_back(std::move(task));
                 }
+                if (m_completionCallback) {
+                    m_completionCallback();
+                }
             }
         }
     }
 
-    // Worker thread
-    std::thread m_workerThread;
+    // Worker threads
+    std::vector<std::thread> m_workerThreads;
 
     // Task queue
     std::queue<std::unique_ptr<TaskType>> m_pendingTasks;
@@ -246,10 +285,12 @@ private:
     std::vector<std::unique_ptr<TaskType>> m_completedTasks;
     mutable std::mutex m_completedMutex;
 
-    // Currently active task (owned by worker thread)
-    TaskType* m_activeTask{nullptr};
+    // Currently active tasks, oldest first (owned by the worker threads)
+    std::vector<TaskType*> m_activeTasks;
     mutable std::mutex m_activeMutex;
 
+    std::function<void()> m_completionCallback;
+
     // Shutdown flag
     std::atomic<bool> m_shutdown{false};
 };
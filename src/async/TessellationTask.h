@@ -4,8 +4,10 @@
 #include "mesh/MeshData.h"
 #include <string>
 #include <functional>
+#include <memory>
 
 class PatchObject;
+class StagedMesh;
 
 // Callback type for tessellation function
 using TessellationFunction = std::function<MeshData(int, int)>;
@@ -26,6 +28,9 @@ struct TessellationTask {
     // Result mesh data (populated by worker thread)
     MeshData resultData;
 
+    // Result copied into the staging ring by the worker (null: upload directly)
+    std::shared_ptr<StagedMesh> staged;
+
     // Progress tracking
     Progress progress;
 
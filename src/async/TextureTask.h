@@ -0,0 +1,59 @@
+#pragma once
+
+#include "Progress.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+struct TextureEntry;
+
+// Phase names for progress display
+inline const char* TEXTURE_PHASE_NAMES[] = {
+    "Starting...",
+    "Decoding image",
+    "Building mipmaps"
+};
+
+constexpr int TEXTURE_PHASE_COUNT = 2;
+
+// One decoded mip level, tightly packed rows
+struct TextureMip {
+    int width{0};
+    int height{0};
+    std::vector<uint8_t> pixels;
+};
+
+// Texture decoding task: image file -> CPU mip chain (level 0 first)
+struct TextureTask {
+    // Input file
+    std::string path;
+
+    // Result
+    int channels{0};
+    std::vector<TextureMip> mips;
+    bool failed{false};
+
+    // Progress tracking
+    Progress progress;
+
+    // Shared cache entry to apply the result to
+    std::shared_ptr<TextureEntry> targetEntry;
+
+    // Texture path for display
+    std::string objectName;
+
+    TextureTask(std::shared_ptr<TextureEntry> target, const std::string& texturePath)
+        : path(texturePath)
+        , targetEntry(std::move(target))
+        , objectName(texturePath)
+    {
+        progress.totalPhases = TEXTURE_PHASE_COUNT;
+        progress.phaseNames = TEXTURE_PHASE_NAMES;
+        progress.reset();
+    }
+
+    // Required by TaskManager template
+    Progress& getProgress() { return progress; }
+    const Progress& getProgress() const { return progress; }
+};
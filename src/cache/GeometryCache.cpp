@@ -0,0 +1,413 @@
+#include "GeometryCache.h"
+#include "geometry/MeshOptimizer.h"
+#include "lod/LODSelector.h"
+#include "util/Hash.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <thread>
+
+namespace {
+    constexpr char CACHE_MAGIC[8] = {'M', 'V', 'G', 'E', 'O', 'M', 0, 0};
+    constexpr uint32_t CACHE_VERSION = 2;
+    constexpr uint32_t MAX_LEVELS = 16;
+    constexpr uint64_t ARRAY_ALIGNMENT = 64;  // Arrays start on cache-line boundaries
+
+    // On-disk layout: FileHeader, LevelRecord[levelCount], texture path bytes,
+    // then per level aligned Vertex, uint32 index and Meshlet arrays
+    struct FileHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t vertexSize;
+        uint64_t key;
+        uint32_t levelCount;
+        uint32_t textureBytes;
+    };
+
+    struct LevelRecord {
+        uint64_t vertexOffset;
+        uint64_t indexOffset;
+        uint32_t vertexCount;
+        uint32_t indexCount;
+        float threshold;
+        float minBounds[3];
+        float maxBounds[3];
+        uint32_t meshletCount;
+        uint64_t meshletOffset;
+    };
+
+    static_assert(sizeof(FileHeader) == 32, "FileHeader layout changed");
+    static_assert(sizeof(LevelRecord) == 64, "LevelRecord layout changed");
+    static_assert(sizeof(Meshlet) == 56, "Meshlet layout changed");
+
+    uint64_t alignUp(uint64_t value) {
+        return (value + ARRAY_ALIGNMENT - 1) & ~(ARRAY_ALIGNMENT - 1);
+    }
+
+    // Parameters that change the processed output invalidate all entries
+    uint64_t processingParamsHash() {
+        const float params[] = {
+            LODSelector::LOD1_RATIO, LODSelector::LOD2_RATIO, LODSelector::LOD3_RATIO,
+            LODSelector::LOD4_RATIO, LODSelector::LOD5_RATIO,
+            LODSelector::LOD0_THRESHOLD, LODSelector::LOD1_THRESHOLD, LODSelector::LOD2_THRESHOLD,
+            LODSelector::LOD3_THRESHOLD, LODSelector::LOD4_THRESHOLD, LODSelector::LOD5_THRESHOLD
+        };
+        uint64_t h = Hash::bytes(params, sizeof(params));
+        h = Hash::combine(h, CACHE_VERSION);
+        h = Hash::combine(h, static_cast<uint64_t>(MeshOptimizer::getMode()));
+        return Hash::combine(h, sizeof(Vertex));
+    }
+
+    // Entries store the resolved texture path, which ObjLoader derives from the
+    // OBJ's directory and its MTL files; both go into the key so a copy in
+    // another directory or an edited MTL does not hit a stale entry
+    uint64_t materialHash(const std::string& path, const uint8_t* data, size_t size) {
+        const std::filesystem::path sourcePath(path);
+        std::string extension = sourcePath.extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+        if (extension != ".obj") {
+            return 0;
+        }
+
+        std::string objDir = sourcePath.parent_path().string();
+        if (objDir.empty()) {
+            objDir = ".";  // Same rule as ObjLoader
+        }
+        uint64_t h = Hash::string(objDir);
+
+        const char* text = reinterpret_cast<const char*>(data);
+        size_t pos = 0;
+        while (pos < size) {
+            const void* newline = std::memchr(text + pos, '\n', size - pos);
+            const size_t lineEnd = newline ? static_cast<const char*>(newline) - text : size;
+
+            size_t p = pos;
+            while (p < lineEnd && (text[p] == ' ' || text[p] == '\t')) ++p;
+            if (lineEnd - p > 6 && std::memcmp(text + p, "mtllib", 6) == 0 &&
+                std::isspace(static_cast<unsigned char>(text[p + 6]))) {
+                std::istringstream names(std::string(text + p + 6, lineEnd - p - 6));
+                std::string name;
+                while (names >> name) {
+                    h = Hash::combine(h, Hash::string(name));
+                    MappedFile mtl;
+                    if (mtl.open((std::filesystem::path(objDir) / name).string())) {
+                        h = Hash::combine(h, Hash::bytes(mtl.data(), mtl.size()));
+                    }
+                }
+            }
+            pos = lineEnd + 1;
+        }
+        return h;
+    }
+
+    // Array of count elements at offset lies inside the mapping
+    bool arrayFits(uint64_t offset, uint64_t count, uint64_t elementSize, uint64_t size) {
+        return offset % ARRAY_ALIGNMENT == 0 && offset <= size && count <= (size - offset) / elementSize;
+    }
+
+    struct LevelSource {
+        const MeshData* data;
+        float threshold;
+    };
+}
+
+// ========== CacheEntry ==========
+
+const Vertex* CacheEntry::getVertices(size_t level) const {
+    return reinterpret_cast<const Vertex*>(m_file.data() + m_levels[level].vertexOffset);
+}
+
+const uint32_t* CacheEntry::getIndices(size_t level) const {
+    return reinterpret_cast<const uint32_t*>(m_file.data() + m_levels[level].indexOffset);
+}
+
+const Meshlet* CacheEntry::getMeshlets(size_t level) const {
+    return reinterpret_cast<const Meshlet*>(m_file.data() + m_levels[level].meshletOffset);
+}
+
+MeshData CacheEntry::toMeshData(size_t level) const {
+    const Level& lvl = m_levels[level];
+
+    MeshData data;
+    data.vertices.assign(getVertices(level), getVertices(level) + lvl.vertexCount);
+    data.indices.assign(getIndices(level), getIndices(level) + lvl.indexCount);
+    data.meshlets.assign(getMeshlets(level), getMeshlets(level) + lvl.meshletCount);
+    data.texturePath = m_texturePath;
+    data.minBounds = lvl.minBounds;
+    data.maxBounds = lvl.maxBounds;
+    return data;
+}
+
+std::shared_ptr<Mesh> CacheEntry::uploadLevel(size_t level) const {
+    const Level& lvl = m_levels[level];
+
+    auto mesh = std::make_shared<Mesh>();
+    mesh->upload(getVertices(level), lvl.vertexCount,
+                 getIndices(level), lvl.indexCount,
+                 lvl.minBounds, lvl.maxBounds,
+                 getMeshlets(level), lvl.meshletCount);
+    return mesh;
+}
+
+std::vector<LODLevel> CacheEntry::uploadLODLevels() const {
+    std::vector<LODLevel> levels;
+    if (!hasLODChain()) {
+        return levels;
+    }
+
+    levels.reserve(m_levels.size());
+    for (size_t i = 0; i < m_levels.size(); ++i) {
+        levels.emplace_back(uploadLevel(i), m_levels[i].threshold, m_levels[i].indexCount / 3);
+    }
+    return levels;
+}
+
+std::vector<LODLevel> CacheEntry::toLODLevels() const {
+    std::vector<LODLevel> levels;
+    if (!hasLODChain()) {
+        return levels;
+    }
+
+    levels.reserve(m_levels.size());
+    for (size_t i = 0; i < m_levels.size(); ++i) {
+        levels.emplace_back(toMeshData(i), m_levels[i].threshold);
+    }
+    return levels;
+}
+
+// ========== GeometryCache ==========
+
+GeometryCache::GeometryCache(const std::string& directory)
+    : m_directory(directory)
+{
+    if (m_directory.empty()) {
+        return;
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(m_directory, ec);
+    if (ec) {
+        std::cerr << "GeometryCache error: cannot create " << m_directory
+                  << " (" << ec.message() << "), caching disabled" << std::endl;
+        m_directory.clear();
+    }
+}
+
+uint64_t GeometryCache::keyForFile(const std::string& path) const {
+    MappedFile file;
+    if (!file.open(path)) {
+        return 0;
+    }
+
+    uint64_t key = Hash::bytes(file.data(), file.size());
+    key = Hash::combine(key, materialHash(path, file.data(), file.size()));
+    key = Hash::combine(key, processingParamsHash());
+    return key != 0 ? key : 1;  // 0 means "no key"
+}
+
+uint64_t GeometryCache::deriveKey(uint64_t parentKey, const std::string& operation) {
+    uint64_t key = Hash::combine(parentKey, Hash::string(operation));
+    return key != 0 ? key : 1;
+}
+
+std::string GeometryCache::subdivisionOperation(bool smooth, float creaseAngle) {
+    return smooth ? "loop:" + std::to_string(creaseAngle) : std::string("midpoint");
+}
+
+std::string GeometryCache::pathForKey(uint64_t key) const {
+    std::ostringstream name;
+    name << std::hex << std::setw(16) << std::setfill('0') << key << ".mvgc";
+    return (std::filesystem::path(m_directory) / name.str()).string();
+}
+
+std::unique_ptr<CacheEntry> GeometryCache::open(uint64_t key) const {
+    if (!isEnabled() || key == 0) {
+        return nullptr;
+    }
+
+    auto entry = std::make_unique<CacheEntry>();
+    if (!entry->m_file.open(pathForKey(key))) {
+        return nullptr;  // Plain miss
+    }
+
+    const uint8_t* data = entry->m_file.data();
+    const size_t size = entry->m_file.size();
+
+    if (size < sizeof(FileHeader)) {
+        return nullptr;
+    }
+
+    FileHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 ||
+        header.version != CACHE_VERSION ||
+        header.vertexSize != sizeof(Vertex) ||
+        header.key != key ||
+        header.levelCount == 0 || header.levelCount > MAX_LEVELS) {
+        return nullptr;
+    }
+
+    const size_t recordsEnd = sizeof(FileHeader) + header.levelCount * sizeof(LevelRecord);
+    if (recordsEnd + header.textureBytes > size) {
+        return nullptr;
+    }
+
+    entry->m_texturePath.assign(reinterpret_cast<const char*>(data + recordsEnd), header.textureBytes);
+
+    for (uint32_t i = 0; i < header.levelCount; ++i) {
+        LevelRecord record;
+        std::memcpy(&record, data + sizeof(FileHeader) + i * sizeof(LevelRecord), sizeof(record));
+
+        bool valid = arrayFits(record.vertexOffset, record.vertexCount, sizeof(Vertex), size) &&
+                     arrayFits(record.indexOffset, record.indexCount, sizeof(uint32_t), size) &&
+                     arrayFits(record.meshletOffset, record.meshletCount, sizeof(Meshlet), size) &&
+                     record.vertexCount != 0 && record.indexCount % 3 == 0;
+
+        // Indices and meshlet ranges go straight to the GPU and the BVH builder
+        if (valid) {
+            const uint32_t* indices = reinterpret_cast<const uint32_t*>(data + record.indexOffset);
+            uint32_t maxIndex = 0;
+            for (uint32_t k = 0; k < record.indexCount; ++k) {
+                maxIndex = std::max(maxIndex, indices[k]);
+            }
+            valid = maxIndex < record.vertexCount;
+        }
+        if (valid) {
+            const Meshlet* meshlets = reinterpret_cast<const Meshlet*>(data + record.meshletOffset);
+            for (uint32_t m = 0; m < record.meshletCount && valid; ++m) {
+                valid = static_cast<uint64_t>(meshlets[m].firstIndex) + meshlets[m].indexCount <= record.indexCount;
+            }
+        }
+        if (!valid) {
+            std::cerr << "GeometryCache error: corrupt entry " << pathForKey(key) << std::endl;
+            return nullptr;
+        }
+
+        CacheEntry::Level level;
+        level.vertexOffset = record.vertexOffset;
+        level.indexOffset = record.indexOffset;
+        level.vertexCount = record.vertexCount;
+        level.indexCount = record.indexCount;
+        level.meshletOffset = record.meshletOffset;
+        level.meshletCount = record.meshletCount;
+        level.threshold = record.threshold;
+        level.minBounds = glm::vec3(record.minBounds[0], record.minBounds[1], record.minBounds[2]);
+        level.maxBounds = glm::vec3(record.maxBounds[0], record.maxBounds[1], record.maxBounds[2]);
+        entry->m_levels.push_back(level);
+    }
+
+    return entry;
+}
+
+bool GeometryCache::store(uint64_t key, const MeshData& baseMesh,
+                          const std::vector<LODLevel>& lodLevels) const {
+    if (!isEnabled() || key == 0 || baseMesh.empty()) {
+        return false;
+    }
+
+    // Level 0 is always the base mesh; LOD level 0 duplicates it and is skipped
+    std::vector<LevelSource> sources;
+    sources.push_back({&baseMesh, LODSelector::LOD0_THRESHOLD});
+    for (size_t i = 1; i < lodLevels.size() && sources.size() < MAX_LEVELS; ++i) {
+        if (lodLevels[i].meshData.empty()) {
+            return false;  // GPU-only level, nothing to write
+        }
+        sources.push_back({&lodLevels[i].meshData, lodLevels[i].screenSizeThreshold});
+    }
+
+    FileHeader header{};
+    std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.version = CACHE_VERSION;
+    header.vertexSize = sizeof(Vertex);
+    header.key = key;
+    header.levelCount = static_cast<uint32_t>(sources.size());
+    header.textureBytes = static_cast<uint32_t>(baseMesh.texturePath.size());
+
+    // Lay out the arrays
+    std::vector<LevelRecord> records(sources.size());
+    uint64_t offset = sizeof(FileHeader) + records.size() * sizeof(LevelRecord) + header.textureBytes;
+    for (size_t i = 0; i < sources.size(); ++i) {
+        const MeshData& data = *sources[i].data;
+        LevelRecord& record = records[i];
+        record = LevelRecord{};
+
+        record.vertexOffset = alignUp(offset);
+        offset = record.vertexOffset + data.vertices.size() * sizeof(Vertex);
+        record.indexOffset = alignUp(offset);
+        offset = record.indexOffset + data.indices.size() * sizeof(uint32_t);
+        record.meshletOffset = alignUp(offset);
+        offset = record.meshletOffset + data.meshlets.size() * sizeof(Meshlet);
+
+        record.vertexCount = static_cast<uint32_t>(data.vertices.size());
+        record.indexCount = static_cast<uint32_t>(data.indices.size());
+        record.meshletCount = static_cast<uint32_t>(data.meshlets.size());
+        record.threshold = sources[i].threshold;
+        for (int c = 0; c < 3; ++c) {
+            record.minBounds[c] = data.minBounds[c];
+            record.maxBounds[c] = data.maxBounds[c];
+        }
+    }
+
+    // Unique temporary name so concurrent writers never interleave
+    const std::string finalPath = pathForKey(key);
+    std::ostringstream tmpName;
+    tmpName << finalPath << ".tmp" << std::hash<std::thread::id>()(std::this_thread::get_id())
+            << "_" << std::chrono::steady_clock::now().time_since_epoch().count();
+    const std::string tmpPath = tmpName.str();
+
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            std::cerr << "GeometryCache error: cannot write " << tmpPath << std::endl;
+            return false;
+        }
+
+        static const char padding[ARRAY_ALIGNMENT] = {};
+        uint64_t written = 0;
+        auto write = [&](const void* bytes, uint64_t count) {
+            out.write(static_cast<const char*>(bytes), static_cast<std::streamsize>(count));
+            written += count;
+        };
+        auto padTo = [&](uint64_t target) {
+            write(padding, target - written);
+        };
+
+        write(&header, sizeof(header));
+        write(records.data(), records.size() * sizeof(LevelRecord));
+        write(baseMesh.texturePath.data(), header.textureBytes);
+
+        for (size_t i = 0; i < sources.size(); ++i) {
+            const MeshData& data = *sources[i].data;
+            padTo(records[i].vertexOffset);
+            write(data.vertices.data(), data.vertices.size() * sizeof(Vertex));
+            padTo(records[i].indexOffset);
+            write(data.indices.data(), data.indices.size() * sizeof(uint32_t));
+            padTo(records[i].meshletOffset);
+            write(data.meshlets.data(), data.meshlets.size() * sizeof(Meshlet));
+        }
+
+        if (!out) {
+            std::cerr << "GeometryCache error: write failed for " << tmpPath << std::endl;
+            out.close();
+            std::error_code ec;
+            std::filesystem::remove(tmpPath, ec);
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tmpPath, finalPath, ec);
+    if (ec) {
+        std::cerr << "GeometryCache error: cannot rename " << tmpPath << " (" << ec.message() << ")" << std::endl;
+        std::filesystem::remove(tmpPath, ec);
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "mesh/MeshData.h"
+#include "lod/LODLevel.h"
+#include "util/MappedFile.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Read-only view of one cache file, kept memory-mapped while in use.
+// Level 0 is the processed base mesh, levels 1..N are the LOD chain.
+class CacheEntry {
+public:
+    size_t getLevelCount() const { return m_levels.size(); }
+    bool hasLODChain() const { return m_levels.size() > 1; }
+
+    // Raw arrays pointing into the mapping (valid while the entry is alive)
+    const Vertex* getVertices(size_t level) const;
+    const uint32_t* getIndices(size_t level) const;
+    const Meshlet* getMeshlets(size_t level) const;
+    uint32_t getVertexCount(size_t level) const { return m_levels[level].vertexCount; }
+    uint32_t getIndexCount(size_t level) const { return m_levels[level].indexCount; }
+    uint32_t getMeshletCount(size_t level) const { return m_levels[level].meshletCount; }
+    float getThreshold(size_t level) const { return m_levels[level].threshold; }
+    const std::string& getTexturePath() const { return m_texturePath; }
+
+    // Copy a level into CPU mesh data
+    MeshData toMeshData(size_t level) const;
+
+    // Upload a level straight from the mapping (main thread only)
+    std::shared_ptr<Mesh> uploadLevel(size_t level) const;
+
+    // Build the LOD chain from the mapping; GPU-only levels (main thread only)
+    std::vector<LODLevel> uploadLODLevels() const;
+
+    // Build the LOD chain as CPU levels (safe on worker threads)
+    std::vector<LODLevel> toLODLevels() const;
+
+private:
+    friend class GeometryCache;
+
+    struct Level {
+        uint64_t vertexOffset;
+        uint64_t indexOffset;
+        uint64_t meshletOffset;
+        uint32_t vertexCount;
+        uint32_t indexCount;
+        uint32_t meshletCount;
+        float threshold;
+        glm::vec3 minBounds;
+        glm::vec3 maxBounds;
+    };
+
+    MappedFile m_file;
+    std::vector<Level> m_levels;
+    std::string m_texturePath;
+};
+
+// Content-addressed on-disk cache for processed geometry.
+// Entries are keyed by a hash of the source file content plus the processing
+// parameters, and stored in a flat binary layout that is mapped, not parsed.
+// All methods only touch the filesystem and may be called from any thread.
+class GeometryCache {
+public:
+    explicit GeometryCache(const std::string& directory);
+
+    bool isEnabled() const { return !m_directory.empty(); }
+    const std::string& getDirectory() const { return m_directory; }
+
+    // Key for a source file: content hash combined with the LOD parameters
+    // (and, for OBJ, its directory and MTL files, which decide the texture path)
+    // Returns 0 if the file cannot be read
+    uint64_t keyForFile(const std::string& path) const;
+
+    // Key for geometry derived from a cached parent (e.g. "loop:30")
+    static uint64_t deriveKey(uint64_t parentKey, const std::string& operation);
+
+    // Operation tag used to derive keys of subdivision results
+    static std::string subdivisionOperation(bool smooth, float creaseAngle);
+
+    // Map an entry; returns nullptr on miss or if the entry is stale/corrupt
+    std::unique_ptr<CacheEntry> open(uint64_t key) const;
+
+    // Write an entry (base mesh plus optional LOD chain whose level 0 is the base)
+    // Written to a temporary file and renamed, so readers never see partial files
+    bool store(uint64_t key, const MeshData& baseMesh,
+               const std::vector<LODLevel>& lodLevels = {}) const;
+
+private:
+    std::string pathForKey(uint64_t key) const;
+
+    std::string m_directory;
+};
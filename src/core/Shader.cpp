@@ -1,37 +1,180 @@
 #include "Shader.h"
+#include "util/Hash.h"
 #include <glm/gtc/type_ptr.hpp>
+#include <filesystem>
 #include <fstream>
 #include <sstream>
+#include <iomanip>
 #include <iostream>
 #include <stdexcept>
 
-Shader::Shader(const std::string& vertexPath, const std::string& fragmentPath) {
-    std::string vertexSource = loadFile(vertexPath);
-    std::string fragmentSource = loadFile(fragmentPath);
+namespace {
+    constexpr uint32_t BINARY_MAGIC = 0x52444853;  // "SHDR"
+    constexpr uint32_t BINARY_VERSION = 1;
 
-    GLuint vertexShader = compileShader(GL_VERTEX_SHADER, vertexSource);
-    GLuint fragmentShader = compileShader(GL_FRAGMENT_SHADER, fragmentSource);
+    struct BinaryHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t format;
+        uint32_t length;
+    };
 
-    m_program = glCreateProgram();
-    glAttachShader(m_program, vertexShader);
-    glAttachShader(m_program, fragmentShader);
-    glLinkProgram(m_program);
+    std::string s_binaryCacheDirectory = "shader_cache";
+
+    // Queried once, with the first program
+    struct DriverState {
+        bool initialized{false};
+        bool parallelCompile{false};
+        bool programBinaries{false};
+        uint64_t hash{0};   // Vendor, renderer and version strings
+    };
+
+    DriverState& driverState() {
+        static DriverState state;
+        if (state.initialized) {
+            return state;
+        }
+        state.initialized = true;
+
+        // Let the driver compile on as many threads as it likes
+        if (GLAD_GL_KHR_parallel_shader_compile) {
+            glMaxShaderCompilerThreadsKHR(0xFFFFFFFFu);
+            state.parallelCompile = true;
+        } else if (GLAD_GL_ARB_parallel_shader_compile) {
+            glMaxShaderCompilerThreadsARB(0xFFFFFFFFu);
+            state.parallelCompile = true;
+        }
+
+        GLint formatCount = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+        state.programBinaries = formatCount > 0;
+
+        // A driver update invalidates every cached binary
+        uint64_t h = Hash::DEFAULT_SEED;
+        for (GLenum name : {GL_VENDOR, GL_RENDERER, GL_VERSION}) {
+            const char* value = reinterpret_cast<const char*>(glGetString(name));
+            h = Hash::combine(h, Hash::string(value ? value : ""));
+        }
+        state.hash = h;
+        return state;
+    }
+}
 
-    // Always clean up compiled shaders (they remain attached to the program)
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
+Shader::Shader(const std::string& vertexPath, const std::string& fragmentPath) {
+    start({{GL_VERTEX_SHADER, vertexPath, loadFile(vertexPath)},
+           {GL_FRAGMENT_SHADER, fragmentPath, loadFile(fragmentPath)}});
+}
 
-    checkLinkErrors(m_program);
+Shader::Shader(const std::string& computePath) {
+    start({{GL_COMPUTE_SHADER, computePath, loadFile(computePath)}});
 }
 
 Shader::~Shader() {
+    if (m_pending) {
+        for (Stage& stage : m_pending->stages) {
+            if (stage.shader) glDeleteShader(stage.shader);
+        }
+    }
     glDeleteProgram(m_program);
 }
 
 void Shader::use() const {
+    finish();
     glUseProgram(m_program);
 }
 
+bool Shader::isReady() const {
+    if (!m_pending) {
+        return true;
+    }
+    if (driverState().parallelCompile) {
+        GLint complete = GL_FALSE;
+        glGetProgramiv(m_program, GL_COMPLETION_STATUS_KHR, &complete);
+        return complete == GL_TRUE;
+    }
+    return false;
+}
+
+// ========== Build ==========
+
+void Shader::start(std::vector<Stage> stages) {
+    const DriverState& driver = driverState();
+
+    m_pending = std::make_unique<PendingBuild>();
+    m_pending->stages = std::move(stages);
+
+    uint64_t key = driver.hash;
+    for (const Stage& stage : m_pending->stages) {
+        key = Hash::combine(key, stage.type);
+        key = Hash::combine(key, Hash::string(stage.source));
+    }
+    m_pending->cacheKey = key;
+
+    m_program = glCreateProgram();
+    if (driver.programBinaries && loadBinary(key)) {
+        m_pending->fromCache = true;
+        return;
+    }
+    compileAndLink(*m_pending);
+}
+
+void Shader::compileAndLink(PendingBuild& build) const {
+    // Nothing here waits for the compiler; errors are checked in finish()
+    for (Stage& stage : build.stages) {
+        stage.shader = compileShader(stage.type, stage.source);
+        glAttachShader(m_program, stage.shader);
+    }
+    if (driverState().programBinaries) {
+        glProgramParameteri(m_program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+    glLinkProgram(m_program);
+}
+
+void Shader::finish() const {
+    if (!m_pending) {
+        return;
+    }
+    std::unique_ptr<PendingBuild> build = std::move(m_pending);
+
+    GLint linked = GL_FALSE;
+    glGetProgramiv(m_program, GL_LINK_STATUS, &linked);
+    if (build->fromCache && !linked) {
+        // Rejected binary (e.g. changed driver); build from source instead
+        compileAndLink(*build);
+        build->fromCache = false;
+        glGetProgramiv(m_program, GL_LINK_STATUS, &linked);
+    }
+
+    // Always clean up compiled shaders (the program keeps what it needs)
+    struct StageCleanup {
+        GLuint program;
+        std::vector<Stage>& stages;
+        ~StageCleanup() {
+            for (Stage& stage : stages) {
+                if (stage.shader) {
+                    glDetachShader(program, stage.shader);
+                    glDeleteShader(stage.shader);
+                    stage.shader = 0;
+                }
+            }
+        }
+    } cleanup{m_program, build->stages};
+
+    if (!linked) {
+        // A failed stage explains the failure better than the link log
+        for (const Stage& stage : build->stages) {
+            std::string typeName = (stage.type == GL_VERTEX_SHADER) ? "VERTEX"
+                                 : (stage.type == GL_COMPUTE_SHADER) ? "COMPUTE" : "FRAGMENT";
+            checkCompileErrors(stage.shader, typeName + " (" + stage.path + ")");
+        }
+        checkLinkErrors(m_program);
+    }
+
+    if (!build->fromCache && driverState().programBinaries) {
+        saveBinary(build->cacheKey);
+    }
+}
+
 std::string Shader::loadFile(const std::string& path) const {
     std::ifstream file(path);
     if (!file.is_open()) {
@@ -47,10 +190,6 @@ GLuint Shader::compileShader(GLenum type, const std::string& source) const {
     const char* src = source.c_str();
     glShaderSource(shader, 1, &src, nullptr);
     glCompileShader(shader);
-
-    std::string typeName = (type == GL_VERTEX_SHADER) ? "VERTEX" : "FRAGMENT";
-    checkCompileErrors(shader, typeName);
-
     return shader;
 }
 
@@ -75,6 +214,7 @@ void Shader::checkLinkErrors(GLuint program) const {
 }
 
 GLint Shader::getUniformLocation(const std::string& name) const {
+    finish();
     auto it = m_uniformLocationCache.find(name);
     if (it != m_uniformLocationCache.end()) {
         return it->second;
@@ -119,3 +259,94 @@ void Shader::setMat3(const std::string& name, const glm::mat3& value) const {
 void Shader::setMat4(const std::string& name, const glm::mat4& value) const {
     glUniformMatrix4fv(getUniformLocation(name), 1, GL_FALSE, glm::value_ptr(value));
 }
+
+// ========== Program Binary Cache ==========
+
+void Shader::setBinaryCacheDirectory(const std::string& directory) {
+    s_binaryCacheDirectory = directory;
+}
+
+const std::string& Shader::getBinaryCacheDirectory() {
+    return s_binaryCacheDirectory;
+}
+
+std::string Shader::binaryPath(uint64_t key) {
+    std::ostringstream name;
+    name << std::hex << std::setw(16) << std::setfill('0') << key << ".bin";
+    return (std::filesystem::path(s_binaryCacheDirectory) / name.str()).string();
+}
+
+bool Shader::loadBinary(uint64_t key) const {
+    if (s_binaryCacheDirectory.empty()) {
+        return false;
+    }
+
+    std::ifstream in(binaryPath(key), std::ios::binary);
+    if (!in) {
+        return false;
+    }
+
+    BinaryHeader header{};
+    in.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!in || header.magic != BINARY_MAGIC || header.version != BINARY_VERSION || header.length == 0) {
+        return false;
+    }
+
+    std::vector<char> data(header.length);
+    in.read(data.data(), static_cast<std::streamsize>(data.size()));
+    if (!in) {
+        return false;
+    }
+
+    glProgramBinary(m_program, header.format, data.data(), static_cast<GLsizei>(data.size()));
+    return true;
+}
+
+void Shader::saveBinary(uint64_t key) const {
+    if (s_binaryCacheDirectory.empty()) {
+        return;
+    }
+
+    GLint length = 0;
+    glGetProgramiv(m_program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) {
+        return;
+    }
+
+    BinaryHeader header{BINARY_MAGIC, BINARY_VERSION, 0, 0};
+    std::vector<char> data(static_cast<size_t>(length));
+    GLsizei written = 0;
+    glGetProgramBinary(m_program, length, &written, &header.format, data.data());
+    if (written <= 0) {
+        return;
+    }
+    header.length = static_cast<uint32_t>(written);
+
+    std::error_code ec;
+    std::filesystem::create_directories(s_binaryCacheDirectory, ec);
+
+    // Write to a temporary file first so a crash never leaves a truncated entry
+    const std::string finalPath = binaryPath(key);
+    const std::string tmpPath = finalPath + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            std::cerr << "Shader cache error: cannot write " << tmpPath << std::endl;
+            return;
+        }
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(data.data(), written);
+        if (!out) {
+            std::cerr << "Shader cache error: failed writing " << tmpPath << std::endl;
+            out.close();
+            std::filesystem::remove(tmpPath, ec);
+            return;
+        }
+    }
+
+    std::filesystem::rename(tmpPath, finalPath, ec);
+    if (ec) {
+        std::cerr << "Shader cache error: cannot rename " << tmpPath << " (" << ec.message() << ")" << std::endl;
+        std::filesystem::remove(tmpPath, ec);
+    }
+}
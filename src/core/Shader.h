@@ -2,19 +2,34 @@
 
 #include <glad/gl.h>
 #include <glm/glm.hpp>
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
+// GLSL program built from source files.
+//
+// Construction only starts the build: the program is loaded from the binary
+// cache if a matching entry exists, otherwise its stages are compiled and
+// linked. Status is checked the first time the program is used, so programs
+// created back to back compile in parallel on drivers with
+// GL_KHR_parallel_shader_compile. Freshly linked programs are written to the
+// cache, keyed by their sources and the driver, so later runs skip compiling.
 class Shader {
 public:
     Shader(const std::string& vertexPath, const std::string& fragmentPath);
+    explicit Shader(const std::string& computePath);
     ~Shader();
 
     Shader(const Shader&) = delete;
     Shader& operator=(const Shader&) = delete;
 
     void use() const;
-    GLuint getProgram() const { return m_program; }
+    GLuint getProgram() const { finish(); return m_program; }
+
+    // True once the build finished (never blocks with parallel compilation)
+    bool isReady() const;
 
     void setBool(const std::string& name, bool value) const;
     void setInt(const std::string& name, int value) const;
@@ -26,13 +41,42 @@ public:
     void setMat3(const std::string& name, const glm::mat3& value) const;
     void setMat4(const std::string& name, const glm::mat4& value) const;
 
+    // ========== Program Binary Cache ==========
+
+    // Directory for cached program binaries; empty disables the cache
+    static void setBinaryCacheDirectory(const std::string& directory);
+    static const std::string& getBinaryCacheDirectory();
+
 private:
+    struct Stage {
+        GLenum type;
+        std::string path;
+        std::string source;
+        GLuint shader{0};
+    };
+
+    // Build state kept until the first use
+    struct PendingBuild {
+        std::vector<Stage> stages;
+        uint64_t cacheKey{0};
+        bool fromCache{false};
+    };
+
+    void start(std::vector<Stage> stages);
+    void compileAndLink(PendingBuild& build) const;
+    void finish() const;
+
     std::string loadFile(const std::string& path) const;
     GLuint compileShader(GLenum type, const std::string& source) const;
     void checkCompileErrors(GLuint shader, const std::string& type) const;
     void checkLinkErrors(GLuint program) const;
     GLint getUniformLocation(const std::string& name) const;
 
-    GLuint m_program;
+    bool loadBinary(uint64_t key) const;
+    void saveBinary(uint64_t key) const;
+    static std::string binaryPath(uint64_t key);
+
+    GLuint m_program{0};
+    mutable std::unique_ptr<PendingBuild> m_pending;
     mutable std::unordered_map<std::string, GLint> m_uniformLocationCache;
 };
@@ -4,44 +4,72 @@
 #include "Texture.h"
 #include <iostream>
 
-Texture::~Texture() {
-    if (m_textureID) {
-        glDeleteTextures(1, &m_textureID);
+namespace {
+    bool formatsForChannels(int channels, GLenum& internalFormat, GLenum& format) {
+        switch (channels) {
+            case 1:
+                internalFormat = GL_R8;
+                format = GL_RED;
+                return true;
+            case 2:
+                internalFormat = GL_RG8;
+                format = GL_RG;
+                return true;
+            case 3:
+                internalFormat = GL_RGB8;
+                format = GL_RGB;
+                return true;
+            case 4:
+                internalFormat = GL_RGBA8;
+                format = GL_RGBA;
+                return true;
+            default:
+                return false;
+        }
     }
 }
 
+Texture::~Texture() {
+    release();
+}
+
 Texture::Texture(Texture&& other) noexcept
     : m_textureID(other.m_textureID)
     , m_width(other.m_width)
     , m_height(other.m_height)
+    , m_levels(other.m_levels)
+    , m_baseLevel(other.m_baseLevel)
+    , m_format(other.m_format)
 {
     other.m_textureID = 0;
     other.m_width = 0;
     other.m_height = 0;
+    other.m_levels = 0;
+    other.m_baseLevel = 0;
 }
 
 Texture& Texture::operator=(Texture&& other) noexcept {
     if (this != &other) {
-        if (m_textureID) {
-            glDeleteTextures(1, &m_textureID);
-        }
+        release();
         m_textureID = other.m_textureID;
         m_width = other.m_width;
         m_height = other.m_height;
+        m_levels = other.m_levels;
+        m_baseLevel = other.m_baseLevel;
+        m_format = other.m_format;
 
         other.m_textureID = 0;
         other.m_width = 0;
         other.m_height = 0;
+        other.m_levels = 0;
+        other.m_baseLevel = 0;
     }
     return *this;
 }
 
 bool Texture::load(const std::string& path) {
     // Clean up any previously loaded texture
-    if (m_textureID) {
-        glDeleteTextures(1, &m_textureID);
-        m_textureID = 0;
-    }
+    release();
 
     // Load image data
     stbi_set_flip_vertically_on_load(true);
@@ -55,31 +83,17 @@ bool Texture::load(const std::string& path) {
 
     // Determine format based on channels
     GLenum internalFormat, format;
-    switch (channels) {
-        case 1:
-            internalFormat = GL_R8;
-            format = GL_RED;
-            break;
-        case 2:
-            internalFormat = GL_RG8;
-            format = GL_RG;
-            break;
-        case 3:
-            internalFormat = GL_RGB8;
-            format = GL_RGB;
-            break;
-        case 4:
-            internalFormat = GL_RGBA8;
-            format = GL_RGBA;
-            break;
-        default:
-            std::cerr << "Unsupported channel count: " << channels << std::endl;
-            stbi_image_free(data);
-            return false;
+    if (!formatsForChannels(channels, internalFormat, format)) {
+        std::cerr << "Unsupported channel count: " << channels << std::endl;
+        stbi_image_free(data);
+        return false;
     }
 
     // Calculate mipmap levels
     int levels = static_cast<int>(std::floor(std::log2(std::max(m_width, m_height)))) + 1;
+    m_levels = levels;
+    m_baseLevel = 0;
+    m_format = format;
 
     // Create texture using DSA
     glCreateTextures(GL_TEXTURE_2D, 1, &m_textureID);
@@ -103,6 +117,58 @@ bool Texture::load(const std::string& path) {
     return true;
 }
 
+bool Texture::allocate(int width, int height, int levels, int channels) {
+    release();
+
+    GLenum internalFormat;
+    if (!formatsForChannels(channels, internalFormat, m_format)) {
+        std::cerr << "Unsupported channel count: " << channels << std::endl;
+        return false;
+    }
+
+    m_width = width;
+    m_height = height;
+    m_levels = levels;
+    m_baseLevel = levels;  // Nothing uploaded yet
+
+    glCreateTextures(GL_TEXTURE_2D, 1, &m_textureID);
+    glTextureStorage2D(m_textureID, levels, internalFormat, width, height);
+
+    glTextureParameteri(m_textureID, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTextureParameteri(m_textureID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTextureParameteri(m_textureID, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTextureParameteri(m_textureID, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTextureParameteri(m_textureID, GL_TEXTURE_MAX_LEVEL, levels - 1);
+
+    return true;
+}
+
+void Texture::uploadLevel(int level, int width, int height, const void* pixels) {
+    if (!m_textureID || level < 0 || level >= m_levels) {
+        return;
+    }
+
+    // Mip rows are tightly packed (RGB rows need not be 4-byte aligned)
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTextureSubImage2D(m_textureID, level, 0, 0, width, height, m_format, GL_UNSIGNED_BYTE, pixels);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    // Levels arrive coarsest first; sample from the finest one available
+    if (level < m_baseLevel) {
+        m_baseLevel = level;
+        glTextureParameteri(m_textureID, GL_TEXTURE_BASE_LEVEL, m_baseLevel);
+    }
+}
+
+void Texture::release() {
+    if (m_textureID) {
+        glDeleteTextures(1, &m_textureID);
+        m_textureID = 0;
+    }
+    m_levels = 0;
+    m_baseLevel = 0;
+}
+
 void Texture::bind(GLuint unit) const {
     glBindTextureUnit(unit, m_textureID);
 }
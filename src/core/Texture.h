@@ -19,13 +19,24 @@ public:
     bool load(const std::string& path);
     void bind(GLuint unit = 0) const;
 
+    // Incremental loading: allocate the full mip chain, then upload levels
+    // coarsest first. Sampling is clamped to the finest uploaded level.
+    bool allocate(int width, int height, int levels, int channels);
+    void uploadLevel(int level, int width, int height, const void* pixels);
+    void release();
+
     GLuint getID() const { return m_textureID; }
     int getWidth() const { return m_width; }
     int getHeight() const { return m_height; }
+    int getLevelCount() const { return m_levels; }
+    int getBaseLevel() const { return m_baseLevel; }
     bool isValid() const { return m_textureID != 0; }
 
 private:
     GLuint m_textureID{0};
     int m_width{0};
     int m_height{0};
+    int m_levels{0};
+    int m_baseLevel{0};
+    GLenum m_format{GL_RGBA};
 };
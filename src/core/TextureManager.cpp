@@ -0,0 +1,232 @@
+#include "TextureManager.h"
+#include <stb/stb_image.h>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <thread>
+
+namespace {
+    // Upload at most this much per frame (at least one level is always uploaded)
+    constexpr size_t UPLOAD_BYTES_PER_FRAME = 8ull * 1024 * 1024;
+
+    // Textures used within this many frames are never evicted
+    constexpr uint64_t EVICTION_GRACE_FRAMES = 120;
+
+    size_t mipBytes(const TextureMip& mip, int channels) {
+        // Drivers typically pad RGB8 to four bytes per texel
+        const int texelBytes = (channels == 3) ? 4 : channels;
+        return static_cast<size_t>(mip.width) * mip.height * texelBytes;
+    }
+
+    // 2x2 box filter; odd edges repeat the last row/column
+    void downsample(const TextureMip& src, TextureMip& dst, int channels) {
+        dst.width = std::max(1, src.width / 2);
+        dst.height = std::max(1, src.height / 2);
+        dst.pixels.resize(static_cast<size_t>(dst.width) * dst.height * channels);
+
+        const size_t srcStride = static_cast<size_t>(src.width) * channels;
+        const size_t dstStride = static_cast<size_t>(dst.width) * channels;
+
+        #pragma omp parallel for schedule(static) if (dst.height >= 64)
+        for (int y = 0; y < dst.height; ++y) {
+            const uint8_t* row0 = src.pixels.data() + std::min(2 * y, src.height - 1) * srcStride;
+            const uint8_t* row1 = src.pixels.data() + std::min(2 * y + 1, src.height - 1) * srcStride;
+            uint8_t* out = dst.pixels.data() + y * dstStride;
+
+            for (int x = 0; x < dst.width; ++x) {
+                const size_t x0 = static_cast<size_t>(std::min(2 * x, src.width - 1)) * channels;
+                const size_t x1 = static_cast<size_t>(std::min(2 * x + 1, src.width - 1)) * channels;
+                for (int c = 0; c < channels; ++c) {
+                    const unsigned sum = row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c];
+                    out[x * channels + c] = static_cast<uint8_t>((sum + 2) / 4);
+                }
+            }
+        }
+    }
+
+    // Half the cores: the mip chains are built with OpenMP inside each worker
+    unsigned decodeWorkerCount() {
+        const unsigned cores = std::max(std::thread::hardware_concurrency(), 1u);
+        return std::clamp(cores / 2, 1u, TextureManager::MAX_DECODE_WORKERS);
+    }
+}
+
+TextureManager::TextureManager()
+    : TaskManager<TextureTask>(decodeWorkerCount())
+{
+}
+
+std::shared_ptr<TextureEntry> TextureManager::acquire(const std::string& path) {
+    auto it = m_entries.find(path);
+    if (it != m_entries.end()) {
+        return it->second;
+    }
+
+    auto entry = std::make_shared<TextureEntry>();
+    entry->path = path;
+    m_entries.emplace(path, entry);
+    return entry;
+}
+
+Texture* TextureManager::use(const std::shared_ptr<TextureEntry>& entry) {
+    if (!entry) {
+        return nullptr;
+    }
+
+    entry->lastUsedFrame = m_frame;
+
+    if (entry->state == TextureEntry::State::Unloaded) {
+        entry->state = TextureEntry::State::Decoding;
+        submitTask(std::make_unique<TextureTask>(entry, entry->path));
+        return nullptr;
+    }
+
+    const Texture& texture = entry->texture;
+    if (texture.isValid() && texture.getBaseLevel() < texture.getLevelCount()) {
+        return &entry->texture;
+    }
+    return nullptr;
+}
+
+void TextureManager::update() {
+    uploadPendingMips();
+    evictUnused();
+    ++m_frame;
+}
+
+void TextureManager::processTask(TextureTask& task) {
+    task.progress.setPhase(1);
+
+    int width, height, channels;
+    // Runs on one of several decode workers: set the per-thread flag, not stb's global one
+    stbi_set_flip_vertically_on_load_thread(true);
+    unsigned char* data = stbi_load(task.path.c_str(), &width, &height, &channels, 0);
+
+    if (!data) {
+        std::cerr << "Failed to load texture: " << task.path << std::endl;
+        std::cerr << "STB Error: " << stbi_failure_reason() << std::endl;
+        task.failed = true;
+        task.progress.complete();
+        return;
+    }
+
+    if (channels < 1 || channels > 4) {
+        std::cerr << "Unsupported channel count: " << channels << std::endl;
+        stbi_image_free(data);
+        task.failed = true;
+        task.progress.complete();
+        return;
+    }
+
+    const int levels = static_cast<int>(std::floor(std::log2(std::max(width, height)))) + 1;
+    task.channels = channels;
+    task.mips.resize(levels);
+    task.mips[0].width = width;
+    task.mips[0].height = height;
+    task.mips[0].pixels.assign(data, data + static_cast<size_t>(width) * height * channels);
+    stbi_image_free(data);
+
+    // ========== Mip chain ==========
+    task.progress.setPhase(2);
+    for (int level = 1; level < levels; ++level) {
+        if (task.progress.isCancelled()) {
+            return;
+        }
+        downsample(task.mips[level - 1], task.mips[level], channels);
+        task.progress.updatePhaseProgress(static_cast<float>(level) / (levels - 1));
+    }
+
+    task.progress.complete();
+}
+
+bool TextureManager::applyTaskResult(TextureTask& task) {
+    TextureEntry& entry = *task.targetEntry;
+
+    if (task.failed || task.mips.empty() ||
+        !entry.texture.allocate(task.mips[0].width, task.mips[0].height,
+                                static_cast<int>(task.mips.size()), task.channels)) {
+        entry.state = TextureEntry::State::Failed;
+        return false;
+    }
+
+    entry.channels = task.channels;
+    entry.pendingMips = std::move(task.mips);
+    entry.nextUploadLevel = static_cast<int>(entry.pendingMips.size()) - 1;
+    entry.state = TextureEntry::State::Uploading;
+    m_uploadQueue.push_back(task.targetEntry);
+    return true;
+}
+
+void TextureManager::uploadPendingMips() {
+    size_t uploadedBytes = 0;
+
+    while (!m_uploadQueue.empty()) {
+        TextureEntry& entry = *m_uploadQueue.front();
+
+        // Coarsest level first, so the object is textured (blurry) right away
+        while (entry.nextUploadLevel >= 0) {
+            const TextureMip& mip = entry.pendingMips[entry.nextUploadLevel];
+            const size_t bytes = mipBytes(mip, entry.channels);
+            if (uploadedBytes > 0 && uploadedBytes + bytes > UPLOAD_BYTES_PER_FRAME) {
+                return;
+            }
+
+            entry.texture.uploadLevel(entry.nextUploadLevel, mip.width, mip.height, mip.pixels.data());
+            entry.residentBytes += bytes;
+            m_residentBytes += bytes;
+            uploadedBytes += bytes;
+            --entry.nextUploadLevel;
+        }
+
+        entry.pendingMips.clear();
+        entry.pendingMips.shrink_to_fit();
+        entry.state = TextureEntry::State::Resident;
+        m_uploadQueue.pop_front();
+    }
+}
+
+void TextureManager::evictUnused() {
+    // Drop entries no object references any more (only the map holds them)
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (it->second.use_count() == 1) {
+            release(*it->second);
+            it = m_entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    if (m_residentBytes <= m_memoryBudget) {
+        return;
+    }
+
+    // Least recently used first; anything used recently stays
+    std::vector<TextureEntry*> candidates;
+    for (auto& [path, entry] : m_entries) {
+        if (entry->state == TextureEntry::State::Resident &&
+            m_frame - entry->lastUsedFrame > EVICTION_GRACE_FRAMES) {
+            candidates.push_back(entry.get());
+        }
+    }
+
+    std::sort(candidates.begin(), candidates.end(),
+              [](const TextureEntry* a, const TextureEntry* b) {
+                  return a->lastUsedFrame < b->lastUsedFrame;
+              });
+
+    for (TextureEntry* entry : candidates) {
+        if (m_residentBytes <= m_memoryBudget) {
+            break;
+        }
+        release(*entry);
+    }
+}
+
+void TextureManager::release(TextureEntry& entry) {
+    entry.texture.release();
+    m_residentBytes -= entry.residentBytes;
+    entry.residentBytes = 0;
+    if (entry.state == TextureEntry::State::Resident) {
+        entry.state = TextureEntry::State::Unloaded;
+    }
+}
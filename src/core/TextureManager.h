@@ -0,0 +1,86 @@
+#pragma once
+
+#include "Texture.h"
+#include "async/TaskManager.h"
+#include "async/TextureTask.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+// One texture file shared by every object that references it
+struct TextureEntry {
+    enum class State {
+        Unloaded,   // Not requested yet, or evicted
+        Decoding,   // Worker is decoding the file
+        Uploading,  // Mip levels are being uploaded, coarsest first
+        Resident,   // Fully uploaded
+        Failed      // File could not be decoded (never retried)
+    };
+
+    std::string path;
+    State state{State::Unloaded};
+    Texture texture;
+
+    // Decoded mips waiting for upload (level 0 first)
+    int channels{0};
+    std::vector<TextureMip> pendingMips;
+    int nextUploadLevel{-1};
+
+    size_t residentBytes{0};
+    uint64_t lastUsedFrame{0};
+};
+
+// Shared texture cache with background decoding and a VRAM budget.
+// Objects hold entries from acquire(); nothing is decoded until the renderer
+// calls use() for a visible object. Decoded mips are uploaded over several
+// frames within a byte budget, and textures not used recently are released
+// when resident memory exceeds the budget (they reload on next use).
+// Files are decoded on several workers, since a scene of many parts can
+// request dozens of textures in the same frame.
+class TextureManager : public TaskManager<TextureTask> {
+public:
+    static constexpr unsigned MAX_DECODE_WORKERS = 4;
+
+    TextureManager();
+    ~TextureManager() override { shutdown(); }
+
+    // Shared entry for a file path (same path -> same entry)
+    std::shared_ptr<TextureEntry> acquire(const std::string& path);
+
+    // Mark an entry as used this frame; starts loading on first use.
+    // Returns the texture once at least one mip level is resident, else nullptr
+    Texture* use(const std::shared_ptr<TextureEntry>& entry);
+
+    // Upload pending mips and enforce the memory budget (main thread, once per frame)
+    void update();
+
+    // Decoded mip levels still waiting for upload (drawn over the next frames)
+    bool hasPendingUploads() const { return !m_uploadQueue.empty(); }
+
+    void setMemoryBudget(size_t bytes) { m_memoryBudget = bytes; }
+    size_t getMemoryBudget() const { return m_memoryBudget; }
+    size_t getResidentBytes() const { return m_residentBytes; }
+    size_t getEntryCount() const { return m_entries.size(); }
+
+protected:
+    // Decode the image and build its mip chain (runs on worker thread)
+    void processTask(TextureTask& task) override;
+
+    // Hand decoded mips to the entry for upload (runs on main thread)
+    bool applyTaskResult(TextureTask& task) override;
+
+private:
+    void uploadPendingMips();
+    void evictUnused();
+    void release(TextureEntry& entry);
+
+    std::unordered_map<std::string, std::shared_ptr<TextureEntry>> m_entries;
+    std::deque<std::shared_ptr<TextureEntry>> m_uploadQueue;
+
+    uint64_t m_frame{1};
+    size_t m_memoryBudget{256ull * 1024 * 1024};
+    size_t m_residentBytes{0};
+};
@@ -36,6 +36,7 @@ Window::Window(int width, int height, const std::string& title)
     glfwSetMouseButtonCallback(m_window, mouseButtonCallback);
     glfwSetCursorPosCallback(m_window, cursorPosCallback);
     glfwSetScrollCallback(m_window, scrollCallback);
+    glfwSetWindowRefreshCallback(m_window, refreshCallback);
 
     glfwSwapInterval(1);
 
@@ -60,6 +61,14 @@ void Window::pollEvents() {
     glfwPollEvents();
 }
 
+void Window::waitEvents(double timeout) {
+    glfwWaitEventsTimeout(timeout);
+}
+
+void Window::postEmptyEvent() {
+    glfwPostEmptyEvent();
+}
+
 void Window::swapBuffers() {
     glfwSwapBuffers(m_window);
 }
@@ -113,3 +122,10 @@ void Window::scrollCallback(GLFWwindow* window, double xoffset, double yoffset)
         self->m_scrollCallback(xoffset, yoffset);
     }
 }
+
+void Window::refreshCallback(GLFWwindow* window) {
+    Window* self = static_cast<Window*>(glfwGetWindowUserPointer(window));
+    if (self->m_refreshCallback) {
+        self->m_refreshCallback();
+    }
+}
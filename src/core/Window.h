@@ -12,6 +12,7 @@ public:
     using MouseButtonCallback = std::function<void(int, int, int)>;
     using CursorPosCallback = std::function<void(double, double)>;
     using ScrollCallback = std::function<void(double, double)>;
+    using RefreshCallback = std::function<void()>;
 
     Window(int width, int height, const std::string& title);
     ~Window();
@@ -21,6 +22,10 @@ public:
 
     bool shouldClose() const;
     void pollEvents();
+    // Block until an event arrives or the timeout (seconds) expires
+    void waitEvents(double timeout);
+    // Wake a waitEvents() call; safe from any thread
+    static void postEmptyEvent();
     void swapBuffers();
 
     int getWidth() const { return m_width; }
@@ -33,6 +38,7 @@ public:
     void setMouseButtonCallback(MouseButtonCallback callback) { m_mouseButtonCallback = callback; }
     void setCursorPosCallback(CursorPosCallback callback) { m_cursorPosCallback = callback; }
     void setScrollCallback(ScrollCallback callback) { m_scrollCallback = callback; }
+    void setRefreshCallback(RefreshCallback callback) { m_refreshCallback = callback; }
 
     bool isKeyPressed(int key) const;
     bool isMouseButtonPressed(int button) const;
@@ -44,6 +50,7 @@ private:
     static void mouseButtonCallback(GLFWwindow* window, int button, int action, int mods);
     static void cursorPosCallback(GLFWwindow* window, double xpos, double ypos);
     static void scrollCallback(GLFWwindow* window, double xoffset, double yoffset);
+    static void refreshCallback(GLFWwindow* window);
 
     GLFWwindow* m_window;
     int m_width;
@@ -54,4 +61,5 @@ private:
     MouseButtonCallback m_mouseButtonCallback;
     CursorPosCallback m_cursorPosCallback;
     ScrollCallback m_scrollCallback;
+    RefreshCallback m_refreshCallback;
 };
@@ -0,0 +1,31 @@
+#include "BVHManager.h"
+#include "scene/SceneObject.h"
+#include <iostream>
+
+void BVHManager::processTask(BVHTask& task) {
+    try {
+        task.progress.setPhase(1);
+
+        auto bvh = std::make_shared<TriangleBVH>();
+        bvh->build(task.inputData);
+
+        if (!task.progress.isCancelled()) {
+            task.result = std::move(bvh);
+            task.progress.complete();
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "[" << task.objectName << "] BVH build error: " << e.what() << std::endl;
+        task.progress.setError();
+    }
+}
+
+bool BVHManager::applyTaskResult(BVHTask& task) {
+    // The mesh was replaced while building; a newer task is already queued
+    if (!task.targetObject || !task.result ||
+        task.targetObject->getMeshDataVersion() != task.meshVersion) {
+        return false;
+    }
+
+    task.targetObject->setTriangleBVH(std::move(task.result));
+    return true;
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "async/TaskManager.h"
+#include "async/BVHTask.h"
+
+class BVHManager : public TaskManager<BVHTask> {
+public:
+    BVHManager() = default;
+    ~BVHManager() override { shutdown(); }
+
+protected:
+    // Build the triangle BVH (runs on worker thread)
+    void processTask(BVHTask& task) override;
+
+    // Attach the BVH to its object if the mesh is unchanged (runs on main thread)
+    bool applyTaskResult(BVHTask& task) override;
+};
@@ -0,0 +1,32 @@
+#include "FeatureEdgeManager.h"
+#include "scene/SceneObject.h"
+#include <iostream>
+
+void FeatureEdgeManager::processTask(FeatureEdgeTask& task) {
+    try {
+        task.progress.setPhase(1);
+
+        auto edges = std::make_shared<FeatureEdges>();
+        edges->build(task.inputData, task.angleThreshold);
+
+        if (!task.progress.isCancelled()) {
+            task.result = std::move(edges);
+            task.progress.complete();
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "[" << task.objectName << "] Feature edge error: " << e.what() << std::endl;
+        task.progress.setError();
+    }
+}
+
+bool FeatureEdgeManager::applyTaskResult(FeatureEdgeTask& task) {
+    // The mesh was replaced while extracting; a newer task is already queued
+    if (!task.targetObject || !task.result ||
+        task.targetObject->getMeshDataVersion() != task.meshVersion) {
+        return false;
+    }
+
+    task.result->upload();
+    task.targetObject->setFeatureEdges(std::move(task.result));
+    return true;
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "async/TaskManager.h"
+#include "async/FeatureEdgeTask.h"
+
+class FeatureEdgeManager : public TaskManager<FeatureEdgeTask> {
+public:
+    FeatureEdgeManager() = default;
+    ~FeatureEdgeManager() override { shutdown(); }
+
+protected:
+    // Extract the edges (runs on worker thread)
+    void processTask(FeatureEdgeTask& task) override;
+
+    // Upload and attach the edges if the mesh is unchanged (runs on main thread)
+    bool applyTaskResult(FeatureEdgeTask& task) override;
+};
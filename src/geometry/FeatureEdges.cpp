@@ -0,0 +1,145 @@
+#include "FeatureEdges.h"
+#include "Subdivision.h"
+#include "lod/LODSelector.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    // Share of the sorted edges kept per level, matching the mesh LOD ratios
+    constexpr float LEVEL_RATIOS[FeatureEdges::LEVEL_COUNT] = {
+        LODSelector::LOD0_RATIO, LODSelector::LOD1_RATIO, LODSelector::LOD2_RATIO,
+        LODSelector::LOD3_RATIO, LODSelector::LOD4_RATIO, LODSelector::LOD5_RATIO
+    };
+
+    struct EdgeFace {
+        uint64_t key;    // Welded vertex pair, smaller index in the high half
+        uint32_t face;
+    };
+
+    struct Edge {
+        uint32_t v0, v1;
+        float importance;
+    };
+}
+
+FeatureEdges::~FeatureEdges() {
+    if (m_vao) glDeleteVertexArrays(1, &m_vao);
+    if (m_vbo) glDeleteBuffers(1, &m_vbo);
+    if (m_ebo) glDeleteBuffers(1, &m_ebo);
+}
+
+void FeatureEdges::build(const MeshData& mesh, float angleThreshold) {
+    m_positions.clear();
+    m_indices.clear();
+    std::fill(std::begin(m_levelCounts), std::end(m_levelCounts), 0u);
+
+    // Split vertices (per-face normals, UV seams) would hide adjacency
+    MeshData welded = Subdivision::weldVertices(mesh);
+    const size_t numFaces = welded.indices.size() / 3;
+    if (numFaces == 0) return;
+
+    std::vector<glm::vec3> faceNormals(numFaces);
+    std::vector<EdgeFace> edgeFaces;
+    edgeFaces.reserve(numFaces * 3);
+    for (size_t f = 0; f < numFaces; ++f) {
+        const uint32_t* tri = &welded.indices[f * 3];
+        const glm::vec3& p0 = welded.vertices[tri[0]].position;
+        const glm::vec3& p1 = welded.vertices[tri[1]].position;
+        const glm::vec3& p2 = welded.vertices[tri[2]].position;
+        faceNormals[f] = glm::normalize(glm::cross(p1 - p0, p2 - p0));
+
+        for (int e = 0; e < 3; ++e) {
+            uint32_t a = tri[e];
+            uint32_t b = tri[(e + 1) % 3];
+            if (a == b) continue;
+            uint64_t key = (static_cast<uint64_t>(std::min(a, b)) << 32) | std::max(a, b);
+            edgeFaces.push_back({key, static_cast<uint32_t>(f)});
+        }
+    }
+
+    // Sorting groups the faces of each edge without a hash map
+    std::sort(edgeFaces.begin(), edgeFaces.end(),
+              [](const EdgeFace& a, const EdgeFace& b) { return a.key < b.key; });
+
+    const float cosThreshold = std::cos(angleThreshold * 3.14159265f / 180.0f);
+    std::vector<Edge> edges;
+    for (size_t i = 0; i < edgeFaces.size();) {
+        size_t end = i + 1;
+        while (end < edgeFaces.size() && edgeFaces[end].key == edgeFaces[i].key) {
+            ++end;
+        }
+
+        const size_t faceCount = end - i;
+        const glm::vec3& n0 = faceNormals[edgeFaces[i].face];
+        const glm::vec3& n1 = faceNormals[edgeFaces[faceCount > 1 ? i + 1 : i].face];
+        if (Subdivision::isSharpEdge(faceCount, n0, n1, cosThreshold)) {
+            Edge edge;
+            edge.v0 = static_cast<uint32_t>(edgeFaces[i].key >> 32);
+            edge.v1 = static_cast<uint32_t>(edgeFaces[i].key & 0xFFFFFFFFu);
+
+            // Length times bend (1 - cos, up to 2); boundaries count as fully bent
+            float bend = faceCount == 1 ? 2.0f : 1.0f - glm::dot(n0, n1);
+            float length = glm::length(welded.vertices[edge.v1].position - welded.vertices[edge.v0].position);
+            edge.importance = length * bend;
+            edges.push_back(edge);
+        }
+        i = end;
+    }
+    if (edges.empty()) return;
+
+    std::stable_sort(edges.begin(), edges.end(),
+                     [](const Edge& a, const Edge& b) { return a.importance > b.importance; });
+
+    // Compact to the vertices the edges use
+    std::vector<uint32_t> remap(welded.vertices.size(), UINT32_MAX);
+    m_indices.reserve(edges.size() * 2);
+    for (const Edge& edge : edges) {
+        for (uint32_t v : {edge.v0, edge.v1}) {
+            if (remap[v] == UINT32_MAX) {
+                remap[v] = static_cast<uint32_t>(m_positions.size());
+                m_positions.push_back(welded.vertices[v].position);
+            }
+            m_indices.push_back(remap[v]);
+        }
+    }
+
+    for (int level = 0; level < LEVEL_COUNT; ++level) {
+        m_levelCounts[level] = std::max(1u, static_cast<uint32_t>(edges.size() * LEVEL_RATIOS[level]));
+    }
+}
+
+void FeatureEdges::upload() {
+    if (m_vao || m_indices.empty()) return;
+
+    glCreateVertexArrays(1, &m_vao);
+    glCreateBuffers(1, &m_vbo);
+    glCreateBuffers(1, &m_ebo);
+
+    glNamedBufferStorage(m_vbo, m_positions.size() * sizeof(glm::vec3), m_positions.data(), 0);
+    glNamedBufferStorage(m_ebo, m_indices.size() * sizeof(uint32_t), m_indices.data(), 0);
+
+    glVertexArrayVertexBuffer(m_vao, 0, m_vbo, 0, sizeof(glm::vec3));
+    glVertexArrayElementBuffer(m_vao, m_ebo);
+    glEnableVertexArrayAttrib(m_vao, 0);
+    glVertexArrayAttribFormat(m_vao, 0, 3, GL_FLOAT, GL_FALSE, 0);
+    glVertexArrayAttribBinding(m_vao, 0, 0);
+
+    // Only the GPU copy is needed from here on
+    m_positions = {};
+    m_indices = {};
+}
+
+int FeatureEdges::selectLevel(float screenSize, int currentLevel) {
+    return LODSelector::selectLOD(screenSize, std::clamp(currentLevel, 0, LEVEL_COUNT - 1), LEVEL_COUNT);
+}
+
+void FeatureEdges::draw(int level) const {
+    if (!m_vao) return;
+
+    glBindVertexArray(m_vao);
+    glDrawElements(GL_LINES, static_cast<GLsizei>(getEdgeCount(level) * 2), GL_UNSIGNED_INT, nullptr);
+}
+
+uint32_t FeatureEdges::getEdgeCount(int level) const {
+    return m_levelCounts[std::clamp(level, 0, LEVEL_COUNT - 1)];
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "mesh/MeshData.h"
+#include <glad/gl.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+// Boundary and crease edges of a mesh, drawn as lines over shaded geometry.
+// build() runs on a worker thread: it welds the mesh, applies the dihedral
+// test from Subdivision and sorts the edges by importance (boundaries and long,
+// sharp creases first). Each level is a prefix of that order, so a coarser
+// level is just a shorter draw of the same index buffer. upload() must run on
+// the main thread; it frees the CPU copies.
+class FeatureEdges {
+public:
+    static constexpr float DEFAULT_ANGLE = 30.0f;   // Degrees
+    static constexpr int LEVEL_COUNT = 6;
+
+    FeatureEdges() = default;
+    ~FeatureEdges();
+
+    FeatureEdges(const FeatureEdges&) = delete;
+    FeatureEdges& operator=(const FeatureEdges&) = delete;
+
+    // Extract edges whose dihedral angle exceeds angleThreshold (degrees)
+    void build(const MeshData& mesh, float angleThreshold = DEFAULT_ANGLE);
+
+    void upload();
+    bool isUploaded() const { return m_vao != 0; }
+
+    // Level for an object covering screenSize pixels (with hysteresis)
+    static int selectLevel(float screenSize, int currentLevel);
+
+    // Draw the level's edges as GL_LINES (object space positions at location 0)
+    void draw(int level) const;
+
+    uint32_t getEdgeCount(int level = 0) const;
+    bool empty() const { return m_levelCounts[0] == 0; }
+
+private:
+    std::vector<glm::vec3> m_positions;
+    std::vector<uint32_t> m_indices;          // Two per edge, most important first
+    uint32_t m_levelCounts[LEVEL_COUNT]{};    // Edges per level
+
+    GLuint m_vao{0};
+    GLuint m_vbo{0};
+    GLuint m_ebo{0};
+};
@@ -0,0 +1,374 @@
+#include "MeshOptimizer.h"
+#include "MeshletBuilder.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+namespace {
+    // Forsyth scoring parameters (modelled cache size, not the hardware one)
+    constexpr int CACHE_SIZE = 32;
+    constexpr float CACHE_DECAY_POWER = 1.5f;
+    constexpr float LAST_TRI_SCORE = 0.75f;
+    constexpr float VALENCE_BOOST_SCALE = 2.0f;
+    constexpr float VALENCE_BOOST_POWER = 0.5f;
+    constexpr uint32_t MAX_VALENCE_TABLE = 64;
+
+    // FIFO cache simulated when splitting triangles into overdraw clusters
+    constexpr uint32_t OVERDRAW_CACHE_SIZE = 16;
+
+    struct ScoreTables {
+        float cache[CACHE_SIZE];
+        float valence[MAX_VALENCE_TABLE];
+
+        ScoreTables() {
+            for (int i = 0; i < CACHE_SIZE; ++i) {
+                if (i < 3) {
+                    // The last triangle's vertices get a fixed score so the
+                    // algorithm doesn't favour reusing them in one order
+                    cache[i] = LAST_TRI_SCORE;
+                } else {
+                    const float scaler = 1.0f / static_cast<float>(CACHE_SIZE - 3);
+                    cache[i] = std::pow(1.0f - (i - 3) * scaler, CACHE_DECAY_POWER);
+                }
+            }
+            valence[0] = 0.0f;
+            for (uint32_t i = 1; i < MAX_VALENCE_TABLE; ++i) {
+                valence[i] = VALENCE_BOOST_SCALE * std::pow(static_cast<float>(i), -VALENCE_BOOST_POWER);
+            }
+        }
+    };
+
+    float vertexScore(const ScoreTables& tables, int cachePosition, uint32_t liveTriangles) {
+        if (liveTriangles == 0) {
+            return -1.0f;  // No triangles left to emit
+        }
+
+        float score = (cachePosition >= 0) ? tables.cache[cachePosition] : 0.0f;
+        if (liveTriangles < MAX_VALENCE_TABLE) {
+            score += tables.valence[liveTriangles];
+        } else {
+            score += VALENCE_BOOST_SCALE * std::pow(static_cast<float>(liveTriangles), -VALENCE_BOOST_POWER);
+        }
+        return score;
+    }
+}
+
+MeshOptimizer::Mode MeshOptimizer::s_mode = MeshOptimizer::Mode::VertexCache;
+
+MeshOptimizer::Result MeshOptimizer::optimize(MeshData& mesh) {
+    Result result;
+    if (mesh.indices.empty()) {
+        mesh.meshlets.clear();
+        return result;
+    }
+
+    if (s_mode != Mode::Off) {
+        result.acmrBefore = computeACMR(mesh);
+        optimizeVertexCache(mesh);
+        if (s_mode == Mode::Overdraw) {
+            optimizeOverdraw(mesh);
+        }
+        optimizeVertexFetch(mesh);
+        result.acmrAfter = computeACMR(mesh);
+    }
+
+    // Meshlets follow the final triangle order
+    mesh.meshlets = MeshletBuilder::build(mesh);
+    return result;
+}
+
+void MeshOptimizer::optimizeVertexCache(MeshData& mesh) {
+    const size_t numVertices = mesh.vertices.size();
+    const size_t numTriangles = mesh.indices.size() / 3;
+    if (numTriangles == 0) {
+        return;
+    }
+
+    static const ScoreTables tables;
+
+    // Vertex -> triangle adjacency (CSR); the first liveCount[v] entries are unemitted
+    std::vector<uint32_t> liveCount(numVertices, 0);
+    for (uint32_t idx : mesh.indices) {
+        liveCount[idx]++;
+    }
+
+    std::vector<uint32_t> offsets(numVertices + 1, 0);
+    for (size_t v = 0; v < numVertices; ++v) {
+        offsets[v + 1] = offsets[v] + liveCount[v];
+    }
+
+    std::vector<uint32_t> adjacency(mesh.indices.size());
+    {
+        std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+        for (size_t t = 0; t < numTriangles; ++t) {
+            for (int k = 0; k < 3; ++k) {
+                uint32_t v = mesh.indices[t * 3 + k];
+                adjacency[fill[v]++] = static_cast<uint32_t>(t);
+            }
+        }
+    }
+
+    std::vector<int> cachePosition(numVertices, -1);
+    std::vector<float> vScore(numVertices);
+    for (size_t v = 0; v < numVertices; ++v) {
+        vScore[v] = vertexScore(tables, -1, liveCount[v]);
+    }
+
+    std::vector<float> tScore(numTriangles);
+    std::vector<bool> emitted(numTriangles, false);
+    for (size_t t = 0; t < numTriangles; ++t) {
+        tScore[t] = vScore[mesh.indices[t * 3]] +
+                    vScore[mesh.indices[t * 3 + 1]] +
+                    vScore[mesh.indices[t * 3 + 2]];
+    }
+
+    std::vector<uint32_t> output;
+    output.reserve(mesh.indices.size());
+
+    std::vector<uint32_t> cache;
+    std::vector<uint32_t> newCache;
+    cache.reserve(CACHE_SIZE + 3);
+    newCache.reserve(CACHE_SIZE + 3);
+
+    int64_t bestTriangle = std::max_element(tScore.begin(), tScore.end()) - tScore.begin();
+    size_t scanStart = 0;
+
+    for (size_t emittedCount = 0; emittedCount < numTriangles; ++emittedCount) {
+        if (bestTriangle < 0) {
+            // Nothing adjacent to the cache: restart from the next unemitted triangle
+            while (emitted[scanStart]) ++scanStart;
+            bestTriangle = static_cast<int64_t>(scanStart);
+        }
+
+        const size_t t = static_cast<size_t>(bestTriangle);
+        emitted[t] = true;
+
+        const uint32_t tri[3] = {mesh.indices[t * 3], mesh.indices[t * 3 + 1], mesh.indices[t * 3 + 2]};
+        for (uint32_t v : tri) {
+            output.push_back(v);
+
+            // Remove the triangle from the vertex's live list
+            uint32_t begin = offsets[v];
+            uint32_t end = begin + liveCount[v];
+            for (uint32_t a = begin; a < end; ++a) {
+                if (adjacency[a] == t) {
+                    std::swap(adjacency[a], adjacency[end - 1]);
+                    liveCount[v]--;
+                    break;
+                }
+            }
+        }
+
+        // New cache: emitted vertices at the front, then the previous contents
+        newCache.clear();
+        for (uint32_t v : tri) {
+            if (std::find(newCache.begin(), newCache.end(), v) == newCache.end()) {
+                newCache.push_back(v);
+            }
+        }
+        for (uint32_t v : cache) {
+            if (v != tri[0] && v != tri[1] && v != tri[2]) {
+                newCache.push_back(v);
+            }
+        }
+
+        // Rescore vertices in (or just evicted from) the cache
+        for (size_t i = 0; i < newCache.size(); ++i) {
+            uint32_t v = newCache[i];
+            cachePosition[v] = (i < CACHE_SIZE) ? static_cast<int>(i) : -1;
+            vScore[v] = vertexScore(tables, cachePosition[v], liveCount[v]);
+        }
+
+        // Rescore their live triangles and pick the best one for the next step
+        bestTriangle = -1;
+        float bestScore = -std::numeric_limits<float>::max();
+        for (uint32_t v : newCache) {
+            uint32_t begin = offsets[v];
+            uint32_t end = begin + liveCount[v];
+            for (uint32_t a = begin; a < end; ++a) {
+                uint32_t lt = adjacency[a];
+                float score = vScore[mesh.indices[lt * 3]] +
+                              vScore[mesh.indices[lt * 3 + 1]] +
+                              vScore[mesh.indices[lt * 3 + 2]];
+                tScore[lt] = score;
+                if (score > bestScore) {
+                    bestScore = score;
+                    bestTriangle = lt;
+                }
+            }
+        }
+
+        if (newCache.size() > CACHE_SIZE) {
+            newCache.resize(CACHE_SIZE);
+        }
+        cache.swap(newCache);
+    }
+
+    mesh.indices.swap(output);
+}
+
+void MeshOptimizer::optimizeVertexFetch(MeshData& mesh) {
+    const uint32_t unassigned = std::numeric_limits<uint32_t>::max();
+    std::vector<uint32_t> remap(mesh.vertices.size(), unassigned);
+
+    std::vector<Vertex> vertices;
+    vertices.reserve(mesh.vertices.size());
+
+    // Unreferenced vertices are dropped
+    for (uint32_t& idx : mesh.indices) {
+        if (remap[idx] == unassigned) {
+            remap[idx] = static_cast<uint32_t>(vertices.size());
+            vertices.push_back(mesh.vertices[idx]);
+        }
+        idx = remap[idx];
+    }
+
+    mesh.vertices.swap(vertices);
+}
+
+void MeshOptimizer::optimizeOverdraw(MeshData& mesh, float threshold) {
+    const size_t numTriangles = mesh.indices.size() / 3;
+    if (numTriangles < 2) {
+        return;
+    }
+
+    // FIFO cache by timestamps: a vertex is resident if it was inserted
+    // fewer than OVERDRAW_CACHE_SIZE insertions ago; advancing the clock by
+    // more than that empties the cache
+    std::vector<uint32_t> insertedAt(mesh.vertices.size(), 0);
+    uint32_t clock = OVERDRAW_CACHE_SIZE + 1;
+    auto triangleMisses = [&](size_t t) {
+        uint32_t misses = 0;
+        for (int k = 0; k < 3; ++k) {
+            const uint32_t idx = mesh.indices[t * 3 + k];
+            if (clock - insertedAt[idx] > OVERDRAW_CACHE_SIZE) {
+                insertedAt[idx] = clock++;
+                ++misses;
+            }
+        }
+        return misses;
+    };
+    auto resetCache = [&]() { clock += OVERDRAW_CACHE_SIZE + 1; };
+
+    // ========== PHASE 1: Hard boundaries ==========
+    // Where the cache restarts anyway (all three vertices missed)
+    std::vector<uint32_t> hardStarts;
+    for (size_t t = 0; t < numTriangles; ++t) {
+        const uint32_t misses = triangleMisses(t);
+        if (t == 0 || misses == 3) {
+            hardStarts.push_back(static_cast<uint32_t>(t));
+        }
+    }
+    hardStarts.push_back(static_cast<uint32_t>(numTriangles));
+
+    // ========== PHASE 2: Soft boundaries ==========
+    // Each cluster starts with an empty cache; a cluster ends as soon as its
+    // own ACMR is within threshold of its hard cluster's
+    std::vector<uint32_t> clusterStarts;
+    for (size_t h = 0; h + 1 < hardStarts.size(); ++h) {
+        const uint32_t begin = hardStarts[h];
+        const uint32_t end = hardStarts[h + 1];
+
+        resetCache();
+        uint32_t hardMisses = 0;
+        for (uint32_t t = begin; t < end; ++t) {
+            hardMisses += triangleMisses(t);
+        }
+        const float limit = threshold * static_cast<float>(hardMisses) / static_cast<float>(end - begin);
+
+        resetCache();
+        clusterStarts.push_back(begin);
+        uint32_t misses = 0;
+        uint32_t triangles = 0;
+        for (uint32_t t = begin; t + 1 < end; ++t) {
+            misses += triangleMisses(t);
+            ++triangles;
+            if (static_cast<float>(misses) <= limit * static_cast<float>(triangles)) {
+                clusterStarts.push_back(t + 1);
+                resetCache();
+                misses = 0;
+                triangles = 0;
+            }
+        }
+    }
+    clusterStarts.push_back(static_cast<uint32_t>(numTriangles));
+
+    // ========== PHASE 3: Sort clusters outside-in ==========
+    // Clusters facing away from the mesh centre are the likeliest occluders,
+    // so they are drawn first
+    const size_t numClusters = clusterStarts.size() - 1;
+    std::vector<glm::vec3> clusterCentroid(numClusters, glm::vec3(0.0f));
+    std::vector<glm::vec3> clusterNormal(numClusters, glm::vec3(0.0f));
+    glm::vec3 meshCentroid(0.0f);
+    float meshArea = 0.0f;
+
+    for (size_t c = 0; c < numClusters; ++c) {
+        float area = 0.0f;
+        for (uint32_t t = clusterStarts[c]; t < clusterStarts[c + 1]; ++t) {
+            const glm::vec3& p0 = mesh.vertices[mesh.indices[t * 3]].position;
+            const glm::vec3& p1 = mesh.vertices[mesh.indices[t * 3 + 1]].position;
+            const glm::vec3& p2 = mesh.vertices[mesh.indices[t * 3 + 2]].position;
+            const glm::vec3 n = glm::cross(p1 - p0, p2 - p0);
+            const float a = glm::length(n);
+
+            clusterCentroid[c] += (p0 + p1 + p2) * (a / 3.0f);
+            clusterNormal[c] += n;
+            area += a;
+        }
+        meshCentroid += clusterCentroid[c];
+        meshArea += area;
+        if (area > 0.0f) {
+            clusterCentroid[c] /= area;
+        }
+    }
+    if (meshArea > 0.0f) {
+        meshCentroid /= meshArea;
+    }
+
+    std::vector<float> sortKey(numClusters, 0.0f);
+    for (size_t c = 0; c < numClusters; ++c) {
+        const float length = glm::length(clusterNormal[c]);
+        if (length > 0.0f) {
+            sortKey[c] = glm::dot(clusterCentroid[c] - meshCentroid, clusterNormal[c] / length);
+        }
+    }
+
+    std::vector<uint32_t> order(numClusters);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        return sortKey[a] > sortKey[b];
+    });
+
+    std::vector<uint32_t> output;
+    output.reserve(mesh.indices.size());
+    for (uint32_t c : order) {
+        output.insert(output.end(), mesh.indices.begin() + clusterStarts[c] * 3,
+                      mesh.indices.begin() + clusterStarts[c + 1] * 3);
+    }
+    mesh.indices.swap(output);
+}
+
+float MeshOptimizer::computeACMR(const MeshData& mesh, uint32_t cacheSize) {
+    const size_t numTriangles = mesh.indices.size() / 3;
+    if (numTriangles == 0 || cacheSize == 0) {
+        return 0.0f;
+    }
+
+    // FIFO cache: a vertex is resident if fewer than cacheSize misses
+    // happened since it was inserted
+    std::vector<uint32_t> insertedAt(mesh.vertices.size(), 0);
+    std::vector<bool> seen(mesh.vertices.size(), false);
+    uint32_t misses = 0;
+
+    for (uint32_t idx : mesh.indices) {
+        if (!seen[idx] || misses - insertedAt[idx] >= cacheSize) {
+            seen[idx] = true;
+            insertedAt[idx] = misses;
+            ++misses;
+        }
+    }
+
+    return static_cast<float>(misses) / static_cast<float>(numTriangles);
+}
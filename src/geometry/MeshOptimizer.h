@@ -0,0 +1,47 @@
+#pragma once
+
+#include "mesh/MeshData.h"
+
+// Index/vertex reordering for GPU-friendly meshes
+class MeshOptimizer {
+public:
+    // What optimize() does; chosen once at startup, before any mesh is loaded
+    enum class Mode {
+        Off,
+        VertexCache,   // Vertex cache order, then vertex fetch order
+        Overdraw       // As VertexCache, with clusters sorted to reduce overdraw
+    };
+
+    struct Result {
+        float acmrBefore{0.0f};
+        float acmrAfter{0.0f};
+    };
+
+    static void setMode(Mode mode) { s_mode = mode; }
+    static Mode getMode() { return s_mode; }
+
+    // The pass run on every mesh that reaches the GPU (after load, subdivision,
+    // tessellation and for each LOD level), in the current mode, followed by
+    // meshlet generation (in every mode). Returns the ACMR before and after;
+    // zeros when the mode is Off.
+    static Result optimize(MeshData& mesh);
+
+    // Reorder triangles for post-transform vertex cache locality
+    // (Forsyth's linear-speed vertex cache optimization)
+    static void optimizeVertexCache(MeshData& mesh);
+
+    // Reorder vertices by first use so vertex fetches stream through memory
+    static void optimizeVertexFetch(MeshData& mesh);
+
+    // Split a cache-optimized triangle order into clusters (at cache restarts,
+    // and where a cluster's ACMR is within threshold of its hard cluster's)
+    // and draw outward-facing clusters first (Sander et al., "Tipsify")
+    static void optimizeOverdraw(MeshData& mesh, float threshold = 1.05f);
+
+    // Average cache miss ratio: vertex shader invocations per triangle
+    // for a FIFO post-transform cache of the given size (0.5 is ideal, 3.0 is worst)
+    static float computeACMR(const MeshData& mesh, uint32_t cacheSize = 16);
+
+private:
+    static Mode s_mode;
+};
@@ -0,0 +1,300 @@
+#include "MeshSplitter.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+
+namespace {
+    struct PositionHash {
+        size_t operator()(const glm::vec3& p) const {
+            uint32_t bits[3];
+            std::memcpy(bits, &p, sizeof(bits));
+            uint64_t h = 1469598103934665603ull;
+            for (uint32_t b : bits) {
+                h = (h ^ b) * 1099511628211ull;
+            }
+            return static_cast<size_t>(h);
+        }
+    };
+
+    // Lock-free union-find: roots only ever link to smaller indices, and
+    // find() compresses paths with CAS (path halving)
+    uint32_t findRoot(std::vector<std::atomic<uint32_t>>& parent, uint32_t x) {
+        while (true) {
+            uint32_t p = parent[x].load(std::memory_order_relaxed);
+            if (p == x) return x;
+            uint32_t gp = parent[p].load(std::memory_order_relaxed);
+            if (p != gp) {
+                parent[x].compare_exchange_weak(p, gp, std::memory_order_relaxed);
+            }
+            x = gp;
+        }
+    }
+
+    // Spreads the low 10 bits of x to every third bit
+    uint32_t expandBits(uint32_t x) {
+        x = (x | (x << 16)) & 0x030000FFu;
+        x = (x | (x << 8)) & 0x0300F00Fu;
+        x = (x | (x << 4)) & 0x030C30C3u;
+        x = (x | (x << 2)) & 0x09249249u;
+        return x;
+    }
+
+    // 30-bit Morton code of a point normalized to [0, 1]
+    uint32_t mortonCode(const glm::vec3& p) {
+        const glm::vec3 q = glm::clamp(p, 0.0f, 1.0f) * 1023.0f;
+        return (expandBits(static_cast<uint32_t>(q.x)) << 2) |
+               (expandBits(static_cast<uint32_t>(q.y)) << 1) |
+               expandBits(static_cast<uint32_t>(q.z));
+    }
+
+    void unite(std::vector<std::atomic<uint32_t>>& parent, uint32_t a, uint32_t b) {
+        while (true) {
+            a = findRoot(parent, a);
+            b = findRoot(parent, b);
+            if (a == b) return;
+            if (a < b) std::swap(a, b);
+
+            // Link the larger root under the smaller one; retry if a was re-parented meanwhile
+            uint32_t expected = a;
+            if (parent[a].compare_exchange_strong(expected, b, std::memory_order_relaxed)) {
+                return;
+            }
+        }
+    }
+}
+
+std::vector<MeshData> MeshSplitter::splitConnectedComponents(const MeshData& input, size_t maxParts) {
+    const size_t numVertices = input.vertices.size();
+    const size_t numTriangles = input.indices.size() / 3;
+    std::vector<MeshData> parts;
+
+    if (numTriangles == 0 || maxParts == 0) {
+        return parts;
+    }
+
+    // ========== PHASE 1: Canonical vertex per position ==========
+    std::vector<uint32_t> canonical(numVertices);
+    {
+        std::unordered_map<glm::vec3, uint32_t, PositionHash> firstByPosition;
+        firstByPosition.reserve(numVertices);
+        for (size_t v = 0; v < numVertices; ++v) {
+            auto [it, inserted] = firstByPosition.emplace(input.vertices[v].position, static_cast<uint32_t>(v));
+            canonical[v] = it->second;
+        }
+    }
+
+    // ========== PHASE 2: Parallel union of triangle corners ==========
+    std::vector<std::atomic<uint32_t>> parent(numVertices);
+
+    #pragma omp parallel for schedule(static)
+    for (size_t v = 0; v < numVertices; ++v) {
+        parent[v].store(static_cast<uint32_t>(v), std::memory_order_relaxed);
+    }
+
+    #pragma omp parallel for schedule(static)
+    for (size_t t = 0; t < numTriangles; ++t) {
+        uint32_t c0 = canonical[input.indices[t * 3]];
+        uint32_t c1 = canonical[input.indices[t * 3 + 1]];
+        uint32_t c2 = canonical[input.indices[t * 3 + 2]];
+        unite(parent, c0, c1);
+        unite(parent, c1, c2);
+    }
+
+    // ========== PHASE 3: Label triangles by component ==========
+    std::vector<uint32_t> triangleRoot(numTriangles);
+
+    #pragma omp parallel for schedule(static)
+    for (size_t t = 0; t < numTriangles; ++t) {
+        triangleRoot[t] = findRoot(parent, canonical[input.indices[t * 3]]);
+    }
+
+    const uint32_t unassigned = std::numeric_limits<uint32_t>::max();
+    std::vector<uint32_t> rootToComponent(numVertices, unassigned);
+    std::vector<uint32_t> componentTriangles;
+    for (size_t t = 0; t < numTriangles; ++t) {
+        uint32_t& component = rootToComponent[triangleRoot[t]];
+        if (component == unassigned) {
+            component = static_cast<uint32_t>(componentTriangles.size());
+            componentTriangles.push_back(0);
+        }
+        componentTriangles[component]++;
+    }
+
+    const size_t numComponents = componentTriangles.size();
+    if (numComponents == 1) {
+        parts.push_back(input);
+        return parts;
+    }
+
+    // Largest components become parts; the tail is merged into one remainder
+    std::vector<uint32_t> order(numComponents);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        return componentTriangles[a] > componentTriangles[b];
+    });
+
+    const size_t numParts = std::min(numComponents, maxParts);
+    std::vector<uint32_t> componentToPart(numComponents);
+    for (size_t rank = 0; rank < numComponents; ++rank) {
+        componentToPart[order[rank]] = static_cast<uint32_t>(std::min(rank, numParts - 1));
+    }
+
+    // Bucket triangles by part (counting sort keeps original order within a part)
+    std::vector<uint32_t> partOffsets(numParts + 1, 0);
+    std::vector<uint32_t> trianglePart(numTriangles);
+    for (size_t t = 0; t < numTriangles; ++t) {
+        trianglePart[t] = componentToPart[rootToComponent[triangleRoot[t]]];
+        partOffsets[trianglePart[t] + 1]++;
+    }
+    std::partial_sum(partOffsets.begin(), partOffsets.end(), partOffsets.begin());
+
+    std::vector<uint32_t> sortedTriangles(numTriangles);
+    {
+        std::vector<uint32_t> fill(partOffsets.begin(), partOffsets.end() - 1);
+        for (size_t t = 0; t < numTriangles; ++t) {
+            sortedTriangles[fill[trianglePart[t]]++] = static_cast<uint32_t>(t);
+        }
+    }
+
+    // ========== PHASE 4: Build parts in parallel ==========
+    // Every vertex belongs to exactly one part, so the shared remap table
+    // is written without conflicts
+    parts.resize(numParts);
+    std::vector<uint32_t> localIndex(numVertices, unassigned);
+
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (size_t p = 0; p < numParts; ++p) {
+        MeshData& part = parts[p];
+        part.texturePath = input.texturePath;
+
+        const uint32_t begin = partOffsets[p];
+        const uint32_t end = partOffsets[p + 1];
+        part.indices.reserve(static_cast<size_t>(end - begin) * 3);
+
+        for (uint32_t i = begin; i < end; ++i) {
+            const uint32_t t = sortedTriangles[i];
+            for (int k = 0; k < 3; ++k) {
+                const uint32_t v = input.indices[t * 3 + k];
+                if (localIndex[v] == unassigned) {
+                    localIndex[v] = static_cast<uint32_t>(part.vertices.size());
+                    part.vertices.push_back(input.vertices[v]);
+                }
+                part.indices.push_back(localIndex[v]);
+            }
+        }
+
+        part.calculateBounds();
+    }
+
+    return parts;
+}
+
+std::vector<MeshData> MeshSplitter::splitChunks(const MeshData& input, size_t maxVertices) {
+    const size_t numVertices = input.vertices.size();
+    const size_t numTriangles = input.indices.size() / 3;
+    std::vector<MeshData> parts;
+
+    if (numTriangles == 0 || maxVertices < 3) {
+        return parts;
+    }
+    if (numVertices <= maxVertices) {
+        parts.push_back(input);
+        return parts;
+    }
+
+    // ========== PHASE 1: Sort triangles along a Morton curve ==========
+    const glm::vec3 extent = input.maxBounds - input.minBounds;
+    const glm::vec3 invExtent(extent.x > 0.0f ? 1.0f / extent.x : 0.0f,
+                              extent.y > 0.0f ? 1.0f / extent.y : 0.0f,
+                              extent.z > 0.0f ? 1.0f / extent.z : 0.0f);
+
+    std::vector<uint64_t> keys(numTriangles);
+
+    #pragma omp parallel for schedule(static)
+    for (size_t t = 0; t < numTriangles; ++t) {
+        const glm::vec3 centroid = (input.vertices[input.indices[t * 3]].position +
+                                    input.vertices[input.indices[t * 3 + 1]].position +
+                                    input.vertices[input.indices[t * 3 + 2]].position) / 3.0f;
+        // Code in the high bits, triangle index in the low bits
+        keys[t] = (static_cast<uint64_t>(mortonCode((centroid - input.minBounds) * invExtent)) << 32) | t;
+    }
+    std::sort(keys.begin(), keys.end());
+
+    // ========== PHASE 2: Fill chunks up to the vertex limit ==========
+    const uint32_t unassigned = std::numeric_limits<uint32_t>::max();
+    std::vector<uint32_t> vertexChunk(numVertices, unassigned);
+    std::vector<uint32_t> triangleChunk(numTriangles);
+    std::vector<uint32_t> chunkTriangles;
+    uint32_t chunk = 0;
+    size_t chunkVertices = 0;
+
+    for (uint64_t key : keys) {
+        const uint32_t t = static_cast<uint32_t>(key);
+        size_t newVertices = 0;
+        for (int k = 0; k < 3; ++k) {
+            newVertices += vertexChunk[input.indices[t * 3 + k]] != chunk;
+        }
+        if (chunkVertices + newVertices > maxVertices) {
+            ++chunk;
+            chunkVertices = 0;
+            newVertices = 3;
+        }
+        for (int k = 0; k < 3; ++k) {
+            vertexChunk[input.indices[t * 3 + k]] = chunk;
+        }
+        chunkVertices += newVertices;
+        triangleChunk[t] = chunk;
+        if (chunk >= chunkTriangles.size()) {
+            chunkTriangles.push_back(0);
+        }
+        chunkTriangles[chunk]++;
+    }
+
+    // ========== PHASE 3: Build chunks in input triangle order ==========
+    // Bucket triangles by chunk (counting sort keeps input order within a chunk)
+    const size_t numChunks = chunkTriangles.size();
+    std::vector<uint32_t> chunkOffsets(numChunks + 1, 0);
+    std::partial_sum(chunkTriangles.begin(), chunkTriangles.end(), chunkOffsets.begin() + 1);
+
+    std::vector<uint32_t> sortedTriangles(numTriangles);
+    {
+        std::vector<uint32_t> fill(chunkOffsets.begin(), chunkOffsets.end() - 1);
+        for (size_t t = 0; t < numTriangles; ++t) {
+            sortedTriangles[fill[triangleChunk[t]]++] = static_cast<uint32_t>(t);
+        }
+    }
+
+    // Border vertices belong to several chunks, so each chunk remaps on its own
+    parts.resize(numChunks);
+    std::vector<uint32_t> localIndex(numVertices, unassigned);
+    std::fill(vertexChunk.begin(), vertexChunk.end(), unassigned);
+
+    for (uint32_t c = 0; c < numChunks; ++c) {
+        MeshData& part = parts[c];
+        part.texturePath = input.texturePath;
+        part.indices.reserve(static_cast<size_t>(chunkTriangles[c]) * 3);
+
+        for (uint32_t i = chunkOffsets[c]; i < chunkOffsets[c + 1]; ++i) {
+            const uint32_t t = sortedTriangles[i];
+            for (int k = 0; k < 3; ++k) {
+                const uint32_t v = input.indices[t * 3 + k];
+                if (vertexChunk[v] != c) {
+                    vertexChunk[v] = c;
+                    localIndex[v] = static_cast<uint32_t>(part.vertices.size());
+                    part.vertices.push_back(input.vertices[v]);
+                }
+                part.indices.push_back(localIndex[v]);
+            }
+        }
+    }
+
+    #pragma omp parallel for schedule(static)
+    for (size_t c = 0; c < numChunks; ++c) {
+        parts[c].calculateBounds();
+    }
+
+    return parts;
+}
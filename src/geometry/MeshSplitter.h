@@ -0,0 +1,24 @@
+#pragma once
+
+#include "mesh/MeshData.h"
+#include "mesh/VertexFormat.h"
+#include <vector>
+
+// Splits a mesh into independent parts so they can be culled and LOD'd separately
+class MeshSplitter {
+public:
+    // Split into connected components. Triangles are connected if they share a
+    // vertex position, so split normals/UV seams do not break a part apart.
+    // Parts are returned largest first; if there are more than maxParts, the
+    // smallest ones are merged into a single remainder part.
+    static std::vector<MeshData> splitConnectedComponents(const MeshData& input,
+                                                          size_t maxParts = 1024);
+
+    // Split into spatially compact chunks of at most maxVertices vertices, so
+    // every chunk gets 16-bit indices and its own bounds. Triangles are taken
+    // in Morton order of their centroids; vertices on chunk borders are
+    // duplicated. Within a chunk the input triangle order is kept. A mesh
+    // that already fits is returned as the only part.
+    static std::vector<MeshData> splitChunks(const MeshData& input,
+                                             size_t maxVertices = VertexFormat::MAX_SHORT_INDEX_VERTICES);
+};
@@ -0,0 +1,147 @@
+#include "MeshletBuilder.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+    // Cones wider than this (minimum dot of a triangle normal with the axis)
+    // would hardly ever cull, so such meshlets get none
+    constexpr float MIN_CONE_DOT = 0.1f;
+
+    // Unit face normal; false for degenerate triangles, which produce no fragments
+    bool faceNormal(const glm::vec3& p0, const glm::vec3& p1, const glm::vec3& p2, glm::vec3& normal) {
+        const glm::vec3 n = glm::cross(p1 - p0, p2 - p0);
+        const float length = glm::length(n);
+        if (length <= 0.0f || !std::isfinite(length)) {
+            return false;
+        }
+        normal = n / length;
+        return true;
+    }
+}
+
+std::vector<Meshlet> MeshletBuilder::build(const MeshData& mesh, uint32_t maxVertices, uint32_t maxTriangles) {
+    std::vector<Meshlet> meshlets;
+    const size_t triangleCount = mesh.indices.size() / 3;
+    if (triangleCount == 0 || maxVertices < 3 || maxTriangles == 0) {
+        return meshlets;
+    }
+
+    // stamp[v] == meshlet number + 1 while v is in the current meshlet
+    std::vector<uint32_t> stamp(mesh.vertices.size(), 0);
+    uint32_t current = 1;
+
+    Meshlet meshlet;
+    auto finish = [&]() {
+        computeBounds(mesh.vertices.data(), mesh.indices.data(), meshlet);
+        meshlets.push_back(meshlet);
+        meshlet = Meshlet{};
+        meshlet.firstIndex = meshlets.back().firstIndex + meshlets.back().indexCount;
+        ++current;
+    };
+
+    meshlets.reserve(triangleCount / (maxTriangles / 2 + 1) + 1);
+    for (size_t t = 0; t < triangleCount; ++t) {
+        const uint32_t* tri = &mesh.indices[t * 3];
+
+        uint32_t newVertices = 0;
+        for (int k = 0; k < 3; ++k) {
+            // Repeated corners of a degenerate triangle count once
+            const bool repeated = (k > 0 && tri[k] == tri[0]) || (k > 1 && tri[k] == tri[1]);
+            if (stamp[tri[k]] != current && !repeated) {
+                ++newVertices;
+            }
+        }
+
+        if (meshlet.indexCount / 3 == maxTriangles || meshlet.vertexCount + newVertices > maxVertices) {
+            finish();
+            newVertices = 0;
+            for (int k = 0; k < 3; ++k) {
+                const bool repeated = (k > 0 && tri[k] == tri[0]) || (k > 1 && tri[k] == tri[1]);
+                newVertices += repeated ? 0 : 1;
+            }
+        }
+
+        for (int k = 0; k < 3; ++k) {
+            stamp[tri[k]] = current;
+        }
+        meshlet.vertexCount += newVertices;
+        meshlet.indexCount += 3;
+    }
+    finish();
+
+    return meshlets;
+}
+
+void MeshletBuilder::computeBounds(const Vertex* vertices, const uint32_t* indices, Meshlet& meshlet) {
+    const uint32_t* first = indices + meshlet.firstIndex;
+    const uint32_t* last = first + meshlet.indexCount;
+
+    // Sphere around the box centre: not minimal, but tight for the compact
+    // patches a cache-ordered mesh splits into
+    glm::vec3 minBounds(std::numeric_limits<float>::max());
+    glm::vec3 maxBounds(std::numeric_limits<float>::lowest());
+    for (const uint32_t* i = first; i != last; ++i) {
+        minBounds = glm::min(minBounds, vertices[*i].position);
+        maxBounds = glm::max(maxBounds, vertices[*i].position);
+    }
+    meshlet.center = (minBounds + maxBounds) * 0.5f;
+    meshlet.radius = 0.0f;
+    for (const uint32_t* i = first; i != last; ++i) {
+        meshlet.radius = std::max(meshlet.radius, glm::length(vertices[*i].position - meshlet.center));
+    }
+
+    // Cone axis: average of the unit face normals
+    meshlet.coneApex = meshlet.center;
+    meshlet.coneAxis = glm::vec3(0.0f);
+    meshlet.coneCutoff = 1.0f;
+
+    glm::vec3 axis(0.0f);
+    for (const uint32_t* tri = first; tri != last; tri += 3) {
+        glm::vec3 normal;
+        if (faceNormal(vertices[tri[0]].position, vertices[tri[1]].position, vertices[tri[2]].position, normal)) {
+            axis += normal;
+        }
+    }
+    const float axisLength = glm::length(axis);
+    if (axisLength <= 0.0f) {
+        return;
+    }
+    axis /= axisLength;
+    meshlet.coneAxis = axis;
+
+    // Widest normal sets the cutoff; the apex is moved back along the axis
+    // until every triangle's plane is in front of it (as meshoptimizer does),
+    // which keeps the test conservative for viewers close to the meshlet
+    float minDot = 1.0f;
+    float maxOffset = 0.0f;
+    for (const uint32_t* tri = first; tri != last; tri += 3) {
+        glm::vec3 normal;
+        const glm::vec3& p0 = vertices[tri[0]].position;
+        if (!faceNormal(p0, vertices[tri[1]].position, vertices[tri[2]].position, normal)) {
+            continue;
+        }
+        const float dn = glm::dot(axis, normal);
+        minDot = std::min(minDot, dn);
+        if (dn > MIN_CONE_DOT) {
+            maxOffset = std::max(maxOffset, glm::dot(meshlet.center - p0, normal) / dn);
+        }
+    }
+    if (minDot <= MIN_CONE_DOT) {
+        return;
+    }
+
+    meshlet.coneApex = meshlet.center - axis * maxOffset;
+    meshlet.coneCutoff = std::sqrt(1.0f - minDot * minDot);
+}
+
+bool MeshletBuilder::covers(const std::vector<Meshlet>& meshlets, size_t indexCount) {
+    size_t next = 0;
+    for (const Meshlet& meshlet : meshlets) {
+        if (meshlet.firstIndex != next || meshlet.indexCount == 0 || meshlet.indexCount % 3 != 0) {
+            return false;
+        }
+        next += meshlet.indexCount;
+    }
+    return !meshlets.empty() && next == indexCount;
+}
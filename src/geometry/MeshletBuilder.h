@@ -0,0 +1,28 @@
+#pragma once
+
+#include "mesh/MeshData.h"
+#include <cstdint>
+#include <vector>
+
+// Splits a mesh into meshlets (clusters of triangles small enough to cull
+// one by one) and computes their bounding spheres and normal cones.
+// Meshlets are consecutive runs of the index buffer: the triangle order is
+// kept, so a cache-optimized mesh stays cache-optimized and each meshlet
+// can be drawn as one index range with the regular vertex pipeline.
+class MeshletBuilder {
+public:
+    static constexpr uint32_t MAX_VERTICES = 64;
+    static constexpr uint32_t MAX_TRIANGLES = 124;
+
+    // Partition the triangles of mesh in order
+    static std::vector<Meshlet> build(const MeshData& mesh,
+                                      uint32_t maxVertices = MAX_VERTICES,
+                                      uint32_t maxTriangles = MAX_TRIANGLES);
+
+    // Bounds of the triangles [firstIndex, firstIndex + indexCount) of a mesh
+    static void computeBounds(const Vertex* vertices, const uint32_t* indices, Meshlet& meshlet);
+
+    // Meshlets partition the index buffer (e.g. they were not left stale by
+    // a later edit of the indices)
+    static bool covers(const std::vector<Meshlet>& meshlets, size_t indexCount);
+};
@@ -199,16 +199,10 @@ MeshData Subdivision::loopSubdivide(const MeshData& input, float creaseAngleThre
         const EdgeKey& edge = uniqueEdges[e];
         const auto& faces = edgeFaces.at(edge);
 
-        if (faces.size() == 1) {
-            // Boundary edge - always sharp
-            edgeIsSharp[e] = true;
-        } else if (faces.size() == 2) {
-            // Compute dihedral angle
-            glm::vec3 n0 = faceNormals[faces[0]];
-            glm::vec3 n1 = faceNormals[faces[1]];
-            float cosAngle = glm::dot(n0, n1);
-            edgeIsSharp[e] = (cosAngle < cosThreshold);
-        }
+        // Boundary edges are always sharp, others by dihedral angle
+        const glm::vec3& n0 = faceNormals[faces[0]];
+        const glm::vec3& n1 = faceNormals[faces.size() > 1 ? faces[1] : faces[0]];
+        edgeIsSharp[e] = isSharpEdge(faces.size(), n0, n1, cosThreshold);
     }
 
     // Build map for fast sharp edge lookup
@@ -706,14 +700,9 @@ MeshData Subdivision::loopSubdivideWithProgress(const MeshData& input, float cre
         const EdgeKey& edge = uniqueEdges[e];
         const auto& faces = edgeFaces.at(edge);
 
-        if (faces.size() == 1) {
-            edgeIsSharp[e] = true;
-        } else if (faces.size() == 2) {
-            glm::vec3 n0 = faceNormals[faces[0]];
-            glm::vec3 n1 = faceNormals[faces[1]];
-            float cosAngle = glm::dot(n0, n1);
-            edgeIsSharp[e] = (cosAngle < cosThreshold);
-        }
+        const glm::vec3& n0 = faceNormals[faces[0]];
+        const glm::vec3& n1 = faceNormals[faces.size() > 1 ? faces[1] : faces[0]];
+        edgeIsSharp[e] = isSharpEdge(faces.size(), n0, n1, cosThreshold);
 
         if (e % 1000 == 0) {
             progress.updatePhaseProgress(static_cast<float>(e) / uniqueEdges.size());
@@ -27,6 +27,16 @@ public:
     // This is needed before subdivision when meshes have split vertices for per-face normals
     static MeshData weldVertices(const MeshData& input, float epsilon = 1e-6f);
 
+    // Dihedral test for crease preservation: a boundary edge (one face) is always
+    // sharp, an edge between two faces with unit normals n0, n1 is sharp if its
+    // dihedral angle exceeds the threshold (cosThreshold = cos(threshold)).
+    // Non-manifold edges are treated as smooth.
+    static bool isSharpEdge(size_t faceCount, const glm::vec3& n0, const glm::vec3& n1,
+                            float cosThreshold) {
+        if (faceCount == 1) return true;
+        return faceCount == 2 && glm::dot(n0, n1) < cosThreshold;
+    }
+
 private:
     // Edge key for hash map (ordered pair of vertex indices)
     struct EdgeKey {
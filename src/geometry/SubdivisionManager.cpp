@@ -1,10 +1,28 @@
 #include "SubdivisionManager.h"
 #include "Subdivision.h"
+#include "MeshOptimizer.h"
 #include "scene/SceneObject.h"
+#include "cache/GeometryCache.h"
+#include "renderer/StagingRing.h"
 #include <iostream>
 
 void SubdivisionManager::processTask(SubdivisionTask& task) {
     try {
+        // Cache hit: reuse a previously subdivided result of the same input
+        if (task.cache && task.cacheKey != 0) {
+            task.resultKey = GeometryCache::deriveKey(task.cacheKey,
+                GeometryCache::subdivisionOperation(task.smooth, task.creaseAngle));
+
+            if (auto entry = task.cache->open(task.resultKey)) {
+                task.resultData = entry->toMeshData(0);
+                if (m_stagingRing) {
+                    task.staged = m_stagingRing->stage(task.resultData, &task.progress);
+                }
+                task.progress.complete();
+                return;
+            }
+        }
+
         if (task.smooth) {
             task.resultData = Subdivision::loopSubdivideWithProgress(
                 task.inputData, task.creaseAngle, task.progress);
@@ -14,6 +32,17 @@ void SubdivisionManager::processTask(SubdivisionTask& task) {
         }
 
         if (!task.progress.isCancelled()) {
+            // Subdivision emits triangles per input face, which reuses few cached vertices
+            const MeshOptimizer::Result optimized = MeshOptimizer::optimize(task.resultData);
+            task.acmrBefore = optimized.acmrBefore;
+            task.acmrAfter = optimized.acmrAfter;
+
+            if (task.cache && task.resultKey != 0) {
+                task.cache->store(task.resultKey, task.resultData);
+            }
+            if (m_stagingRing) {
+                task.staged = m_stagingRing->stage(task.resultData, &task.progress);
+            }
             task.progress.complete();
         }
     } catch (const std::exception& e) {
@@ -24,7 +53,12 @@ void SubdivisionManager::processTask(SubdivisionTask& task) {
 
 bool SubdivisionManager::applyTaskResult(SubdivisionTask& task) {
     if (task.targetObject) {
-        task.targetObject->applySubdividedMesh(std::move(task.resultData));
+        if (task.acmrAfter > 0.0f) {
+            std::cout << "[" << task.objectName << "] Vertex cache ACMR " << task.acmrBefore
+                      << " -> " << task.acmrAfter << std::endl;
+        }
+        task.targetObject->applySubdividedMesh(std::move(task.resultData), std::move(task.staged));
+        task.targetObject->setCacheKey(task.resultKey);
         return true;
     }
     return false;
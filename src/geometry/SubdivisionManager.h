@@ -3,15 +3,24 @@
 #include "async/TaskManager.h"
 #include "async/SubdivisionTask.h"
 
+class StagingRing;
+
 class SubdivisionManager : public TaskManager<SubdivisionTask> {
 public:
     SubdivisionManager() = default;
     ~SubdivisionManager() override { shutdown(); }
 
+    // Workers copy results into the ring for budgeted upload. Set before
+    // submitting tasks; the ring must outlive this manager.
+    void setStagingRing(StagingRing* ring) { m_stagingRing = ring; }
+
 protected:
     // Process a subdivision task (runs on worker thread)
     void processTask(SubdivisionTask& task) override;
 
     // Apply completed task result to scene object (runs on main thread)
     bool applyTaskResult(SubdivisionTask& task) override;
+
+private:
+    StagingRing* m_stagingRing{nullptr};
 };
@@ -0,0 +1,326 @@
+#include "TriangleBVH.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    constexpr uint32_t MAX_LEAF_TRIANGLES = 4;
+    constexpr int SAH_BINS = 12;
+    constexpr uint32_t MAX_DEPTH = 64;  // Also bounds the traversal stack
+
+    // Relative cost of a node visit versus a triangle test
+    constexpr float TRAVERSAL_COST = 1.0f;
+
+    float surfaceArea(const glm::vec3& boundsMin, const glm::vec3& boundsMax) {
+        glm::vec3 size = boundsMax - boundsMin;
+        return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+    }
+}
+
+void TriangleBVH::build(const MeshData& mesh) {
+    m_nodes.clear();
+    m_vertices.clear();
+    m_triangleIds.clear();
+
+    const uint32_t triangleCount = static_cast<uint32_t>(mesh.indices.size() / 3);
+    if (triangleCount == 0) {
+        return;
+    }
+
+    std::vector<BuildTriangle> triangles;
+    triangles.reserve(triangleCount);
+    for (uint32_t i = 0; i < triangleCount; ++i) {
+        const glm::vec3& a = mesh.vertices[mesh.indices[i * 3 + 0]].position;
+        const glm::vec3& b = mesh.vertices[mesh.indices[i * 3 + 1]].position;
+        const glm::vec3& c = mesh.vertices[mesh.indices[i * 3 + 2]].position;
+
+        BuildTriangle triangle;
+        triangle.boundsMin = glm::min(a, glm::min(b, c));
+        triangle.boundsMax = glm::max(a, glm::max(b, c));
+        triangle.centroid = (a + b + c) / 3.0f;
+        triangle.id = i;
+        triangles.push_back(triangle);
+    }
+
+    // A binary tree with at least one triangle per leaf has < 2n nodes
+    m_nodes.reserve(static_cast<size_t>(triangleCount) * 2);
+    Node root;
+    root.first = 0;
+    root.count = triangleCount;
+    m_nodes.push_back(root);
+    subdivide(triangles);
+    m_nodes.shrink_to_fit();
+
+    // Copy vertices in leaf order
+    m_triangleIds.resize(triangleCount);
+    m_vertices.resize(static_cast<size_t>(triangleCount) * 3);
+    for (uint32_t i = 0; i < triangleCount; ++i) {
+        const uint32_t id = triangles[i].id;
+        m_triangleIds[i] = id;
+        for (int k = 0; k < 3; ++k) {
+            m_vertices[i * 3 + k] = mesh.vertices[mesh.indices[id * 3 + k]].position;
+        }
+    }
+}
+
+void TriangleBVH::subdivide(std::vector<BuildTriangle>& triangles) {
+    // Iterative to keep deep trees off the call stack; (node, depth) pairs
+    std::vector<std::pair<uint32_t, uint32_t>> pending{{0, 0}};
+
+    while (!pending.empty()) {
+        const uint32_t index = pending.back().first;
+        const uint32_t depth = pending.back().second;
+        pending.pop_back();
+
+        const uint32_t first = m_nodes[index].first;
+        const uint32_t count = m_nodes[index].count;
+
+        glm::vec3 boundsMin(std::numeric_limits<float>::max());
+        glm::vec3 boundsMax(std::numeric_limits<float>::lowest());
+        glm::vec3 centroidMin(std::numeric_limits<float>::max());
+        glm::vec3 centroidMax(std::numeric_limits<float>::lowest());
+        for (uint32_t i = first; i < first + count; ++i) {
+            boundsMin = glm::min(boundsMin, triangles[i].boundsMin);
+            boundsMax = glm::max(boundsMax, triangles[i].boundsMax);
+            centroidMin = glm::min(centroidMin, triangles[i].centroid);
+            centroidMax = glm::max(centroidMax, triangles[i].centroid);
+        }
+        m_nodes[index].boundsMin = boundsMin;
+        m_nodes[index].boundsMax = boundsMax;
+
+        if (count <= MAX_LEAF_TRIANGLES || depth + 1 >= MAX_DEPTH) {
+            continue;
+        }
+
+        // Binned SAH: evaluate SAH_BINS - 1 split planes on each axis
+        int bestAxis = -1;
+        int bestSplit = 0;
+        float bestCost = static_cast<float>(count);  // Cost of keeping a leaf (relative units)
+        const float parentArea = surfaceArea(boundsMin, boundsMax);
+
+        for (int axis = 0; axis < 3; ++axis) {
+            const float extent = centroidMax[axis] - centroidMin[axis];
+            if (extent <= 0.0f) {
+                continue;
+            }
+
+            struct Bin {
+                glm::vec3 boundsMin{std::numeric_limits<float>::max()};
+                glm::vec3 boundsMax{std::numeric_limits<float>::lowest()};
+                uint32_t count{0};
+            };
+            Bin bins[SAH_BINS];
+
+            const float scale = SAH_BINS / extent;
+            for (uint32_t i = first; i < first + count; ++i) {
+                int bin = static_cast<int>((triangles[i].centroid[axis] - centroidMin[axis]) * scale);
+                bin = std::min(bin, SAH_BINS - 1);
+                bins[bin].boundsMin = glm::min(bins[bin].boundsMin, triangles[i].boundsMin);
+                bins[bin].boundsMax = glm::max(bins[bin].boundsMax, triangles[i].boundsMax);
+                ++bins[bin].count;
+            }
+
+            // Sweep from the right to get the cost of every split
+            float rightArea[SAH_BINS];
+            uint32_t rightCount[SAH_BINS];
+            glm::vec3 sweepMin(std::numeric_limits<float>::max());
+            glm::vec3 sweepMax(std::numeric_limits<float>::lowest());
+            uint32_t sweepCount = 0;
+            for (int b = SAH_BINS - 1; b > 0; --b) {
+                sweepMin = glm::min(sweepMin, bins[b].boundsMin);
+                sweepMax = glm::max(sweepMax, bins[b].boundsMax);
+                sweepCount += bins[b].count;
+                rightArea[b] = sweepCount ? surfaceArea(sweepMin, sweepMax) : 0.0f;
+                rightCount[b] = sweepCount;
+            }
+
+            sweepMin = glm::vec3(std::numeric_limits<float>::max());
+            sweepMax = glm::vec3(std::numeric_limits<float>::lowest());
+            sweepCount = 0;
+            for (int b = 0; b < SAH_BINS - 1; ++b) {
+                sweepMin = glm::min(sweepMin, bins[b].boundsMin);
+                sweepMax = glm::max(sweepMax, bins[b].boundsMax);
+                sweepCount += bins[b].count;
+                if (sweepCount == 0 || rightCount[b + 1] == 0) {
+                    continue;
+                }
+
+                const float cost = TRAVERSAL_COST +
+                    (surfaceArea(sweepMin, sweepMax) * sweepCount + rightArea[b + 1] * rightCount[b + 1]) / parentArea;
+                if (cost < bestCost) {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestSplit = b + 1;
+                }
+            }
+        }
+
+        // Splitting does not pay off (or all centroids coincide): keep a leaf
+        if (bestAxis < 0) {
+            continue;
+        }
+
+        const float splitScale = SAH_BINS / (centroidMax[bestAxis] - centroidMin[bestAxis]);
+        const float splitMin = centroidMin[bestAxis];
+        auto middle = std::partition(triangles.begin() + first, triangles.begin() + first + count,
+                                     [=](const BuildTriangle& triangle) {
+                                         int bin = static_cast<int>((triangle.centroid[bestAxis] - splitMin) * splitScale);
+                                         return std::min(bin, SAH_BINS - 1) < bestSplit;
+                                     });
+        const uint32_t leftCount = static_cast<uint32_t>(middle - (triangles.begin() + first));
+        if (leftCount == 0 || leftCount == count) {
+            continue;
+        }
+
+        const uint32_t leftIndex = static_cast<uint32_t>(m_nodes.size());
+        Node left;
+        left.first = first;
+        left.count = leftCount;
+        Node right;
+        right.first = first + leftCount;
+        right.count = count - leftCount;
+        m_nodes.push_back(left);
+        m_nodes.push_back(right);
+
+        m_nodes[index].first = leftIndex;
+        m_nodes[index].count = 0;
+        pending.push_back({leftIndex, depth + 1});
+        pending.push_back({leftIndex + 1, depth + 1});
+    }
+}
+
+bool TriangleBVH::intersect(const Ray& ray, RayHit& hit) const {
+    if (m_nodes.empty()) {
+        return false;
+    }
+
+    const glm::vec3 invDirection = 1.0f / ray.direction;
+    float entry = 0.0f;
+    if (!intersectBounds(m_nodes[0], ray.origin, invDirection, hit.distance, entry)) {
+        return false;
+    }
+
+    // Deferred far children with their entry distance
+    struct Entry {
+        uint32_t node;
+        float distance;
+    };
+    Entry stack[MAX_DEPTH];
+    int stackSize = 0;
+    uint32_t nodeIndex = 0;
+    bool found = false;
+
+    while (true) {
+        const Node& node = m_nodes[nodeIndex];
+
+        if (node.count > 0) {
+            for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+                float t, u, v;
+                if (intersectTriangle(ray, m_vertices[i * 3], m_vertices[i * 3 + 1], m_vertices[i * 3 + 2], t, u, v) &&
+                    t < hit.distance) {
+                    hit.distance = t;
+                    hit.triangle = static_cast<int>(m_triangleIds[i]);
+                    hit.barycentric = glm::vec3(1.0f - u - v, u, v);
+                    found = true;
+                }
+            }
+        } else {
+            // Visit the nearer child first, defer the other
+            uint32_t nearChild = node.first;
+            uint32_t farChild = node.first + 1;
+            float nearEntry = 0.0f;
+            float farEntry = 0.0f;
+            bool nearHit = intersectBounds(m_nodes[nearChild], ray.origin, invDirection, hit.distance, nearEntry);
+            bool farHit = intersectBounds(m_nodes[farChild], ray.origin, invDirection, hit.distance, farEntry);
+            if (nearHit && farHit) {
+                if (farEntry < nearEntry) {
+                    std::swap(nearChild, farChild);
+                    std::swap(nearEntry, farEntry);
+                }
+                stack[stackSize++] = Entry{farChild, farEntry};
+                nodeIndex = nearChild;
+                continue;
+            }
+            if (nearHit || farHit) {
+                nodeIndex = nearHit ? nearChild : farChild;
+                continue;
+            }
+        }
+
+        // Next deferred node that can still beat the closest hit
+        while (stackSize > 0 && stack[stackSize - 1].distance > hit.distance) {
+            --stackSize;
+        }
+        if (stackSize == 0) {
+            break;
+        }
+        nodeIndex = stack[--stackSize].node;
+    }
+
+    return found;
+}
+
+bool TriangleBVH::intersectBounds(const Node& node, const glm::vec3& origin, const glm::vec3& invDirection,
+                                  float maxDistance, float& entry) {
+    // Slab test
+    const glm::vec3 t0 = (node.boundsMin - origin) * invDirection;
+    const glm::vec3 t1 = (node.boundsMax - origin) * invDirection;
+    const glm::vec3 tNear = glm::min(t0, t1);
+    const glm::vec3 tFar = glm::max(t0, t1);
+
+    entry = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, 0.0f));
+    const float exit = std::min(std::min(tFar.x, tFar.y), std::min(tFar.z, maxDistance));
+    return entry <= exit;
+}
+
+bool TriangleBVH::intersectMesh(const MeshData& mesh, const Ray& ray, RayHit& hit) {
+    bool found = false;
+    const size_t triangleCount = mesh.indices.size() / 3;
+    for (size_t i = 0; i < triangleCount; ++i) {
+        float t, u, v;
+        if (intersectTriangle(ray, mesh.vertices[mesh.indices[i * 3]].position,
+                              mesh.vertices[mesh.indices[i * 3 + 1]].position,
+                              mesh.vertices[mesh.indices[i * 3 + 2]].position, t, u, v) &&
+            t < hit.distance) {
+            hit.distance = t;
+            hit.triangle = static_cast<int>(i);
+            hit.barycentric = glm::vec3(1.0f - u - v, u, v);
+            found = true;
+        }
+    }
+    return found;
+}
+
+bool TriangleBVH::intersectTriangle(const Ray& ray, const glm::vec3& v0, const glm::vec3& v1,
+                                    const glm::vec3& v2, float& t, float& u, float& v) {
+    const glm::vec3 edge1 = v1 - v0;
+    const glm::vec3 edge2 = v2 - v0;
+    const glm::vec3 p = glm::cross(ray.direction, edge2);
+    const float determinant = glm::dot(edge1, p);
+
+    // Parallel to the triangle plane (both faces count as hits)
+    if (std::fabs(determinant) < 1e-12f) {
+        return false;
+    }
+
+    const float invDeterminant = 1.0f / determinant;
+    const glm::vec3 s = ray.origin - v0;
+    u = glm::dot(s, p) * invDeterminant;
+    if (u < 0.0f || u > 1.0f) {
+        return false;
+    }
+
+    const glm::vec3 q = glm::cross(s, edge1);
+    v = glm::dot(ray.direction, q) * invDeterminant;
+    if (v < 0.0f || u + v > 1.0f) {
+        return false;
+    }
+
+    t = glm::dot(edge2, q) * invDeterminant;
+    return t > 0.0f;
+}
+
+size_t TriangleBVH::getMemoryBytes() const {
+    return m_nodes.size() * sizeof(Node) +
+           m_vertices.size() * sizeof(glm::vec3) +
+           m_triangleIds.size() * sizeof(uint32_t);
+}
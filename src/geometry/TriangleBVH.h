@@ -0,0 +1,60 @@
+#pragma once
+
+#include "mesh/MeshData.h"
+#include "scene/Ray.h"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+// Bounding volume hierarchy over the triangles of one mesh, for CPU ray casts.
+// Built with binned SAH splits; triangle vertices are copied in leaf order so
+// a traversal touches only the node array and one contiguous vertex block.
+// Immutable after build, so it can be built on a worker thread and then
+// shared with the main thread.
+class TriangleBVH {
+public:
+    TriangleBVH() = default;
+
+    // Build over the mesh's indexed triangles (object space)
+    void build(const MeshData& mesh);
+
+    // Closest hit with t < hit.distance. On success fills distance, triangle
+    // (index into the mesh's triangle list) and barycentric; returns true.
+    bool intersect(const Ray& ray, RayHit& hit) const;
+
+    // Same query without an acceleration structure (for meshes whose BVH is not built yet)
+    static bool intersectMesh(const MeshData& mesh, const Ray& ray, RayHit& hit);
+
+    // Moller-Trumbore; u and v are the weights of vertices 1 and 2
+    static bool intersectTriangle(const Ray& ray, const glm::vec3& v0, const glm::vec3& v1,
+                                  const glm::vec3& v2, float& t, float& u, float& v);
+
+    bool empty() const { return m_nodes.empty(); }
+    size_t getTriangleCount() const { return m_triangleIds.size(); }
+    size_t getNodeCount() const { return m_nodes.size(); }
+    size_t getMemoryBytes() const;
+
+private:
+    // 32 bytes; inner nodes have count == 0 and their children at first, first + 1
+    struct Node {
+        glm::vec3 boundsMin;
+        uint32_t first;   // Inner: left child index; leaf: first triangle
+        glm::vec3 boundsMax;
+        uint32_t count;   // Triangles in the leaf (0 for inner nodes)
+    };
+
+    struct BuildTriangle {
+        glm::vec3 boundsMin;
+        glm::vec3 boundsMax;
+        glm::vec3 centroid;
+        uint32_t id;
+    };
+
+    void subdivide(std::vector<BuildTriangle>& triangles);
+    static bool intersectBounds(const Node& node, const glm::vec3& origin, const glm::vec3& invDirection,
+                                float maxDistance, float& entry);
+
+    std::vector<Node> m_nodes;
+    std::vector<glm::vec3> m_vertices;     // Three per triangle, in leaf order
+    std::vector<uint32_t> m_triangleIds;   // Original triangle index, in leaf order
+};
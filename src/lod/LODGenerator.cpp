@@ -0,0 +1,61 @@
+#include "LODGenerator.h"
+#include "LODSelector.h"
+#include "async/LODTask.h"
+#include "geometry/MeshOptimizer.h"
+
+namespace {
+    struct LODStep {
+        float ratio;
+        float threshold;
+    };
+
+    // LOD 1..5 (LOD 0 is the input itself)
+    constexpr LODStep LOD_STEPS[] = {
+        {LODSelector::LOD1_RATIO, LODSelector::LOD1_THRESHOLD},
+        {LODSelector::LOD2_RATIO, LODSelector::LOD2_THRESHOLD},
+        {LODSelector::LOD3_RATIO, LODSelector::LOD3_THRESHOLD},
+        {LODSelector::LOD4_RATIO, LODSelector::LOD4_THRESHOLD},
+        {LODSelector::LOD5_RATIO, LODSelector::LOD5_THRESHOLD},
+    };
+}
+
+bool LODGenerator::generate(const MeshData& input, std::vector<LODLevel>& outLevels,
+                            Progress& progress, SimplificationProgress& simplificationProgress) {
+    uint32_t originalTriangles = static_cast<uint32_t>(input.indices.size() / 3);
+
+    // LOD 0 is the original mesh
+    outLevels.emplace_back(MeshData(input), LODSelector::LOD0_THRESHOLD);
+
+    if (progress.isCancelled()) return false;
+
+    int phase = 1;
+    for (const LODStep& step : LOD_STEPS) {
+        progress.setPhase(phase++);
+        simplificationProgress.reset();
+
+        uint32_t target = static_cast<uint32_t>(originalTriangles * step.ratio);
+        if (target < 4) {
+            continue;
+        }
+
+        MeshData lodData = MeshSimplifier::simplifyWithProgress(input, target, simplificationProgress);
+        if (progress.isCancelled()) return false;
+
+        MeshOptimizer::optimize(lodData);
+
+        outLevels.emplace_back(std::move(lodData), step.threshold);
+    }
+
+    progress.setPhase(phase);
+    return !progress.isCancelled();
+}
+
+std::vector<LODLevel> LODGenerator::generate(const MeshData& input) {
+    Progress progress;
+    progress.totalPhases = LOD_PHASE_COUNT;
+    SimplificationProgress simplificationProgress;
+
+    std::vector<LODLevel> levels;
+    generate(input, levels, progress, simplificationProgress);
+    return levels;
+}
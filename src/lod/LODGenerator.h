@@ -0,0 +1,20 @@
+#pragma once
+
+#include "LODLevel.h"
+#include "MeshSimplifier.h"
+#include "async/Progress.h"
+#include <vector>
+
+// Builds the LOD chain for a mesh (LOD 0 is a copy of the input; the
+// simplified levels are reordered by MeshOptimizer::optimize).
+// Shared by the background LODManager and the headless bake pipeline.
+class LODGenerator {
+public:
+    // Progress-aware version; advances progress phases 1..6
+    // Returns false if cancelled (outLevels then holds the levels built so far)
+    static bool generate(const MeshData& input, std::vector<LODLevel>& outLevels,
+                         Progress& progress, SimplificationProgress& simplificationProgress);
+
+    // Convenience version without progress tracking
+    static std::vector<LODLevel> generate(const MeshData& input);
+};
@@ -20,6 +20,14 @@ struct LODLevel {
     {
     }
 
+    // GPU-only level; CPU data is not retained (e.g. uploaded from the geometry cache)
+    LODLevel(std::shared_ptr<Mesh> mesh, float threshold, uint32_t triangles)
+        : gpuMesh(std::move(mesh))
+        , screenSizeThreshold(threshold)
+        , triangleCount(triangles)
+    {
+    }
+
     // Ensure GPU mesh is uploaded (call from main thread only)
     void ensureGPUMesh() {
         if (!gpuMesh && !meshData.empty()) {
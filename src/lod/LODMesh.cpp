@@ -1,4 +1,5 @@
 #include "LODMesh.h"
+#include <algorithm>
 
 void LODMesh::addLevel(LODLevel&& level) {
     m_levels.push_back(std::move(level));
@@ -6,7 +7,6 @@ void LODMesh::addLevel(LODLevel&& level) {
 
 void LODMesh::setLevels(std::vector<LODLevel>&& levels) {
     m_levels = std::move(levels);
-    m_currentLOD = 0;
 
     // Eagerly upload all LOD levels to GPU to avoid frame stalls on first LOD switch
     for (auto& level : m_levels) {
@@ -16,7 +16,6 @@ void LODMesh::setLevels(std::vector<LODLevel>&& levels) {
 
 void LODMesh::clear() {
     m_levels.clear();
-    m_currentLOD = 0;
     m_forcedLOD = -1;
     m_generating = false;
 }
@@ -35,19 +34,21 @@ const LODLevel* LODMesh::getLevel(size_t index) const {
     return nullptr;
 }
 
-Mesh* LODMesh::selectLOD(float screenSize) {
+Mesh* LODMesh::selectLOD(float screenSize, int& currentLOD) {
     if (m_levels.empty()) {
         return nullptr;
     }
 
+    const int levelCount = static_cast<int>(m_levels.size());
     int lodIndex;
-    if (m_forcedLOD >= 0 && m_forcedLOD < static_cast<int>(m_levels.size())) {
+    if (m_forcedLOD >= 0 && m_forcedLOD < levelCount) {
         lodIndex = m_forcedLOD;
     } else {
-        lodIndex = LODSelector::selectLOD(screenSize, m_currentLOD, static_cast<int>(m_levels.size()));
+        // The chain may have been replaced since the last choice
+        lodIndex = LODSelector::selectLOD(screenSize, std::min(currentLOD, levelCount - 1), levelCount);
     }
 
-    m_currentLOD = lodIndex;
+    currentLOD = lodIndex;
     return m_levels[lodIndex].getMesh();
 }
 
@@ -59,13 +60,6 @@ void LODMesh::clearForcedLOD() {
     m_forcedLOD = -1;
 }
 
-uint32_t LODMesh::getCurrentTriangleCount() const {
-    if (m_currentLOD >= 0 && m_currentLOD < static_cast<int>(m_levels.size())) {
-        return m_levels[m_currentLOD].triangleCount;
-    }
-    return 0;
-}
-
 uint32_t LODMesh::getTotalTriangleCount() const {
     uint32_t total = 0;
     for (const auto& level : m_levels) {
@@ -29,9 +29,11 @@ public:
     LODLevel* getLevel(size_t index);
     const LODLevel* getLevel(size_t index) const;
 
-    // Select appropriate LOD based on screen size
+    // Select appropriate LOD based on screen size. currentLOD is the caller's
+    // previous choice (for hysteresis) and is updated; it is kept outside so
+    // instances sharing the levels choose independently.
     // Returns the mesh to render (or nullptr if no valid LOD)
-    Mesh* selectLOD(float screenSize);
+    Mesh* selectLOD(float screenSize, int& currentLOD);
 
     // Force a specific LOD level (for debugging)
     void forceLOD(int level);
@@ -39,12 +41,6 @@ public:
     // Clear forced LOD (return to automatic selection)
     void clearForcedLOD();
 
-    // Get current LOD index (for debug display)
-    int getCurrentLODIndex() const { return m_currentLOD; }
-
-    // Get current LOD triangle count
-    uint32_t getCurrentTriangleCount() const;
-
     // Get total triangles across all LOD levels (for stats)
     uint32_t getTotalTriangleCount() const;
 
@@ -54,7 +50,6 @@ public:
 
 private:
     std::vector<LODLevel> m_levels;
-    int m_currentLOD{0};
     int m_forcedLOD{-1};  // -1 = automatic selection
     bool m_generating{false};
 };
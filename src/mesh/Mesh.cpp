@@ -1,4 +1,46 @@
 #include "Mesh.h"
+#include "VertexFormat.h"
+#include "geometry/MeshletBuilder.h"
+#include "renderer/StagingRing.h"
+#include <vector>
+
+namespace {
+    // Vertex data in the GPU layout; points at the input if it already matches
+    const void* encodeVertices(const Vertex* vertices, size_t count, const glm::vec3& minBounds,
+                               const glm::vec3& maxBounds, std::vector<uint8_t>& storage) {
+        if (VertexFormat::getLayout() == VertexFormat::Layout::Full) {
+            return vertices;
+        }
+        storage.resize(count * VertexFormat::getStride());
+        VertexFormat::encode(vertices, count, minBounds, maxBounds, storage.data());
+        return storage.data();
+    }
+
+    // Meshlets are only kept if they still partition the uploaded indices
+    std::vector<Meshlet> validMeshlets(const Meshlet* meshlets, size_t meshletCount, size_t indexCount) {
+        std::vector<Meshlet> result(meshlets, meshlets + meshletCount);
+        if (!MeshletBuilder::covers(result, indexCount)) {
+            result.clear();
+        }
+        return result;
+    }
+
+    // Index data narrowed to indexType; points at the input for 32-bit indices
+    const void* encodeIndices(const uint32_t* indices, size_t count, GLenum indexType,
+                              std::vector<uint8_t>& storage) {
+        if (indexType == GL_UNSIGNED_INT) {
+            return indices;
+        }
+        storage.resize(count * VertexFormat::getIndexSize(indexType));
+        VertexFormat::encodeIndices(indices, count, indexType, storage.data());
+        return storage.data();
+    }
+}
+
+uint64_t Mesh::nextVersion() {
+    static std::atomic<uint64_t> counter{0};
+    return ++counter;
+}
 
 Mesh::Mesh() {
     // Both buffer sets start empty
@@ -11,16 +53,20 @@ Mesh::~Mesh() {
 
 Mesh::Mesh(Mesh&& other) noexcept
     : m_buffers{std::move(other.m_buffers[0]), std::move(other.m_buffers[1])}
+    , m_version(other.m_version)
     , m_writeIndex(other.m_writeIndex)
     , m_readIndex(other.m_readIndex)
     , m_vertexCount(other.m_vertexCount)
     , m_indexCount(other.m_indexCount)
     , m_minBounds(other.m_minBounds)
     , m_maxBounds(other.m_maxBounds)
+    , m_meshlets(std::move(other.m_meshlets))
+    , m_pendingStaged(std::move(other.m_pendingStaged))
     , m_pendingMinBounds(other.m_pendingMinBounds)
     , m_pendingMaxBounds(other.m_pendingMaxBounds)
     , m_pendingVertexCount(other.m_pendingVertexCount)
     , m_pendingIndexCount(other.m_pendingIndexCount)
+    , m_pendingMeshlets(std::move(other.m_pendingMeshlets))
 {
     other.m_buffers[0] = BufferSet{};
     other.m_buffers[1] = BufferSet{};
@@ -35,16 +81,20 @@ Mesh& Mesh::operator=(Mesh&& other) noexcept {
 
         m_buffers[0] = std::move(other.m_buffers[0]);
         m_buffers[1] = std::move(other.m_buffers[1]);
+        m_version = other.m_version;
         m_writeIndex = other.m_writeIndex;
         m_readIndex = other.m_readIndex;
         m_vertexCount = other.m_vertexCount;
         m_indexCount = other.m_indexCount;
         m_minBounds = other.m_minBounds;
         m_maxBounds = other.m_maxBounds;
+        m_meshlets = std::move(other.m_meshlets);
+        m_pendingStaged = std::move(other.m_pendingStaged);
         m_pendingMinBounds = other.m_pendingMinBounds;
         m_pendingMaxBounds = other.m_pendingMaxBounds;
         m_pendingVertexCount = other.m_pendingVertexCount;
         m_pendingIndexCount = other.m_pendingIndexCount;
+        m_pendingMeshlets = std::move(other.m_pendingMeshlets);
 
         other.m_buffers[0] = BufferSet{};
         other.m_buffers[1] = BufferSet{};
@@ -72,38 +122,42 @@ void Mesh::cleanupBufferSet(BufferSet& buf) {
         buf.ebo = 0;
     }
     buf.indexCount = 0;
+    buf.indexType = GL_UNSIGNED_INT;
 }
 
 void Mesh::setupVertexAttributes(BufferSet& buf) {
-    glVertexArrayVertexBuffer(buf.vao, 0, buf.vbo, 0, sizeof(Vertex));
+    glVertexArrayVertexBuffer(buf.vao, 0, buf.vbo, 0, static_cast<GLsizei>(getVertexStride()));
     glVertexArrayElementBuffer(buf.vao, buf.ebo);
+    setVertexFormat(buf.vao);
+}
 
-    // Position attribute
-    glEnableVertexArrayAttrib(buf.vao, 0);
-    glVertexArrayAttribFormat(buf.vao, 0, 3, GL_FLOAT, GL_FALSE, offsetof(Vertex, position));
-    glVertexArrayAttribBinding(buf.vao, 0, 0);
-
-    // Normal attribute
-    glEnableVertexArrayAttrib(buf.vao, 1);
-    glVertexArrayAttribFormat(buf.vao, 1, 3, GL_FLOAT, GL_FALSE, offsetof(Vertex, normal));
-    glVertexArrayAttribBinding(buf.vao, 1, 0);
+void Mesh::setVertexFormat(GLuint vao) {
+    VertexFormat::setAttributes(vao);
+}
 
-    // TexCoord attribute
-    glEnableVertexArrayAttrib(buf.vao, 2);
-    glVertexArrayAttribFormat(buf.vao, 2, 2, GL_FLOAT, GL_FALSE, offsetof(Vertex, texCoord));
-    glVertexArrayAttribBinding(buf.vao, 2, 0);
+size_t Mesh::getVertexStride() {
+    return VertexFormat::getStride();
+}
 
-    // Solution value attribute (for Poisson visualization)
-    glEnableVertexArrayAttrib(buf.vao, 3);
-    glVertexArrayAttribFormat(buf.vao, 3, 1, GL_FLOAT, GL_FALSE, offsetof(Vertex, solutionValue));
-    glVertexArrayAttribBinding(buf.vao, 3, 0);
+glm::mat4 Mesh::getPositionTransform() const {
+    return VertexFormat::getPositionTransform(m_minBounds, m_maxBounds);
 }
 
 void Mesh::upload(const MeshData& data) {
+    upload(data.vertices.data(), data.vertices.size(),
+           data.indices.data(), data.indices.size(),
+           data.minBounds, data.maxBounds,
+           data.meshlets.data(), data.meshlets.size());
+}
+
+void Mesh::upload(const Vertex* vertices, size_t vertexCount,
+                  const uint32_t* indices, size_t indexCount,
+                  const glm::vec3& minBounds, const glm::vec3& maxBounds,
+                  const Meshlet* meshlets, size_t meshletCount) {
     // For synchronous upload, we upload to the read buffer directly
     cleanupBufferSet(m_buffers[m_readIndex]);
 
-    if (data.empty()) return;
+    if (vertexCount == 0) return;
 
     BufferSet& buf = m_buffers[m_readIndex];
 
@@ -111,21 +165,26 @@ void Mesh::upload(const MeshData& data) {
     glCreateBuffers(1, &buf.vbo);
     glCreateBuffers(1, &buf.ebo);
 
-    glNamedBufferStorage(buf.vbo, data.vertices.size() * sizeof(Vertex),
-                         data.vertices.data(), 0);
-    glNamedBufferStorage(buf.ebo, data.indices.size() * sizeof(uint32_t),
-                         data.indices.data(), 0);
+    std::vector<uint8_t> encoded;
+    glNamedBufferStorage(buf.vbo, vertexCount * getVertexStride(),
+                         encodeVertices(vertices, vertexCount, minBounds, maxBounds, encoded), 0);
+    buf.indexType = VertexFormat::getIndexType(vertexCount);
+    glNamedBufferStorage(buf.ebo, indexCount * VertexFormat::getIndexSize(buf.indexType),
+                         encodeIndices(indices, indexCount, buf.indexType, encoded), 0);
 
     setupVertexAttributes(buf);
 
-    buf.indexCount = static_cast<uint32_t>(data.indices.size());
-    m_vertexCount = static_cast<uint32_t>(data.vertices.size());
+    buf.indexCount = static_cast<uint32_t>(indexCount);
+    m_vertexCount = static_cast<uint32_t>(vertexCount);
     m_indexCount = buf.indexCount;
-    m_minBounds = data.minBounds;
-    m_maxBounds = data.maxBounds;
+    m_minBounds = minBounds;
+    m_maxBounds = maxBounds;
+    m_meshlets = validMeshlets(meshlets, meshletCount, indexCount);
+    m_version = nextVersion();
 
     // Ensure write index matches read index (no pending upload)
     m_writeIndex = m_readIndex;
+    m_pendingStaged.reset();
 }
 
 void Mesh::uploadAsync(const MeshData& data) {
@@ -135,26 +194,22 @@ void Mesh::uploadAsync(const MeshData& data) {
     int writeIdx = (m_readIndex + 1) % 2;
     BufferSet& buf = m_buffers[writeIdx];
 
-    // If there's a previous pending upload on this buffer, wait briefly for it
-    if (buf.fence) {
-        // Wait up to 5ms — if GPU is still busy, we'll just recreate the buffer
-        glClientWaitSync(buf.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 5000000ULL); // 5ms in nanoseconds
-        glDeleteSync(buf.fence);
-        buf.fence = nullptr;
-    }
-
-    // Clean up old resources
+    // Clean up old resources; the driver keeps them alive for in-flight draws
     cleanupBufferSet(buf);
+    m_pendingStaged.reset();
 
     // Create new buffers
     glCreateVertexArrays(1, &buf.vao);
     glCreateBuffers(1, &buf.vbo);
     glCreateBuffers(1, &buf.ebo);
 
-    glNamedBufferStorage(buf.vbo, data.vertices.size() * sizeof(Vertex),
-                         data.vertices.data(), 0);
-    glNamedBufferStorage(buf.ebo, data.indices.size() * sizeof(uint32_t),
-                         data.indices.data(), 0);
+    std::vector<uint8_t> encoded;
+    glNamedBufferStorage(buf.vbo, data.vertices.size() * getVertexStride(),
+                         encodeVertices(data.vertices.data(), data.vertices.size(),
+                                        data.minBounds, data.maxBounds, encoded), 0);
+    buf.indexType = VertexFormat::getIndexType(data.vertices.size());
+    glNamedBufferStorage(buf.ebo, data.indices.size() * VertexFormat::getIndexSize(buf.indexType),
+                         encodeIndices(data.indices.data(), data.indices.size(), buf.indexType, encoded), 0);
 
     setupVertexAttributes(buf);
 
@@ -168,11 +223,29 @@ void Mesh::uploadAsync(const MeshData& data) {
     m_pendingMaxBounds = data.maxBounds;
     m_pendingVertexCount = static_cast<uint32_t>(data.vertices.size());
     m_pendingIndexCount = buf.indexCount;
+    m_pendingMeshlets = validMeshlets(data.meshlets.data(), data.meshlets.size(), data.indices.size());
 
     // Mark write buffer as pending
     m_writeIndex = writeIdx;
 }
 
+void Mesh::uploadStaged(std::shared_ptr<StagedMesh> staged, const MeshData& data) {
+    if (!staged || data.empty()) return;
+
+    // The buffers arrive with the staged copies; swapBuffers() adopts them
+    int writeIdx = (m_readIndex + 1) % 2;
+    cleanupBufferSet(m_buffers[writeIdx]);
+    m_pendingStaged = std::move(staged);
+
+    m_pendingMinBounds = data.minBounds;
+    m_pendingMaxBounds = data.maxBounds;
+    m_pendingVertexCount = static_cast<uint32_t>(data.vertices.size());
+    m_pendingIndexCount = static_cast<uint32_t>(data.indices.size());
+    m_pendingMeshlets = validMeshlets(data.meshlets.data(), data.meshlets.size(), data.indices.size());
+
+    m_writeIndex = writeIdx;
+}
+
 bool Mesh::swapBuffers() {
     if (m_writeIndex == m_readIndex) {
         // No pending upload
@@ -181,6 +254,28 @@ bool Mesh::swapBuffers() {
 
     BufferSet& buf = m_buffers[m_writeIndex];
 
+    if (m_pendingStaged) {
+        if (!m_pendingStaged->isReady()) {
+            return false;
+        }
+
+        m_pendingStaged->takeBuffers(buf.vbo, buf.ebo);
+        m_pendingStaged.reset();
+        glCreateVertexArrays(1, &buf.vao);
+        setupVertexAttributes(buf);
+        buf.indexCount = m_pendingIndexCount;
+        buf.indexType = VertexFormat::getIndexType(m_pendingVertexCount);
+
+        m_readIndex = m_writeIndex;
+        m_minBounds = m_pendingMinBounds;
+        m_maxBounds = m_pendingMaxBounds;
+        m_vertexCount = m_pendingVertexCount;
+        m_indexCount = m_pendingIndexCount;
+        m_meshlets = std::move(m_pendingMeshlets);
+        m_version = nextVersion();
+        return true;
+    }
+
     // Check if GPU finished uploading
     if (buf.fence) {
         GLenum result = glClientWaitSync(buf.fence, 0, 0);
@@ -194,6 +289,8 @@ bool Mesh::swapBuffers() {
             m_maxBounds = m_pendingMaxBounds;
             m_vertexCount = m_pendingVertexCount;
             m_indexCount = m_pendingIndexCount;
+            m_meshlets = std::move(m_pendingMeshlets);
+            m_version = nextVersion();
 
             return true;
         }
@@ -207,7 +304,14 @@ void Mesh::draw() const {
     if (!buf.vao) return;
 
     glBindVertexArray(buf.vao);
-    glDrawElements(GL_TRIANGLES, buf.indexCount, GL_UNSIGNED_INT, nullptr);
+    glDrawElements(GL_TRIANGLES, buf.indexCount, buf.indexType, nullptr);
+}
+
+void Mesh::drawBound() const {
+    const BufferSet& buf = m_buffers[m_readIndex];
+    if (!buf.vao) return;
+
+    glDrawElements(GL_TRIANGLES, buf.indexCount, buf.indexType, nullptr);
 }
 
 void Mesh::drawWireframe() const {
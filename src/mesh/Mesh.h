@@ -4,6 +4,9 @@
 #include "MeshData.h"
 #include <memory>
 #include <atomic>
+#include <vector>
+
+class StagedMesh;
 
 class Mesh {
 public:
@@ -18,9 +21,19 @@ public:
     // Synchronous upload (blocks until complete) - existing behavior
     void upload(const MeshData& data);
 
+    // Synchronous upload straight from raw arrays (e.g. a memory-mapped cache entry)
+    void upload(const Vertex* vertices, size_t vertexCount,
+                const uint32_t* indices, size_t indexCount,
+                const glm::vec3& minBounds, const glm::vec3& maxBounds,
+                const Meshlet* meshlets = nullptr, size_t meshletCount = 0);
+
     // Asynchronous upload for double-buffering
     void uploadAsync(const MeshData& data);
 
+    // Asynchronous upload of data already transferred through the staging
+    // ring; swaps to its buffers once all copies have completed
+    void uploadStaged(std::shared_ptr<StagedMesh> staged, const MeshData& data);
+
     // Call each frame to swap buffers when GPU upload is complete
     // Returns true if a swap occurred
     bool swapBuffers();
@@ -31,10 +44,38 @@ public:
     void draw() const;
     void drawWireframe() const;
 
+    // Split form of draw() for callers that skip redundant VAO binds:
+    // drawBound() expects getVertexArray() to be bound already
+    GLuint getVertexArray() const { return m_buffers[m_readIndex].vao; }
+    void drawBound() const;
+
     bool isValid() const { return m_buffers[m_readIndex].vao != 0; }
+
+    // Buffers currently used for drawing (e.g. to copy into a shared arena)
+    GLuint getVertexBuffer() const { return m_buffers[m_readIndex].vbo; }
+    GLuint getIndexBuffer() const { return m_buffers[m_readIndex].ebo; }
+
+    // GL_UNSIGNED_SHORT unless the mesh has too many vertices (see VertexFormat)
+    GLenum getIndexType() const { return m_buffers[m_readIndex].indexType; }
+
+    // Changes whenever the drawn contents change (unique across all meshes)
+    uint64_t getVersion() const { return m_version; }
+
+    // Vertex attribute layout for a VAO reading vertices from binding 0, and
+    // the bytes per vertex, in the layout selected in VertexFormat
+    static void setVertexFormat(GLuint vao);
+    static size_t getVertexStride();
+
+    // Object-space transform of the positions stored in the buffers (folded
+    // into the model matrix; identity unless positions are quantized)
+    glm::mat4 getPositionTransform() const;
     uint32_t getVertexCount() const { return m_vertexCount; }
     uint32_t getIndexCount() const { return m_indexCount; }
 
+    // Meshlets of the drawn index buffer (see MeshletBuilder); empty if the
+    // uploaded data had none, or none matching its indices
+    const std::vector<Meshlet>& getMeshlets() const { return m_meshlets; }
+
     const glm::vec3& getMinBounds() const { return m_minBounds; }
     const glm::vec3& getMaxBounds() const { return m_maxBounds; }
     glm::vec3 getCenter() const { return (m_minBounds + m_maxBounds) * 0.5f; }
@@ -48,12 +89,16 @@ private:
         GLuint ebo = 0;
         GLsync fence = nullptr;
         uint32_t indexCount = 0;
+        GLenum indexType = GL_UNSIGNED_INT;
     };
 
     void cleanupBufferSet(BufferSet& buf);
     void setupVertexAttributes(BufferSet& buf);
 
+    static uint64_t nextVersion();
+
     BufferSet m_buffers[2];
+    uint64_t m_version = 0;
     int m_writeIndex = 0;
     int m_readIndex = 0;
 
@@ -61,10 +106,15 @@ private:
     uint32_t m_indexCount = 0;
     glm::vec3 m_minBounds{0.0f};
     glm::vec3 m_maxBounds{0.0f};
+    std::vector<Meshlet> m_meshlets;
+
+    // Staged upload the write buffers are waiting for
+    std::shared_ptr<StagedMesh> m_pendingStaged;
 
     // Pending bounds from async upload
     glm::vec3 m_pendingMinBounds{0.0f};
     glm::vec3 m_pendingMaxBounds{0.0f};
     uint32_t m_pendingVertexCount = 0;
     uint32_t m_pendingIndexCount = 0;
+    std::vector<Meshlet> m_pendingMeshlets;
 };
@@ -11,9 +11,23 @@ struct Vertex {
     float solutionValue{0.0f};  // Poisson solution field value
 };
 
+// A cluster of consecutive triangles in a mesh's index buffer (see
+// MeshletBuilder), with object-space bounds for per-cluster culling
+struct Meshlet {
+    glm::vec3 center{0.0f};     // Bounding sphere
+    float radius{0.0f};
+    glm::vec3 coneApex{0.0f};   // Normal cone: every triangle faces away from a
+    float coneCutoff{1.0f};     // viewer v with dot(normalize(apex - v), axis) >= cutoff;
+    glm::vec3 coneAxis{0.0f};   // a cutoff of 1 or more means no usable cone
+    uint32_t vertexCount{0};
+    uint32_t firstIndex{0};
+    uint32_t indexCount{0};
+};
+
 struct MeshData {
     std::vector<Vertex> vertices;
     std::vector<uint32_t> indices;
+    std::vector<Meshlet> meshlets;   // Partition of indices; empty if not built
     std::string texturePath;
 
     glm::vec3 minBounds{std::numeric_limits<float>::max()};
@@ -40,6 +54,7 @@ struct MeshData {
     void clear() {
         vertices.clear();
         indices.clear();
+        meshlets.clear();
         texturePath.clear();
         minBounds = glm::vec3(std::numeric_limits<float>::max());
         maxBounds = glm::vec3(std::numeric_limits<float>::lowest());
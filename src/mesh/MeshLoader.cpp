@@ -1,5 +1,7 @@
 #include "MeshLoader.h"
 #include "ObjLoader.h"
+#include "PlyLoader.h"
+#include "StlLoader.h"
 #include "multipatch/GismoLoader.h"
 #include <algorithm>
 
@@ -16,6 +18,14 @@ std::unique_ptr<MeshLoader> MeshLoader::createForFile(const std::string& path) {
         return std::make_unique<ObjLoader>();
     }
 
+    if (ext == ".ply") {
+        return std::make_unique<PlyLoader>();
+    }
+
+    if (ext == ".stl") {
+        return std::make_unique<StlLoader>();
+    }
+
     if (ext == ".xml") {
         return std::make_unique<GismoLoader>();
     }
@@ -28,56 +28,47 @@ namespace {
                    a.texCoord == b.texCoord;
         }
     };
-}
 
-bool ObjLoader::load(const std::string& path, MeshData& outData) {
-    outData.clear();
-
-    // Get directory of OBJ file for MTL search
-    std::filesystem::path objPath(path);
-    std::string objDir = objPath.parent_path().string();
-    if (objDir.empty()) {
-        objDir = ".";
-    }
+    using VertexMap = std::unordered_map<Vertex, uint32_t, VertexHash, VertexEqual>;
 
-    tinyobj::ObjReaderConfig reader_config;
-    reader_config.mtl_search_path = objDir;
-    reader_config.triangulate = true;
+    // Parse the OBJ (triangulated) with MTL files resolved next to it
+    bool parseObj(const std::string& path, tinyobj::ObjReader& reader, std::string& objDir) {
+        // Get directory of OBJ file for MTL search
+        std::filesystem::path objPath(path);
+        objDir = objPath.parent_path().string();
+        if (objDir.empty()) {
+            objDir = ".";
+        }
 
-    tinyobj::ObjReader reader;
+        tinyobj::ObjReaderConfig reader_config;
+        reader_config.mtl_search_path = objDir;
+        reader_config.triangulate = true;
 
-    if (!reader.ParseFromFile(path, reader_config)) {
-        if (!reader.Error().empty()) {
-            std::cerr << "ObjLoader error: " << reader.Error() << std::endl;
+        if (!reader.ParseFromFile(path, reader_config)) {
+            if (!reader.Error().empty()) {
+                std::cerr << "ObjLoader error: " << reader.Error() << std::endl;
+            }
+            return false;
         }
-        return false;
-    }
 
-    if (!reader.Warning().empty()) {
-        std::cout << "ObjLoader warning: " << reader.Warning() << std::endl;
+        if (!reader.Warning().empty()) {
+            std::cout << "ObjLoader warning: " << reader.Warning() << std::endl;
+        }
+        return true;
     }
 
-    const auto& attrib = reader.GetAttrib();
-    const auto& shapes = reader.GetShapes();
-    const auto& materials = reader.GetMaterials();
-
-    // Extract diffuse texture from first material with a texture
-    for (const auto& mat : materials) {
-        if (!mat.diffuse_texname.empty()) {
-            // Resolve texture path relative to OBJ directory
-            std::filesystem::path texPath(mat.diffuse_texname);
-            if (texPath.is_relative()) {
-                texPath = std::filesystem::path(objDir) / texPath;
-            }
-            outData.texturePath = texPath.string();
-            std::cout << "Found diffuse texture: " << outData.texturePath << std::endl;
-            break;
+    // Resolve texture path relative to OBJ directory
+    std::string resolveTexturePath(const tinyobj::material_t& mat, const std::string& objDir) {
+        std::filesystem::path texPath(mat.diffuse_texname);
+        if (texPath.is_relative()) {
+            texPath = std::filesystem::path(objDir) / texPath;
         }
+        return texPath.string();
     }
 
-    std::unordered_map<Vertex, uint32_t, VertexHash, VertexEqual> uniqueVertices;
-
-    for (const auto& shape : shapes) {
+    // Append a shape's triangles, sharing identical vertices through uniqueVertices
+    void appendShape(const tinyobj::attrib_t& attrib, const tinyobj::shape_t& shape,
+                     MeshData& outData, VertexMap& uniqueVertices) {
         for (const auto& index : shape.mesh.indices) {
             Vertex vertex{};
 
@@ -113,12 +104,90 @@ bool ObjLoader::load(const std::string& path, MeshData& outData) {
             outData.indices.push_back(it->second);
         }
     }
+}
+
+bool ObjLoader::load(const std::string& path, MeshData& outData) {
+    outData.clear();
+
+    tinyobj::ObjReader reader;
+    std::string objDir;
+    if (!parseObj(path, reader, objDir)) {
+        return false;
+    }
+
+    const auto& attrib = reader.GetAttrib();
+    const auto& shapes = reader.GetShapes();
+    const auto& materials = reader.GetMaterials();
+
+    // Extract diffuse texture from first material with a texture
+    for (const auto& mat : materials) {
+        if (!mat.diffuse_texname.empty()) {
+            outData.texturePath = resolveTexturePath(mat, objDir);
+            std::cout << "Found diffuse texture: " << outData.texturePath << std::endl;
+            break;
+        }
+    }
+
+    VertexMap uniqueVertices;
+    for (const auto& shape : shapes) {
+        appendShape(attrib, shape, outData, uniqueVertices);
+    }
 
     outData.calculateBounds();
 
     return true;
 }
 
+bool ObjLoader::loadShapes(const std::string& path, std::vector<ObjShape>& outShapes) {
+    outShapes.clear();
+
+    tinyobj::ObjReader reader;
+    std::string objDir;
+    if (!parseObj(path, reader, objDir)) {
+        return false;
+    }
+
+    const auto& attrib = reader.GetAttrib();
+    const auto& shapes = reader.GetShapes();
+    const auto& materials = reader.GetMaterials();
+
+    // File-wide fallback texture (same rule as load())
+    std::string defaultTexture;
+    for (const auto& mat : materials) {
+        if (!mat.diffuse_texname.empty()) {
+            defaultTexture = resolveTexturePath(mat, objDir);
+            break;
+        }
+    }
+
+    for (size_t s = 0; s < shapes.size(); ++s) {
+        const auto& shape = shapes[s];
+        if (shape.mesh.indices.empty()) {
+            continue;  // Points/lines only
+        }
+
+        ObjShape part;
+        part.name = shape.name.empty() ? "shape" + std::to_string(s) : shape.name;
+
+        // Use the shape's own material texture when it has one
+        part.data.texturePath = defaultTexture;
+        if (!shape.mesh.material_ids.empty()) {
+            int materialId = shape.mesh.material_ids.front();
+            if (materialId >= 0 && materialId < static_cast<int>(materials.size()) &&
+                !materials[materialId].diffuse_texname.empty()) {
+                part.data.texturePath = resolveTexturePath(materials[materialId], objDir);
+            }
+        }
+
+        VertexMap uniqueVertices;
+        appendShape(attrib, shape, part.data, uniqueVertices);
+        part.data.calculateBounds();
+        outShapes.push_back(std::move(part));
+    }
+
+    return !outShapes.empty();
+}
+
 bool ObjLoader::canLoad(const std::string& extension) const {
     return extension == ".obj" || extension == "obj";
 }
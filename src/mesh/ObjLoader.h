@@ -1,9 +1,20 @@
 #pragma once
 
 #include "MeshLoader.h"
+#include <vector>
+
+// One OBJ shape ("o"/"g" group) loaded as its own mesh
+struct ObjShape {
+    std::string name;
+    MeshData data;
+};
 
 class ObjLoader : public MeshLoader {
 public:
     bool load(const std::string& path, MeshData& outData) override;
+
+    // Load each shape separately instead of merging them into one mesh
+    bool loadShapes(const std::string& path, std::vector<ObjShape>& outShapes);
+
     bool canLoad(const std::string& extension) const override;
 };
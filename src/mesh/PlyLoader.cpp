@@ -0,0 +1,473 @@
+#include "PlyLoader.h"
+#include "util/MappedFile.h"
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+    enum class PlyType {
+        Int8, UInt8, Int16, UInt16, Int32, UInt32, Float32, Float64, Invalid
+    };
+
+    struct PlyProperty {
+        std::string name;
+        PlyType type{PlyType::Invalid};       // Scalar type (non-list)
+        bool isList{false};
+        PlyType countType{PlyType::Invalid};  // List length type
+        PlyType itemType{PlyType::Invalid};   // List item type
+        size_t offset{0};                     // Byte offset within a fixed-size record
+    };
+
+    struct PlyElement {
+        std::string name;
+        size_t count{0};
+        std::vector<PlyProperty> properties;
+        bool fixedSize{true};                 // No list properties
+        size_t stride{0};                     // Record size when fixedSize
+        size_t minStride{0};                  // Smallest possible record (empty lists)
+
+        const PlyProperty* find(const char* propName) const {
+            for (const auto& prop : properties) {
+                if (prop.name == propName) return &prop;
+            }
+            return nullptr;
+        }
+    };
+
+    // count records of at least stride bytes fit in the available bytes;
+    // checked before any count is multiplied or used to size a buffer
+    bool countFits(size_t count, size_t stride, size_t available) {
+        return stride == 0 || count <= available / stride;
+    }
+
+    PlyType parseType(const std::string& name) {
+        if (name == "char" || name == "int8") return PlyType::Int8;
+        if (name == "uchar" || name == "uint8") return PlyType::UInt8;
+        if (name == "short" || name == "int16") return PlyType::Int16;
+        if (name == "ushort" || name == "uint16") return PlyType::UInt16;
+        if (name == "int" || name == "int32") return PlyType::Int32;
+        if (name == "uint" || name == "uint32") return PlyType::UInt32;
+        if (name == "float" || name == "float32") return PlyType::Float32;
+        if (name == "double" || name == "float64") return PlyType::Float64;
+        return PlyType::Invalid;
+    }
+
+    size_t typeSize(PlyType type) {
+        switch (type) {
+            case PlyType::Int8:
+            case PlyType::UInt8:   return 1;
+            case PlyType::Int16:
+            case PlyType::UInt16:  return 2;
+            case PlyType::Int32:
+            case PlyType::UInt32:
+            case PlyType::Float32: return 4;
+            case PlyType::Float64: return 8;
+            default:               return 0;
+        }
+    }
+
+    bool hostIsLittleEndian() {
+        const uint16_t probe = 1;
+        uint8_t firstByte;
+        std::memcpy(&firstByte, &probe, 1);
+        return firstByte == 1;
+    }
+
+    // Copy a scalar out of the mapping, reversing bytes if the file endianness differs
+    template<typename T>
+    inline T loadScalar(const uint8_t* p, bool swap) {
+        T value;
+        if (!swap) {
+            std::memcpy(&value, p, sizeof(T));
+        } else {
+            uint8_t bytes[sizeof(T)];
+            for (size_t i = 0; i < sizeof(T); ++i) {
+                bytes[i] = p[sizeof(T) - 1 - i];
+            }
+            std::memcpy(&value, bytes, sizeof(T));
+        }
+        return value;
+    }
+
+    inline double readNumber(const uint8_t* p, PlyType type, bool swap) {
+        switch (type) {
+            case PlyType::Int8:    return static_cast<double>(static_cast<int8_t>(*p));
+            case PlyType::UInt8:   return static_cast<double>(*p);
+            case PlyType::Int16:   return static_cast<double>(loadScalar<int16_t>(p, swap));
+            case PlyType::UInt16:  return static_cast<double>(loadScalar<uint16_t>(p, swap));
+            case PlyType::Int32:   return static_cast<double>(loadScalar<int32_t>(p, swap));
+            case PlyType::UInt32:  return static_cast<double>(loadScalar<uint32_t>(p, swap));
+            case PlyType::Float32: return static_cast<double>(loadScalar<float>(p, swap));
+            case PlyType::Float64: return loadScalar<double>(p, swap);
+            default:               return 0.0;
+        }
+    }
+
+    inline float readFloat(const uint8_t* p, PlyType type, bool swap) {
+        // Common case: float32 properties, no conversion through double
+        if (type == PlyType::Float32) {
+            return loadScalar<float>(p, swap);
+        }
+        return static_cast<float>(readNumber(p, type, swap));
+    }
+
+    inline int64_t readInteger(const uint8_t* p, PlyType type, bool swap) {
+        switch (type) {
+            case PlyType::Int8:   return static_cast<int8_t>(*p);
+            case PlyType::UInt8:  return *p;
+            case PlyType::Int16:  return loadScalar<int16_t>(p, swap);
+            case PlyType::UInt16: return loadScalar<uint16_t>(p, swap);
+            case PlyType::Int32:  return loadScalar<int32_t>(p, swap);
+            case PlyType::UInt32: return loadScalar<uint32_t>(p, swap);
+            default:              return static_cast<int64_t>(readNumber(p, type, swap));
+        }
+    }
+
+    // Parse the ASCII header; returns offset of the first binary byte or 0 on error
+    size_t parseHeader(const uint8_t* data, size_t size, std::string& format,
+                       std::vector<PlyElement>& elements) {
+        static const char END_HEADER[] = "end_header";
+        const char* text = reinterpret_cast<const char*>(data);
+
+        size_t pos = 0;
+        bool first = true;
+        while (pos < size) {
+            size_t lineEnd = pos;
+            while (lineEnd < size && text[lineEnd] != '\n') ++lineEnd;
+            if (lineEnd >= size) return 0;
+
+            std::string line(text + pos, lineEnd - pos);
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            pos = lineEnd + 1;
+
+            if (first) {
+                if (line != "ply") return 0;
+                first = false;
+                continue;
+            }
+
+            std::istringstream ss(line);
+            std::string keyword;
+            ss >> keyword;
+
+            if (keyword == "format") {
+                ss >> format;
+            } else if (keyword == "element") {
+                PlyElement element;
+                ss >> element.name >> element.count;
+                if (ss.fail() || element.count > UINT32_MAX) return 0;
+                elements.push_back(std::move(element));
+            } else if (keyword == "property") {
+                if (elements.empty()) return 0;
+                PlyElement& element = elements.back();
+
+                PlyProperty prop;
+                std::string typeName;
+                ss >> typeName;
+                if (typeName == "list") {
+                    std::string countName, itemName;
+                    ss >> countName >> itemName >> prop.name;
+                    prop.isList = true;
+                    prop.countType = parseType(countName);
+                    prop.itemType = parseType(itemName);
+                    if (prop.countType == PlyType::Invalid || prop.itemType == PlyType::Invalid) return 0;
+                    element.fixedSize = false;
+                    element.minStride += typeSize(prop.countType);
+                } else {
+                    ss >> prop.name;
+                    prop.type = parseType(typeName);
+                    if (prop.type == PlyType::Invalid) return 0;
+                    prop.offset = element.stride;
+                    element.stride += typeSize(prop.type);
+                    element.minStride += typeSize(prop.type);
+                }
+                element.properties.push_back(std::move(prop));
+            } else if (keyword == END_HEADER) {
+                return pos;
+            }
+            // "comment" and "obj_info" lines are ignored
+        }
+        return 0;
+    }
+
+    // Advance past one variable-size record; returns nullptr if it runs off the end
+    const uint8_t* skipRecord(const uint8_t* p, const uint8_t* end,
+                              const PlyElement& element, bool swap) {
+        for (const auto& prop : element.properties) {
+            if (prop.isList) {
+                size_t countSize = typeSize(prop.countType);
+                if (p + countSize > end) return nullptr;
+                int64_t n = readInteger(p, prop.countType, swap);
+                p += countSize;
+                if (n < 0 || !countFits(static_cast<size_t>(n), typeSize(prop.itemType), end - p)) return nullptr;
+                p += static_cast<size_t>(n) * typeSize(prop.itemType);
+            } else {
+                p += typeSize(prop.type);
+            }
+            if (p > end) return nullptr;
+        }
+        return p;
+    }
+}
+
+bool PlyLoader::load(const std::string& path, MeshData& outData) {
+    outData.clear();
+
+    MappedFile file;
+    if (!file.open(path)) {
+        std::cerr << "PlyLoader error: cannot open " << path << std::endl;
+        return false;
+    }
+
+    std::string format;
+    std::vector<PlyElement> elements;
+    size_t bodyOffset = parseHeader(file.data(), file.size(), format, elements);
+    if (bodyOffset == 0) {
+        std::cerr << "PlyLoader error: invalid header in " << path << std::endl;
+        return false;
+    }
+
+    bool fileLittleEndian;
+    if (format == "binary_little_endian") {
+        fileLittleEndian = true;
+    } else if (format == "binary_big_endian") {
+        fileLittleEndian = false;
+    } else {
+        std::cerr << "PlyLoader error: unsupported format '" << format
+                  << "' (only binary PLY is supported): " << path << std::endl;
+        return false;
+    }
+    const bool swap = fileLittleEndian != hostIsLittleEndian();
+
+    const PlyElement* vertexElement = nullptr;
+    for (const auto& element : elements) {
+        if (element.name == "vertex") vertexElement = &element;
+    }
+    if (!vertexElement || vertexElement->count == 0) {
+        std::cerr << "PlyLoader error: no vertices in " << path << std::endl;
+        return false;
+    }
+    if (!vertexElement->fixedSize) {
+        std::cerr << "PlyLoader error: list properties on vertices are not supported: " << path << std::endl;
+        return false;
+    }
+
+    const size_t vertexCount = vertexElement->count;
+    const uint8_t* cursor = file.data() + bodyOffset;
+    const uint8_t* end = file.data() + file.size();
+    bool hasFaces = false;
+    bool hasNormals = false;
+
+    for (const auto& element : elements) {
+        if (&element == vertexElement) {
+            // ========== Vertices: fixed stride, decoded in parallel ==========
+            const size_t stride = element.stride;
+            if (!countFits(vertexCount, stride, end - cursor)) {
+                std::cerr << "PlyLoader error: truncated vertex data in " << path << std::endl;
+                return false;
+            }
+
+            const PlyProperty* px = element.find("x");
+            const PlyProperty* py = element.find("y");
+            const PlyProperty* pz = element.find("z");
+            if (!px || !py || !pz) {
+                std::cerr << "PlyLoader error: vertex positions missing in " << path << std::endl;
+                return false;
+            }
+
+            const PlyProperty* pnx = element.find("nx");
+            const PlyProperty* pny = element.find("ny");
+            const PlyProperty* pnz = element.find("nz");
+            hasNormals = pnx && pny && pnz;
+
+            const PlyProperty* pu = element.find("s");
+            const PlyProperty* pv = element.find("t");
+            if (!pu || !pv) { pu = element.find("u"); pv = element.find("v"); }
+            if (!pu || !pv) { pu = element.find("texture_u"); pv = element.find("texture_v"); }
+            if (!pu || !pv) { pu = element.find("texture_s"); pv = element.find("texture_t"); }
+            const bool hasTexCoords = pu && pv;
+
+            outData.vertices.resize(vertexCount);
+            const uint8_t* base = cursor;
+
+            #pragma omp parallel for schedule(static)
+            for (size_t i = 0; i < vertexCount; ++i) {
+                const uint8_t* record = base + i * stride;
+                Vertex& v = outData.vertices[i];
+
+                v.position = glm::vec3(
+                    readFloat(record + px->offset, px->type, swap),
+                    readFloat(record + py->offset, py->type, swap),
+                    readFloat(record + pz->offset, pz->type, swap));
+
+                if (hasNormals) {
+                    v.normal = glm::vec3(
+                        readFloat(record + pnx->offset, pnx->type, swap),
+                        readFloat(record + pny->offset, pny->type, swap),
+                        readFloat(record + pnz->offset, pnz->type, swap));
+                } else {
+                    v.normal = glm::vec3(0.0f);
+                }
+
+                if (hasTexCoords) {
+                    // Match ObjLoader's V flip
+                    v.texCoord = glm::vec2(
+                        readFloat(record + pu->offset, pu->type, swap),
+                        1.0f - readFloat(record + pv->offset, pv->type, swap));
+                } else {
+                    v.texCoord = glm::vec2(0.0f);
+                }
+                v.solutionValue = 0.0f;
+            }
+
+            cursor += vertexCount * stride;
+        } else if (element.name == "face") {
+            // ========== Faces: variable-length index lists ==========
+            const PlyProperty* indexProp = element.find("vertex_indices");
+            if (!indexProp) indexProp = element.find("vertex_index");
+            if (!indexProp || !indexProp->isList) {
+                std::cerr << "PlyLoader error: face element has no vertex index list in " << path << std::endl;
+                return false;
+            }
+
+            const size_t faceCount = element.count;
+            if (!countFits(faceCount, element.minStride, end - cursor)) {
+                std::cerr << "PlyLoader error: truncated face data in " << path << std::endl;
+                return false;
+            }
+            const size_t countSize = typeSize(indexProp->countType);
+            const size_t itemSize = typeSize(indexProp->itemType);
+            bool invalidIndex = false;
+
+            // Fast path: the list is the only property and every face is a triangle,
+            // so records have a fixed stride and can be decoded in parallel
+            const size_t triStride = countSize + 3 * itemSize;
+            bool allTriangles = element.properties.size() == 1 &&
+                                countFits(faceCount, triStride, end - cursor);
+            if (allTriangles) {
+                const uint8_t* base = cursor;
+                bool mismatch = false;
+
+                #pragma omp parallel for schedule(static) reduction(||:mismatch)
+                for (size_t f = 0; f < faceCount; ++f) {
+                    if (readInteger(base + f * triStride, indexProp->countType, swap) != 3) {
+                        mismatch = true;
+                    }
+                }
+                allTriangles = !mismatch;
+            }
+
+            if (allTriangles) {
+                const uint8_t* base = cursor;
+                outData.indices.resize(faceCount * 3);
+
+                #pragma omp parallel for schedule(static) reduction(||:invalidIndex)
+                for (size_t f = 0; f < faceCount; ++f) {
+                    const uint8_t* items = base + f * triStride + countSize;
+                    for (size_t k = 0; k < 3; ++k) {
+                        int64_t idx = readInteger(items + k * itemSize, indexProp->itemType, swap);
+                        if (idx < 0 || static_cast<size_t>(idx) >= vertexCount) {
+                            invalidIndex = true;
+                            idx = 0;
+                        }
+                        outData.indices[f * 3 + k] = static_cast<uint32_t>(idx);
+                    }
+                }
+                cursor += faceCount * triStride;
+            } else {
+                // General path: polygons of any size, fan-triangulated
+                outData.indices.reserve(faceCount * 3);
+                for (size_t f = 0; f < faceCount; ++f) {
+                    const uint8_t* p = cursor;
+                    for (const auto& prop : element.properties) {
+                        if (!prop.isList) {
+                            if (static_cast<size_t>(end - p) < typeSize(prop.type)) {
+                                p = nullptr;
+                                break;
+                            }
+                            p += typeSize(prop.type);
+                            continue;
+                        }
+                        if (static_cast<size_t>(end - p) < typeSize(prop.countType)) {
+                            p = nullptr;
+                            break;
+                        }
+                        int64_t n = readInteger(p, prop.countType, swap);
+                        const uint8_t* items = p + typeSize(prop.countType);
+                        if (n < 0 || !countFits(static_cast<size_t>(n), typeSize(prop.itemType), end - items)) {
+                            p = nullptr;
+                            break;
+                        }
+                        p = items + static_cast<size_t>(n) * typeSize(prop.itemType);
+
+                        if (&prop != indexProp) continue;
+
+                        int64_t first = readInteger(items, prop.itemType, swap);
+                        for (int64_t k = 1; k + 1 < n; ++k) {
+                            int64_t b = readInteger(items + k * itemSize, prop.itemType, swap);
+                            int64_t c = readInteger(items + (k + 1) * itemSize, prop.itemType, swap);
+                            if (first < 0 || b < 0 || c < 0 ||
+                                static_cast<size_t>(first) >= vertexCount ||
+                                static_cast<size_t>(b) >= vertexCount ||
+                                static_cast<size_t>(c) >= vertexCount) {
+                                invalidIndex = true;
+                                continue;
+                            }
+                            outData.indices.push_back(static_cast<uint32_t>(first));
+                            outData.indices.push_back(static_cast<uint32_t>(b));
+                            outData.indices.push_back(static_cast<uint32_t>(c));
+                        }
+                    }
+                    if (!p) {
+                        std::cerr << "PlyLoader error: truncated face data in " << path << std::endl;
+                        return false;
+                    }
+                    cursor = p;
+                }
+            }
+
+            if (invalidIndex) {
+                std::cerr << "PlyLoader error: face index out of range in " << path << std::endl;
+                return false;
+            }
+            hasFaces = true;
+        } else {
+            // ========== Other elements (edges, materials, ...): skip ==========
+            if (!countFits(element.count, element.minStride, end - cursor)) {
+                std::cerr << "PlyLoader error: truncated '" << element.name << "' data in " << path << std::endl;
+                return false;
+            }
+            if (element.fixedSize) {
+                cursor += element.count * element.stride;
+            } else {
+                for (size_t i = 0; i < element.count && cursor; ++i) {
+                    cursor = skipRecord(cursor, end, element, swap);
+                }
+                if (!cursor) {
+                    std::cerr << "PlyLoader error: truncated '" << element.name << "' data in " << path << std::endl;
+                    return false;
+                }
+            }
+        }
+    }
+
+    if (!hasFaces || outData.indices.empty()) {
+        std::cerr << "PlyLoader error: no faces in " << path << " (point clouds are not supported)" << std::endl;
+        return false;
+    }
+
+    // Normals are generated once faces are known
+    if (!hasNormals) {
+        outData.recalculateNormals();
+    }
+    outData.calculateBounds();
+
+    return true;
+}
+
+bool PlyLoader::canLoad(const std::string& extension) const {
+    return extension == ".ply" || extension == "ply";
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+#include "MeshLoader.h"
+
+// Binary PLY loader (binary_little_endian / binary_big_endian)
+// Vertex records have a fixed layout described by the header, so they are
+// decoded in parallel straight from the memory-mapped file.
+class PlyLoader : public MeshLoader {
+public:
+    bool load(const std::string& path, MeshData& outData) override;
+    bool canLoad(const std::string& extension) const override;
+};
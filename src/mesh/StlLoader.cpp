@@ -0,0 +1,192 @@
+#include "StlLoader.h"
+#include "util/MappedFile.h"
+#include <omp.h>
+#include <cstring>
+#include <iostream>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+    constexpr size_t STL_HEADER_SIZE = 80;
+    constexpr size_t STL_COUNT_SIZE = 4;
+    constexpr size_t STL_RECORD_SIZE = 50;   // normal[3], v0[3], v1[3], v2[3], uint16 attribute
+    constexpr size_t STL_VERTEX_OFFSET = 12; // Skip facet normal (recomputed after welding)
+
+    // Bit pattern of a corner position (-0.0 folded into +0.0 so they weld)
+    struct PositionBits {
+        uint32_t x, y, z;
+
+        bool operator==(const PositionBits& other) const {
+            return x == other.x && y == other.y && z == other.z;
+        }
+    };
+
+    struct PositionBitsHash {
+        size_t operator()(const PositionBits& p) const {
+            uint64_t h = 1469598103934665603ull;
+            h = (h ^ p.x) * 1099511628211ull;
+            h = (h ^ p.y) * 1099511628211ull;
+            h = (h ^ p.z) * 1099511628211ull;
+            return static_cast<size_t>(h ^ (h >> 29));
+        }
+    };
+
+    inline uint32_t floatBits(float f) {
+        if (f == 0.0f) f = 0.0f;  // -0.0 -> +0.0
+        uint32_t bits;
+        std::memcpy(&bits, &f, sizeof(bits));
+        return bits;
+    }
+
+    // STL is always little-endian
+    inline float readFloatLE(const uint8_t* p) {
+        uint32_t bits = static_cast<uint32_t>(p[0])
+                      | (static_cast<uint32_t>(p[1]) << 8)
+                      | (static_cast<uint32_t>(p[2]) << 16)
+                      | (static_cast<uint32_t>(p[3]) << 24);
+        float f;
+        std::memcpy(&f, &bits, sizeof(f));
+        return f;
+    }
+
+    inline uint32_t readUInt32LE(const uint8_t* p) {
+        return static_cast<uint32_t>(p[0])
+             | (static_cast<uint32_t>(p[1]) << 8)
+             | (static_cast<uint32_t>(p[2]) << 16)
+             | (static_cast<uint32_t>(p[3]) << 24);
+    }
+}
+
+bool StlLoader::load(const std::string& path, MeshData& outData) {
+    outData.clear();
+
+    MappedFile file;
+    if (!file.open(path)) {
+        std::cerr << "StlLoader error: cannot open " << path << std::endl;
+        return false;
+    }
+
+    if (file.size() < STL_HEADER_SIZE + STL_COUNT_SIZE) {
+        std::cerr << "StlLoader error: file too small: " << path << std::endl;
+        return false;
+    }
+
+    const uint8_t* data = file.data();
+    const size_t triangleCount = readUInt32LE(data + STL_HEADER_SIZE);
+    const size_t expectedSize = STL_HEADER_SIZE + STL_COUNT_SIZE + triangleCount * STL_RECORD_SIZE;
+
+    // ASCII STL also starts with "solid", so the size check is the reliable test
+    if (file.size() < expectedSize) {
+        if (std::strncmp(reinterpret_cast<const char*>(data), "solid", 5) == 0) {
+            std::cerr << "StlLoader error: ASCII STL is not supported, convert to binary: " << path << std::endl;
+        } else {
+            std::cerr << "StlLoader error: truncated file (" << triangleCount << " facets declared): "
+                      << path << std::endl;
+        }
+        return false;
+    }
+
+    if (triangleCount == 0) {
+        std::cerr << "StlLoader error: no facets in " << path << std::endl;
+        return false;
+    }
+
+    const uint8_t* records = data + STL_HEADER_SIZE + STL_COUNT_SIZE;
+    const size_t cornerCount = triangleCount * 3;
+
+    auto cornerPointer = [records](size_t corner) {
+        size_t tri = corner / 3;
+        size_t k = corner % 3;
+        return records + tri * STL_RECORD_SIZE + STL_VERTEX_OFFSET + k * 12;
+    };
+
+    // ========== PHASE 1: Decode corner positions and hash them ==========
+    std::vector<PositionBits> cornerBits(cornerCount);
+    std::vector<uint32_t> cornerHash(cornerCount);
+    PositionBitsHash hasher;
+
+    #pragma omp parallel for schedule(static)
+    for (size_t c = 0; c < cornerCount; ++c) {
+        const uint8_t* p = cornerPointer(c);
+        PositionBits bits{
+            floatBits(readFloatLE(p)),
+            floatBits(readFloatLE(p + 4)),
+            floatBits(readFloatLE(p + 8))
+        };
+        cornerBits[c] = bits;
+        cornerHash[c] = static_cast<uint32_t>(hasher(bits));
+    }
+
+    // ========== PHASE 2: Parallel weld ==========
+    // Each thread owns the corners whose hash falls into its partition, so the
+    // per-thread tables never overlap. Scanning in corner order makes the
+    // representative of each position its first occurrence.
+    std::vector<uint32_t> representative(cornerCount);
+
+    #pragma omp parallel
+    {
+        const uint32_t numThreads = static_cast<uint32_t>(omp_get_num_threads());
+        const uint32_t tid = static_cast<uint32_t>(omp_get_thread_num());
+
+        std::unordered_map<PositionBits, uint32_t, PositionBitsHash> firstCorner;
+        firstCorner.reserve(cornerCount / (2 * numThreads) + 16);
+
+        for (size_t c = 0; c < cornerCount; ++c) {
+            if ((cornerHash[c] >> 7) % numThreads != tid) continue;
+
+            auto [it, inserted] = firstCorner.emplace(cornerBits[c], static_cast<uint32_t>(c));
+            representative[c] = it->second;
+        }
+    }
+
+    // ========== PHASE 3: Compact into first-use vertex order ==========
+    std::vector<uint32_t> cornerToVertex(cornerCount);
+    outData.vertices.reserve(cornerCount / 5);
+
+    for (size_t c = 0; c < cornerCount; ++c) {
+        uint32_t rep = representative[c];
+        if (rep == c) {
+            cornerToVertex[c] = static_cast<uint32_t>(outData.vertices.size());
+
+            Vertex vertex{};
+            std::memcpy(&vertex.position.x, &cornerBits[c].x, sizeof(float));
+            std::memcpy(&vertex.position.y, &cornerBits[c].y, sizeof(float));
+            std::memcpy(&vertex.position.z, &cornerBits[c].z, sizeof(float));
+            vertex.normal = glm::vec3(0.0f);
+            vertex.texCoord = glm::vec2(0.0f);
+            outData.vertices.push_back(vertex);
+        } else {
+            cornerToVertex[c] = cornerToVertex[rep];  // rep < c, already assigned
+        }
+    }
+
+    // Drop facets that collapsed after welding
+    outData.indices.reserve(cornerCount);
+    size_t degenerate = 0;
+    for (size_t t = 0; t < triangleCount; ++t) {
+        uint32_t i0 = cornerToVertex[t * 3];
+        uint32_t i1 = cornerToVertex[t * 3 + 1];
+        uint32_t i2 = cornerToVertex[t * 3 + 2];
+        if (i0 == i1 || i1 == i2 || i2 == i0) {
+            ++degenerate;
+            continue;
+        }
+        outData.indices.push_back(i0);
+        outData.indices.push_back(i1);
+        outData.indices.push_back(i2);
+    }
+
+    if (degenerate > 0) {
+        std::cout << "StlLoader warning: dropped " << degenerate << " degenerate facets" << std::endl;
+    }
+
+    // STL facet normals are per-face; smooth normals need the welded topology
+    outData.recalculateNormals();
+    outData.calculateBounds();
+
+    return !outData.indices.empty();
+}
+
+bool StlLoader::canLoad(const std::string& extension) const {
+    return extension == ".stl" || extension == "stl";
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+#include "MeshLoader.h"
+
+// Binary STL loader
+// Reads the memory-mapped 50-byte facet records in place and welds the
+// unshared facet corners into an indexed mesh in parallel.
+class StlLoader : public MeshLoader {
+public:
+    bool load(const std::string& path, MeshData& outData) override;
+    bool canLoad(const std::string& extension) const override;
+};
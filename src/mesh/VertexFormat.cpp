@@ -0,0 +1,134 @@
+#include "VertexFormat.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/packing.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+    // Below this many vertices the thread start-up costs more than encoding
+    constexpr size_t PARALLEL_ENCODE_MIN = 1u << 16;
+
+    uint16_t quantizeUnorm16(float value) {
+        return static_cast<uint16_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * 65535.0f));
+    }
+
+    uint32_t packSnorm10(float value) {
+        const int32_t q = static_cast<int32_t>(std::lround(std::clamp(value, -1.0f, 1.0f) * 511.0f));
+        return static_cast<uint32_t>(q) & 0x3FFu;
+    }
+
+    uint32_t packNormal(const glm::vec3& normal) {
+        return packSnorm10(normal.x) | (packSnorm10(normal.y) << 10) | (packSnorm10(normal.z) << 20);
+    }
+}
+
+VertexFormat::Layout VertexFormat::s_layout = VertexFormat::Layout::Compact;
+
+const char* VertexFormat::getLayoutName() {
+    return s_layout == Layout::Compact ? "compact" : "full";
+}
+
+size_t VertexFormat::getStride() {
+    return s_layout == Layout::Compact ? sizeof(CompactVertex) : sizeof(Vertex);
+}
+
+void VertexFormat::encode(const Vertex* vertices, size_t count,
+                          const glm::vec3& minBounds, const glm::vec3& maxBounds, void* dst) {
+    if (s_layout == Layout::Full) {
+        std::memcpy(dst, vertices, count * sizeof(Vertex));
+        return;
+    }
+
+    // Flat axes keep every vertex at the minimum
+    const glm::vec3 extent = maxBounds - minBounds;
+    const glm::vec3 invExtent(extent.x > 0.0f ? 1.0f / extent.x : 0.0f,
+                              extent.y > 0.0f ? 1.0f / extent.y : 0.0f,
+                              extent.z > 0.0f ? 1.0f / extent.z : 0.0f);
+
+    CompactVertex* out = static_cast<CompactVertex*>(dst);
+
+    #pragma omp parallel for schedule(static) if (count >= PARALLEL_ENCODE_MIN)
+    for (size_t i = 0; i < count; ++i) {
+        const Vertex& v = vertices[i];
+        const glm::vec3 p = (v.position - minBounds) * invExtent;
+
+        CompactVertex c;
+        c.position[0] = quantizeUnorm16(p.x);
+        c.position[1] = quantizeUnorm16(p.y);
+        c.position[2] = quantizeUnorm16(p.z);
+        c.position[3] = 0;
+        c.normal = packNormal(v.normal);
+        c.texCoord = glm::packHalf2x16(v.texCoord);
+        c.solutionValue = v.solutionValue;
+        out[i] = c;
+    }
+}
+
+glm::mat4 VertexFormat::getPositionTransform(const glm::vec3& minBounds, const glm::vec3& maxBounds) {
+    if (s_layout == Layout::Full) {
+        return glm::mat4(1.0f);
+    }
+    return glm::scale(glm::translate(glm::mat4(1.0f), minBounds), maxBounds - minBounds);
+}
+
+void VertexFormat::setAttributes(GLuint vao) {
+    if (s_layout == Layout::Compact) {
+        glEnableVertexArrayAttrib(vao, 0);
+        glVertexArrayAttribFormat(vao, 0, 3, GL_UNSIGNED_SHORT, GL_TRUE, offsetof(CompactVertex, position));
+        glVertexArrayAttribBinding(vao, 0, 0);
+
+        glEnableVertexArrayAttrib(vao, 1);
+        glVertexArrayAttribFormat(vao, 1, 4, GL_INT_2_10_10_10_REV, GL_TRUE, offsetof(CompactVertex, normal));
+        glVertexArrayAttribBinding(vao, 1, 0);
+
+        glEnableVertexArrayAttrib(vao, 2);
+        glVertexArrayAttribFormat(vao, 2, 2, GL_HALF_FLOAT, GL_FALSE, offsetof(CompactVertex, texCoord));
+        glVertexArrayAttribBinding(vao, 2, 0);
+
+        glEnableVertexArrayAttrib(vao, 3);
+        glVertexArrayAttribFormat(vao, 3, 1, GL_FLOAT, GL_FALSE, offsetof(CompactVertex, solutionValue));
+        glVertexArrayAttribBinding(vao, 3, 0);
+        return;
+    }
+
+    // Position attribute
+    glEnableVertexArrayAttrib(vao, 0);
+    glVertexArrayAttribFormat(vao, 0, 3, GL_FLOAT, GL_FALSE, offsetof(Vertex, position));
+    glVertexArrayAttribBinding(vao, 0, 0);
+
+    // Normal attribute
+    glEnableVertexArrayAttrib(vao, 1);
+    glVertexArrayAttribFormat(vao, 1, 3, GL_FLOAT, GL_FALSE, offsetof(Vertex, normal));
+    glVertexArrayAttribBinding(vao, 1, 0);
+
+    // TexCoord attribute
+    glEnableVertexArrayAttrib(vao, 2);
+    glVertexArrayAttribFormat(vao, 2, 2, GL_FLOAT, GL_FALSE, offsetof(Vertex, texCoord));
+    glVertexArrayAttribBinding(vao, 2, 0);
+
+    // Solution value attribute (for Poisson visualization)
+    glEnableVertexArrayAttrib(vao, 3);
+    glVertexArrayAttribFormat(vao, 3, 1, GL_FLOAT, GL_FALSE, offsetof(Vertex, solutionValue));
+    glVertexArrayAttribBinding(vao, 3, 0);
+}
+
+GLenum VertexFormat::getIndexType(size_t vertexCount) {
+    return vertexCount <= MAX_SHORT_INDEX_VERTICES ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+}
+
+size_t VertexFormat::getIndexSize(GLenum indexType) {
+    return indexType == GL_UNSIGNED_SHORT ? sizeof(uint16_t) : sizeof(uint32_t);
+}
+
+void VertexFormat::encodeIndices(const uint32_t* indices, size_t count, GLenum indexType, void* dst) {
+    if (indexType == GL_UNSIGNED_INT) {
+        std::memcpy(dst, indices, count * sizeof(uint32_t));
+        return;
+    }
+
+    uint16_t* out = static_cast<uint16_t*>(dst);
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = static_cast<uint16_t>(indices[i]);
+    }
+}
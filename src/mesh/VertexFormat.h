@@ -0,0 +1,61 @@
+#pragma once
+
+#include <glad/gl.h>
+#include "MeshData.h"
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+
+// Layout of vertex data in GPU buffers, chosen once at startup (before any
+// mesh is uploaded) and shared by every mesh and the geometry arena.
+// Index buffers are 16-bit whenever a mesh has few enough vertices.
+//
+// Full mirrors Vertex (36 bytes). Compact (20 bytes) stores positions as
+// 16-bit unsigned normalized offsets within the mesh bounds, normals as
+// signed 10:10:10:2 and texture coordinates as half floats; the solution
+// value stays a float. The vertex fetch decodes everything but the position
+// bounds, which the renderer folds into the model matrix (see
+// getPositionTransform), so the shaders are the same for both layouts.
+class VertexFormat {
+public:
+    enum class Layout { Full, Compact };
+
+    struct CompactVertex {
+        uint16_t position[4];   // w unused
+        uint32_t normal;        // GL_INT_2_10_10_10_REV
+        uint32_t texCoord;      // Two half floats
+        float solutionValue;
+    };
+
+    static void setLayout(Layout layout) { s_layout = layout; }
+    static Layout getLayout() { return s_layout; }
+    static const char* getLayoutName();
+
+    // Bytes per vertex in GPU buffers
+    static size_t getStride();
+
+    // Write count vertices in the current layout to dst (getStride() bytes
+    // each); positions are quantized within the given bounds. Large ranges
+    // are encoded in parallel.
+    static void encode(const Vertex* vertices, size_t count,
+                       const glm::vec3& minBounds, const glm::vec3& maxBounds, void* dst);
+
+    // Maps decoded positions (0..1 within the bounds for Compact) to object space
+    static glm::mat4 getPositionTransform(const glm::vec3& minBounds, const glm::vec3& maxBounds);
+
+    // Attribute formats for a VAO reading vertices from binding 0
+    static void setAttributes(GLuint vao);
+
+    // Meshes up to this many vertices use 16-bit indices
+    static constexpr size_t MAX_SHORT_INDEX_VERTICES = 1u << 16;
+
+    // GL_UNSIGNED_SHORT or GL_UNSIGNED_INT for a mesh with vertexCount vertices
+    static GLenum getIndexType(size_t vertexCount);
+    static size_t getIndexSize(GLenum indexType);
+
+    // Write count indices as indexType to dst
+    static void encodeIndices(const uint32_t* indices, size_t count, GLenum indexType, void* dst);
+
+private:
+    static Layout s_layout;
+};
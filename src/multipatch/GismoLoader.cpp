@@ -215,11 +215,6 @@ MeshData GismoLoader::tessellatePatch(const gismo::gsGeometry<double>& patch,
     data.calculateBounds();
     return data;
 }
-#else
-MeshData GismoLoader::tessellatePatch(const gismo::gsGeometry<double>& /*patch*/,
-                                       int /*uSamples*/, int /*vSamples*/) {
-    return MeshData();
-}
 #endif
 
 #ifdef GISMO_AVAILABLE
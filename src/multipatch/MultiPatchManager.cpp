@@ -2,6 +2,7 @@
 #include "GismoLoader.h"
 #include "async/TessellationTask.h"
 #include "async/PoissonTask.h"
+#include "geometry/MeshOptimizer.h"
 #include <iostream>
 #include <algorithm>
 #include <cmath>
@@ -172,8 +173,8 @@ void MultiPatchManager::updateTessellation(const Camera& camera, float aspectRat
     }
 }
 
-void MultiPatchManager::processCompletedTasks() {
-    m_tessManager.processCompletedTasks();
+int MultiPatchManager::processCompletedTasks(size_t maxTessellations) {
+    int completed = m_tessManager.processCompletedTasks(maxTessellations);
 
     // Check for completed Poisson solving
     int poissonCompleted = m_poissonManager.processCompletedTasks();
@@ -183,6 +184,7 @@ void MultiPatchManager::processCompletedTasks() {
         // Signal that solution visualization should be enabled
         m_solutionReady = true;
     }
+    return completed + poissonCompleted;
 }
 
 void MultiPatchManager::startPoissonSolving() {
@@ -233,6 +235,8 @@ void MultiPatchManager::retessellateWithSolution() {
         MeshData meshData = GismoLoader::tessellatePatchWithSolution(
             m_multipatch->patch(patchIndex), level, level, &solution, patchIndex);
 
+        MeshOptimizer::optimize(meshData);
+
         // Update tessellation level and apply mesh data
         patch->setTessellationLevel(level);
         patch->setMeshData(meshData);
@@ -8,6 +8,7 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <limits>
 
 #ifdef GISMO_AVAILABLE
 #include <gismo.h>
@@ -34,12 +35,26 @@ public:
     // Call this each frame or when camera changes
     void updateTessellation(const Camera& camera, float aspectRatio, int viewportWidth, int viewportHeight);
 
-    // Process completed tessellation tasks (call from main thread)
-    void processCompletedTasks();
+    // Process completed tessellation tasks (call from main thread), at most
+    // maxTessellations of them this call
+    // Returns the number of tessellation and Poisson results applied
+    int processCompletedTasks(size_t maxTessellations = std::numeric_limits<size_t>::max());
 
     // Check if any patches are being re-tessellated
     bool isBusy() const { return m_tessManager.isBusy(); }
 
+    // Tessellation or Poisson tasks queued, running or awaiting apply
+    bool hasPendingWork() const { return m_tessManager.hasPendingWork() || m_poissonManager.hasPendingWork(); }
+
+    // Forwarded to the tessellation and Poisson workers
+    void setCompletionCallback(const std::function<void()>& callback) {
+        m_tessManager.setCompletionCallback(callback);
+        m_poissonManager.setCompletionCallback(callback);
+    }
+
+    // Forwarded to the tessellation worker
+    void setStagingRing(StagingRing* ring) { m_tessManager.setStagingRing(ring); }
+
     // Get progress info for UI
     bool getActiveProgressSnapshot(ProgressSnapshot& snapshot) const { return m_tessManager.getActiveProgressSnapshot(snapshot); }
     std::string getActiveObjectName() const { return m_tessManager.getActiveObjectName(); }
@@ -1,4 +1,5 @@
 #include "PatchObject.h"
+#include "geometry/MeshOptimizer.h"
 #include <iostream>
 
 PatchObject::PatchObject(const std::string& name, int patchIndex)
@@ -22,9 +23,9 @@ void PatchObject::requestTessellation(int newLevel) {
     }
 }
 
-void PatchObject::applyRetessellatedMesh(MeshData&& data, int newLevel) {
+void PatchObject::applyRetessellatedMesh(MeshData&& data, int newLevel, std::shared_ptr<StagedMesh> staged) {
     // Apply the new mesh data
-    applySubdividedMesh(std::move(data));
+    applySubdividedMesh(std::move(data), std::move(staged));
     m_tessellationLevel = newLevel;
     m_pendingTessLevel = newLevel;
     m_isRetessellating = false;
@@ -37,6 +38,7 @@ void PatchObject::tessellateSync(int level) {
     }
 
     MeshData meshData = m_tessCallback(level, level);
+    MeshOptimizer::optimize(meshData);
     setMeshData(meshData);
     m_tessellationLevel = level;
     m_pendingTessLevel = level;
@@ -32,7 +32,7 @@ public:
     void requestTessellation(int newLevel);
 
     // Apply re-tessellated mesh (called after background tessellation completes)
-    void applyRetessellatedMesh(MeshData&& data, int newLevel);
+    void applyRetessellatedMesh(MeshData&& data, int newLevel, std::shared_ptr<StagedMesh> staged = nullptr);
 
     // Get patch index within the multipatch
     int getPatchIndex() const { return m_patchIndex; }
@@ -1,5 +1,7 @@
 #include "TessellationManager.h"
 #include "PatchObject.h"
+#include "geometry/MeshOptimizer.h"
+#include "renderer/StagingRing.h"
 #include <iostream>
 
 void TessellationManager::processTask(TessellationTask& task) {
@@ -29,6 +31,12 @@ void TessellationManager::processTask(TessellationTask& task) {
         return;
     }
 
+    MeshOptimizer::optimize(task.resultData);
+
+    if (m_stagingRing) {
+        task.staged = m_stagingRing->stage(task.resultData, &progress);
+    }
+
     progress.updatePhaseProgress(1.0f);
     progress.complete();
 }
@@ -39,6 +47,6 @@ bool TessellationManager::applyTaskResult(TessellationTask& task) {
     }
 
     // Apply the tessellated mesh to the patch object
-    task.targetObject->applyRetessellatedMesh(std::move(task.resultData), task.newLevel);
+    task.targetObject->applyRetessellatedMesh(std::move(task.resultData), task.newLevel, std::move(task.staged));
     return true;
 }
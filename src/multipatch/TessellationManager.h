@@ -3,11 +3,19 @@
 #include "async/TaskManager.h"
 #include "async/TessellationTask.h"
 
+class StagingRing;
+
 class TessellationManager : public TaskManager<TessellationTask> {
 public:
     ~TessellationManager() override { shutdown(); }
 
+    // Workers copy results into the ring for budgeted upload (see SubdivisionManager)
+    void setStagingRing(StagingRing* ring) { m_stagingRing = ring; }
+
 protected:
     void processTask(TessellationTask& task) override;
     bool applyTaskResult(TessellationTask& task) override;
+
+private:
+    StagingRing* m_stagingRing{nullptr};
 };
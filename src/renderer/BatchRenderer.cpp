@@ -0,0 +1,139 @@
+#include "BatchRenderer.h"
+#include <algorithm>
+
+namespace {
+    constexpr GLuint OBJECT_BUFFER_BINDING = 0;
+}
+
+BatchRenderer::~BatchRenderer() {
+    if (m_objectBuffer) {
+        glDeleteBuffers(1, &m_objectBuffer);
+    }
+    if (m_commandBuffer) {
+        glDeleteBuffers(1, &m_commandBuffer);
+    }
+}
+
+void BatchRenderer::init(GeometryArena* arena) {
+    m_arena = arena;
+}
+
+void BatchRenderer::add(const Mesh* mesh, const glm::mat4& model, const glm::mat3& normalMatrix,
+                        const glm::vec3& color, const Texture* texture) {
+    const GeometryArena::Range* range = m_arena->acquire(mesh);
+    if (!range) {
+        return;
+    }
+
+    DrawItem item;
+    item.texture = texture;
+    item.indexType = range->indexType;
+    item.command.count = range->indexCount;
+    item.command.instanceCount = 1;
+    item.command.firstIndex = range->firstIndex;
+    item.command.baseVertex = static_cast<int32_t>(range->firstVertex);
+    item.command.baseInstance = 0;
+    item.data.model = model * mesh->getPositionTransform();
+    item.data.normalMatrix = glm::mat4(normalMatrix);
+    item.data.color = glm::vec4(color, 1.0f);
+    m_items.push_back(item);
+}
+
+void BatchRenderer::flush() {
+    m_drawCalls = 0;
+    m_lastObjectCount = static_cast<uint32_t>(m_items.size());
+    m_lastCommandCount = 0;
+
+    if (!m_items.empty()) {
+        // One group (and one multi-draw) per texture and index type; within
+        // it, draws of the same mesh range are adjacent so they merge into
+        // instanced commands
+        std::stable_sort(m_items.begin(), m_items.end(),
+                         [](const DrawItem& a, const DrawItem& b) {
+                             if (a.texture != b.texture) {
+                                 return std::less<const Texture*>()(a.texture, b.texture);
+                             }
+                             if (a.indexType != b.indexType) {
+                                 return a.indexType < b.indexType;
+                             }
+                             if (a.command.firstIndex != b.command.firstIndex) {
+                                 return a.command.firstIndex < b.command.firstIndex;
+                             }
+                             return a.command.baseVertex < b.command.baseVertex;
+                         });
+
+        m_objectData.clear();
+        m_commands.clear();
+        m_groups.clear();
+        for (size_t i = 0; i < m_items.size(); ++i) {
+            const DrawItem& item = m_items[i];
+            m_objectData.push_back(item.data);
+
+            const bool newGroup = m_groups.empty() || m_items[i - 1].texture != item.texture ||
+                                  m_items[i - 1].indexType != item.indexType;
+            if (newGroup) {
+                m_groups.push_back(Group{item.texture, item.indexType, static_cast<uint32_t>(m_commands.size()), 0});
+            }
+
+            DrawCommand* last = m_commands.empty() ? nullptr : &m_commands.back();
+            if (!newGroup && last->firstIndex == item.command.firstIndex &&
+                last->baseVertex == item.command.baseVertex && last->count == item.command.count) {
+                ++last->instanceCount;
+            } else {
+                DrawCommand command = item.command;
+                command.baseInstance = static_cast<uint32_t>(i);
+                m_commands.push_back(command);
+                ++m_groups.back().commandCount;
+            }
+        }
+
+        const size_t drawCount = m_items.size();
+        ensureFrameBuffers(drawCount);
+        glNamedBufferSubData(m_objectBuffer, 0, drawCount * sizeof(ObjectData), m_objectData.data());
+        glNamedBufferSubData(m_commandBuffer, 0, m_commands.size() * sizeof(DrawCommand), m_commands.data());
+        m_lastCommandCount = static_cast<uint32_t>(m_commands.size());
+
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, OBJECT_BUFFER_BINDING, m_objectBuffer);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_commandBuffer);
+
+        GLuint boundVAO = 0;
+        for (const Group& group : m_groups) {
+            const GLuint vao = m_arena->getVAO(group.indexType);
+            if (vao != boundVAO) {
+                glBindVertexArray(vao);
+                boundVAO = vao;
+            }
+            if (group.texture) {
+                group.texture->bind(0);
+            }
+            glMultiDrawElementsIndirect(GL_TRIANGLES, group.indexType,
+                                        reinterpret_cast<const void*>(group.firstCommand * sizeof(DrawCommand)),
+                                        static_cast<GLsizei>(group.commandCount), 0);
+            ++m_drawCalls;
+        }
+
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+        glBindVertexArray(0);
+        m_items.clear();
+    }
+}
+
+void BatchRenderer::ensureFrameBuffers(size_t drawCount) {
+    if (drawCount <= m_frameCapacity) {
+        return;
+    }
+
+    const size_t capacity = std::max({drawCount, m_frameCapacity * 2, size_t(256)});
+    if (m_objectBuffer) {
+        glDeleteBuffers(1, &m_objectBuffer);
+    }
+    if (m_commandBuffer) {
+        glDeleteBuffers(1, &m_commandBuffer);
+    }
+
+    glCreateBuffers(1, &m_objectBuffer);
+    glNamedBufferStorage(m_objectBuffer, capacity * sizeof(ObjectData), nullptr, GL_DYNAMIC_STORAGE_BIT);
+    glCreateBuffers(1, &m_commandBuffer);
+    glNamedBufferStorage(m_commandBuffer, capacity * sizeof(DrawCommand), nullptr, GL_DYNAMIC_STORAGE_BIT);
+    m_frameCapacity = capacity;
+}
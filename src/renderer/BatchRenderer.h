@@ -0,0 +1,88 @@
+#pragma once
+
+#include "GeometryArena.h"
+#include "core/Texture.h"
+#include "mesh/Mesh.h"
+#include <glad/gl.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+// Multi-draw-indirect rendering path.
+// Meshes are drawn from the shared GeometryArena; per-object transforms and
+// colours go into an SSBO. Objects drawing the same mesh (instances of shared
+// geometry at the same LOD) become one instanced command whose instances read
+// their data at gl_BaseInstance + gl_InstanceID. All visible objects sharing a
+// texture and index type are submitted with one glMultiDrawElementsIndirect, so the CPU cost
+// per frame hardly depends on the object count.
+class BatchRenderer {
+public:
+    BatchRenderer() = default;
+    ~BatchRenderer();
+
+    BatchRenderer(const BatchRenderer&) = delete;
+    BatchRenderer& operator=(const BatchRenderer&) = delete;
+
+    void init(GeometryArena* arena);
+
+    // Collect one visible object for this frame
+    void add(const Mesh* mesh, const glm::mat4& model, const glm::mat3& normalMatrix,
+             const glm::vec3& color, const Texture* texture);
+
+    // Submit everything collected since the last flush. The shader must be bound
+    // and have its per-frame uniforms set.
+    void flush();
+
+    // Stats for the last flush
+    uint32_t getDrawCallCount() const { return m_drawCalls; }
+    uint32_t getObjectCount() const { return m_lastObjectCount; }
+    uint32_t getCommandCount() const { return m_lastCommandCount; }
+
+private:
+    // Matches the std430 ObjectData struct in mesh_batched.vert
+    struct ObjectData {
+        glm::mat4 model;
+        glm::mat4 normalMatrix;  // mat3 padded to columns of vec4
+        glm::vec4 color;
+    };
+
+    // Layout defined by glMultiDrawElementsIndirect
+    struct DrawCommand {
+        uint32_t count;
+        uint32_t instanceCount;
+        uint32_t firstIndex;
+        int32_t baseVertex;
+        uint32_t baseInstance;
+    };
+
+    struct DrawItem {
+        const Texture* texture;
+        GLenum indexType;
+        DrawCommand command;
+        ObjectData data;
+    };
+
+    // Consecutive commands drawn with one texture and index type
+    struct Group {
+        const Texture* texture;
+        GLenum indexType;
+        uint32_t firstCommand;
+        uint32_t commandCount;
+    };
+
+    void ensureFrameBuffers(size_t drawCount);
+
+    GeometryArena* m_arena{nullptr};
+    GLuint m_objectBuffer{0};    // SSBO (binding 0)
+    GLuint m_commandBuffer{0};   // GL_DRAW_INDIRECT_BUFFER
+    size_t m_frameCapacity{0};   // Draws that fit in the two buffers above
+
+    std::vector<DrawItem> m_items;
+    std::vector<ObjectData> m_objectData;
+    std::vector<DrawCommand> m_commands;
+    std::vector<Group> m_groups;
+
+    uint32_t m_drawCalls{0};
+    uint32_t m_lastObjectCount{0};
+    uint32_t m_lastCommandCount{0};
+};
@@ -0,0 +1,210 @@
+#include "DynamicResolution.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace {
+    constexpr float TIME_SMOOTHING = 0.2f;    // Weight of the newest timing sample
+    constexpr float RAISE_MARGIN = 0.85f;     // Only scale up below this fraction of the target
+    constexpr float LOWER_GAIN = 0.5f;        // Fraction of the step taken when over the target
+    constexpr float RAISE_GAIN = 0.1f;        // ... and when under it (slower, avoids oscillation)
+    constexpr float MIN_STEP = 0.01f;         // Smaller changes are ignored
+}
+
+DynamicResolution::~DynamicResolution() {
+    releaseTargets();
+    if (m_queries[0]) {
+        glDeleteQueries(QUERY_COUNT, m_queries);
+    }
+    if (m_emptyVAO) {
+        glDeleteVertexArrays(1, &m_emptyVAO);
+    }
+}
+
+void DynamicResolution::init() {
+    m_upscaleShader = std::make_unique<Shader>("shaders/upscale.vert", "shaders/upscale.frag");
+    glCreateVertexArrays(1, &m_emptyVAO);
+    glCreateQueries(GL_TIME_ELAPSED, QUERY_COUNT, m_queries);
+
+    // Match the window's multisampling so scaling is the only visible change
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glGetIntegerv(GL_SAMPLES, &m_samples);
+    m_scale = m_settings.maxScale;
+}
+
+void DynamicResolution::setSettings(const Settings& settings) {
+    m_settings = settings;
+    m_settings.targetMs = std::max(settings.targetMs, 1.0f);
+    m_settings.maxScale = std::clamp(settings.maxScale, 0.1f, 1.0f);
+    m_settings.minScale = std::clamp(settings.minScale, 0.1f, m_settings.maxScale);
+    m_scale = std::clamp(m_scale, m_settings.minScale, m_settings.maxScale);
+}
+
+void DynamicResolution::beginScene(int windowWidth, int windowHeight, bool fullScale) {
+    m_windowWidth = std::max(windowWidth, 1);
+    m_windowHeight = std::max(windowHeight, 1);
+    ensureTargets(m_windowWidth, m_windowHeight);
+    if (!m_sceneFBO) {
+        glViewport(0, 0, m_windowWidth, m_windowHeight);
+        m_frameScale = 1.0f;
+        return;
+    }
+
+    readQueries();
+
+    m_frameScale = fullScale ? m_settings.maxScale : m_scale;
+    m_renderWidth = std::max(1, static_cast<int>(std::lround(m_windowWidth * m_frameScale)));
+    m_renderHeight = std::max(1, static_cast<int>(std::lround(m_windowHeight * m_frameScale)));
+
+    glBindFramebuffer(GL_FRAMEBUFFER, m_sceneFBO);
+    glViewport(0, 0, m_renderWidth, m_renderHeight);
+
+    // Time this frame unless every query is still waiting for the GPU
+    m_timing = !m_queryPending[m_queryIndex];
+    if (m_timing) {
+        glBeginQuery(GL_TIME_ELAPSED, m_queries[m_queryIndex]);
+        m_queryScale[m_queryIndex] = m_frameScale;
+    }
+}
+
+void DynamicResolution::endScene() {
+    if (m_timing) {
+        glEndQuery(GL_TIME_ELAPSED);
+        m_queryPending[m_queryIndex] = true;
+        m_queryIndex = (m_queryIndex + 1) % QUERY_COUNT;
+        m_timing = false;
+    }
+    if (!m_sceneFBO) {
+        return;
+    }
+
+    // ========== Resolve ==========
+    if (m_samples > 0) {
+        glBlitNamedFramebuffer(m_sceneFBO, m_resolveFBO,
+                               0, 0, m_renderWidth, m_renderHeight,
+                               0, 0, m_renderWidth, m_renderHeight,
+                               GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    }
+
+    // ========== Upscale ==========
+    // A blit cannot write a multisampled window, so this is a textured pass
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glViewport(0, 0, m_windowWidth, m_windowHeight);
+    glDisable(GL_DEPTH_TEST);
+    glDepthMask(GL_FALSE);
+    glDisable(GL_CULL_FACE);
+    glDisable(GL_BLEND);
+
+    m_upscaleShader->use();
+    m_upscaleShader->setVec2("uvScale", glm::vec2(static_cast<float>(m_renderWidth) / m_targetWidth,
+                                                  static_cast<float>(m_renderHeight) / m_targetHeight));
+    glBindTextureUnit(0, m_resolveTexture);
+    m_upscaleShader->setInt("sceneTexture", 0);
+    glBindVertexArray(m_emptyVAO);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    glBindVertexArray(0);
+
+    glDepthMask(GL_TRUE);
+    glEnable(GL_DEPTH_TEST);
+}
+
+void DynamicResolution::ensureTargets(int width, int height) {
+    if (m_sceneFBO && width == m_targetWidth && height == m_targetHeight) {
+        return;
+    }
+    releaseTargets();
+    m_targetWidth = width;
+    m_targetHeight = height;
+
+    glCreateTextures(GL_TEXTURE_2D, 1, &m_resolveTexture);
+    glTextureStorage2D(m_resolveTexture, 1, GL_RGBA8, width, height);
+    glTextureParameteri(m_resolveTexture, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTextureParameteri(m_resolveTexture, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTextureParameteri(m_resolveTexture, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTextureParameteri(m_resolveTexture, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glCreateFramebuffers(1, &m_resolveFBO);
+    glNamedFramebufferTexture(m_resolveFBO, GL_COLOR_ATTACHMENT0, m_resolveTexture, 0);
+
+    // Without multisampling the scene renders straight into the resolve target
+    glCreateRenderbuffers(1, &m_depthBuffer);
+    glNamedRenderbufferStorageMultisample(m_depthBuffer, m_samples, GL_DEPTH24_STENCIL8, width, height);
+    if (m_samples > 0) {
+        glCreateRenderbuffers(1, &m_colorBuffer);
+        glNamedRenderbufferStorageMultisample(m_colorBuffer, m_samples, GL_RGBA8, width, height);
+        glCreateFramebuffers(1, &m_sceneFBO);
+        glNamedFramebufferRenderbuffer(m_sceneFBO, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_colorBuffer);
+    } else {
+        m_sceneFBO = m_resolveFBO;
+    }
+    glNamedFramebufferRenderbuffer(m_sceneFBO, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, m_depthBuffer);
+
+    if (glCheckNamedFramebufferStatus(m_sceneFBO, GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE ||
+        glCheckNamedFramebufferStatus(m_resolveFBO, GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        std::cerr << "DynamicResolution: offscreen target incomplete, rendering at native resolution" << std::endl;
+        releaseTargets();
+        m_settings.enabled = false;
+    }
+}
+
+void DynamicResolution::releaseTargets() {
+    if (m_sceneFBO && m_sceneFBO != m_resolveFBO) {
+        glDeleteFramebuffers(1, &m_sceneFBO);
+    }
+    if (m_resolveFBO) {
+        glDeleteFramebuffers(1, &m_resolveFBO);
+    }
+    if (m_colorBuffer) {
+        glDeleteRenderbuffers(1, &m_colorBuffer);
+    }
+    if (m_depthBuffer) {
+        glDeleteRenderbuffers(1, &m_depthBuffer);
+    }
+    if (m_resolveTexture) {
+        glDeleteTextures(1, &m_resolveTexture);
+    }
+    m_sceneFBO = m_resolveFBO = m_colorBuffer = m_depthBuffer = m_resolveTexture = 0;
+    m_targetWidth = m_targetHeight = 0;
+}
+
+void DynamicResolution::readQueries() {
+    // Oldest first; stop at the first one the GPU has not finished
+    for (int i = 0; i < QUERY_COUNT; ++i) {
+        const int index = (m_queryIndex + i) % QUERY_COUNT;
+        if (!m_queryPending[index]) {
+            continue;
+        }
+        GLint available = 0;
+        glGetQueryObjectiv(m_queries[index], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) {
+            break;
+        }
+        GLuint64 nanoseconds = 0;
+        glGetQueryObjectui64v(m_queries[index], GL_QUERY_RESULT, &nanoseconds);
+        m_queryPending[index] = false;
+        updateScale(static_cast<float>(nanoseconds) * 1e-6f, m_queryScale[index]);
+    }
+}
+
+void DynamicResolution::updateScale(float gpuTimeMs, float scale) {
+    // Cost is proportional to the pixel count, i.e. to scale^2
+    const float fullScaleMs = gpuTimeMs / (scale * scale);
+    const bool first = (m_fullScaleMs == 0.0f);
+    m_gpuTimeMs = first ? gpuTimeMs : m_gpuTimeMs + (gpuTimeMs - m_gpuTimeMs) * TIME_SMOOTHING;
+    m_fullScaleMs = first ? fullScaleMs : m_fullScaleMs + (fullScaleMs - m_fullScaleMs) * TIME_SMOOTHING;
+    if (m_fullScaleMs <= 0.0f) {
+        return;
+    }
+
+    const float ideal = std::sqrt(m_settings.targetMs / m_fullScaleMs);
+    const float expectedMs = m_fullScaleMs * m_scale * m_scale;
+    float next = m_scale;
+    if (expectedMs > m_settings.targetMs) {
+        next = m_scale + (ideal - m_scale) * LOWER_GAIN;
+    } else if (expectedMs < m_settings.targetMs * RAISE_MARGIN) {
+        next = m_scale + (ideal - m_scale) * RAISE_GAIN;
+    }
+    next = std::clamp(next, m_settings.minScale, m_settings.maxScale);
+    if (std::abs(next - m_scale) >= MIN_STEP || next == m_settings.minScale || next == m_settings.maxScale) {
+        m_scale = next;
+    }
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "core/Shader.h"
+#include <glad/gl.h>
+#include <memory>
+
+// Renders the scene into an offscreen target whose resolution follows a GPU
+// frame-time target. The scene pass is timed with GL_TIME_ELAPSED queries,
+// read back a few frames later without stalling. Pixel cost grows with the
+// square of the scale, so each result is turned into an estimate of the
+// full-resolution time and the scale moves towards sqrt(target / estimate).
+// The target is allocated at the window size and the scene is drawn into its
+// lower-left corner, so scale changes only change the viewport. The result is
+// MSAA-resolved and upscaled to the window with a bilinear full-screen pass;
+// overlays drawn afterwards stay at native resolution.
+class DynamicResolution {
+public:
+    struct Settings {
+        bool enabled{true};
+        float targetMs{16.0f};   // Scene pass GPU time to hold
+        float minScale{0.5f};    // Per-axis resolution scale bounds
+        float maxScale{1.0f};
+    };
+
+    DynamicResolution() = default;
+    ~DynamicResolution();
+
+    DynamicResolution(const DynamicResolution&) = delete;
+    DynamicResolution& operator=(const DynamicResolution&) = delete;
+
+    void init();
+
+    void setSettings(const Settings& settings);
+    const Settings& getSettings() const { return m_settings; }
+    bool isEnabled() const { return m_settings.enabled; }
+
+    // Bind the offscreen target and set the viewport to the scaled size;
+    // fullScale draws this frame at maxScale (a still view) without
+    // resetting the scale adapted to motion
+    void beginScene(int windowWidth, int windowHeight, bool fullScale = false);
+
+    // Stop timing, update the scale and upscale into the default framebuffer
+    void endScene();
+
+    float getScale() const { return m_frameScale; }      // Of the last frame drawn
+    float getGpuTimeMs() const { return m_gpuTimeMs; }   // Smoothed, from the last finished query
+    int getRenderWidth() const { return m_renderWidth; }
+    int getRenderHeight() const { return m_renderHeight; }
+
+private:
+    static constexpr int QUERY_COUNT = 4;   // Frames a timing result may lag behind
+
+    void ensureTargets(int width, int height);
+    void releaseTargets();
+    void readQueries();
+    void updateScale(float gpuTimeMs, float scale);
+
+    Settings m_settings;
+    std::unique_ptr<Shader> m_upscaleShader;
+    GLuint m_emptyVAO{0};   // Full-screen triangle comes from gl_VertexID
+
+    // Scene target (multisampled like the window) and its single-sample resolve
+    GLint m_samples{0};
+    GLuint m_sceneFBO{0};
+    GLuint m_colorBuffer{0};
+    GLuint m_depthBuffer{0};
+    GLuint m_resolveFBO{0};
+    GLuint m_resolveTexture{0};
+    int m_targetWidth{0};
+    int m_targetHeight{0};
+
+    int m_windowWidth{0};
+    int m_windowHeight{0};
+    int m_renderWidth{0};
+    int m_renderHeight{0};
+    float m_scale{1.0f};
+    float m_frameScale{1.0f};
+
+    GLuint m_queries[QUERY_COUNT]{};
+    bool m_queryPending[QUERY_COUNT]{};
+    float m_queryScale[QUERY_COUNT]{};   // Scale the timed frame was rendered at
+    int m_queryIndex{0};
+    bool m_timing{false};   // Query running for the current frame
+    float m_gpuTimeMs{0.0f};
+    float m_fullScaleMs{0.0f};   // Smoothed time estimate at scale 1
+};
@@ -0,0 +1,266 @@
+#include "GeometryArena.h"
+#include <algorithm>
+#include <vector>
+
+namespace {
+    // Initial arena sizes; both grow by doubling
+    constexpr uint32_t INITIAL_VERTEX_CAPACITY = 1u << 16;
+    constexpr uint32_t INITIAL_INDEX_CAPACITY = 3u << 16;
+
+    // Unpinned meshes not drawn for this many frames give their space back
+    constexpr uint64_t RELEASE_AFTER_FRAMES = 120;
+    constexpr uint64_t RELEASE_CHECK_INTERVAL = 60;
+
+    // Compaction starts once less than this share of the free space is in
+    // the largest free range, and moves at most this much data per frame
+    constexpr double COMPACT_THRESHOLD = 0.75;
+    constexpr size_t COMPACT_BYTES_PER_FRAME = 4u << 20;
+
+    bool isFragmented(const RangeAllocator& allocator) {
+        const uint32_t free = allocator.getCapacity() - allocator.getUsed();
+        return allocator.getFreeRangeCount() > 1 &&
+               allocator.getLargestFreeRange() < COMPACT_THRESHOLD * free;
+    }
+}
+
+GeometryArena::~GeometryArena() {
+    for (GLuint vao : m_vao) {
+        if (vao) {
+            glDeleteVertexArrays(1, &vao);
+        }
+    }
+    if (m_vertices.buffer) {
+        glDeleteBuffers(1, &m_vertices.buffer);
+    }
+    for (Pool& indices : m_indices) {
+        if (indices.buffer) {
+            glDeleteBuffers(1, &indices.buffer);
+        }
+    }
+}
+
+void GeometryArena::init() {
+    m_vertices.elementSize = Mesh::getVertexStride();
+    m_indices[indexSlot(GL_UNSIGNED_SHORT)].elementSize = sizeof(uint16_t);
+    m_indices[indexSlot(GL_UNSIGNED_INT)].elementSize = sizeof(uint32_t);
+
+    growBuffer(m_vertices.buffer, 0, static_cast<size_t>(INITIAL_VERTEX_CAPACITY) * m_vertices.elementSize);
+    m_vertices.allocator.grow(INITIAL_VERTEX_CAPACITY);
+
+    for (int slot = 0; slot < 2; ++slot) {
+        Pool& indices = m_indices[slot];
+        growBuffer(indices.buffer, 0, static_cast<size_t>(INITIAL_INDEX_CAPACITY) * indices.elementSize);
+        indices.allocator.grow(INITIAL_INDEX_CAPACITY);
+
+        glCreateVertexArrays(1, &m_vao[slot]);
+        Mesh::setVertexFormat(m_vao[slot]);
+        glVertexArrayVertexBuffer(m_vao[slot], 0, m_vertices.buffer, 0, static_cast<GLsizei>(m_vertices.elementSize));
+        glVertexArrayElementBuffer(m_vao[slot], indices.buffer);
+    }
+}
+
+const GeometryArena::Range* GeometryArena::acquire(const Mesh* mesh) {
+    if (!mesh || !mesh->isValid()) {
+        return nullptr;
+    }
+
+    Allocation& allocation = m_allocations[mesh];
+
+    // New mesh, or its contents changed (also catches a reused address)
+    if (allocation.version != mesh->getVersion()) {
+        releaseRange(allocation);
+
+        Range& range = allocation.range;
+        const uint32_t vertexCount = mesh->getVertexCount();
+        const uint32_t indexCount = mesh->getIndexCount();
+        range.indexType = mesh->getIndexType();
+        Pool& indices = m_indices[indexSlot(range.indexType)];
+
+        bool placed = vertexCount > 0 && indexCount > 0 &&
+                      reserve(m_vertices, vertexCount, range.firstVertex);
+        if (placed) {
+            range.vertexCount = vertexCount;
+            placed = reserve(indices, indexCount, range.firstIndex);
+        }
+        if (!placed) {
+            releaseRange(allocation);
+            if (allocation.pinCount == 0) {
+                m_allocations.erase(mesh);
+            }
+            return nullptr;
+        }
+        range.indexCount = indexCount;
+        allocation.version = mesh->getVersion();
+
+        glCopyNamedBufferSubData(mesh->getVertexBuffer(), m_vertices.buffer, 0,
+                                 static_cast<GLintptr>(range.firstVertex) * m_vertices.elementSize,
+                                 static_cast<GLsizeiptr>(vertexCount) * m_vertices.elementSize);
+        glCopyNamedBufferSubData(mesh->getIndexBuffer(), indices.buffer, 0,
+                                 static_cast<GLintptr>(range.firstIndex) * indices.elementSize,
+                                 static_cast<GLsizeiptr>(indexCount) * indices.elementSize);
+    }
+
+    allocation.lastUsedFrame = m_frame;
+    return &allocation.range;
+}
+
+void GeometryArena::pin(const Mesh* mesh) {
+    auto it = m_allocations.find(mesh);
+    if (it != m_allocations.end()) {
+        ++it->second.pinCount;
+    }
+}
+
+void GeometryArena::unpin(const Mesh* mesh) {
+    auto it = m_allocations.find(mesh);
+    if (it != m_allocations.end() && it->second.pinCount > 0) {
+        --it->second.pinCount;
+        it->second.lastUsedFrame = m_frame;
+    }
+}
+
+void GeometryArena::endFrame() {
+    ++m_frame;
+
+    size_t budget = COMPACT_BYTES_PER_FRAME;
+    compact(m_vertices, budget);
+    for (Pool& indices : m_indices) {
+        compact(indices, budget);
+    }
+
+    if (m_frame % RELEASE_CHECK_INTERVAL != 0) {
+        return;
+    }
+
+    for (auto it = m_allocations.begin(); it != m_allocations.end();) {
+        if (it->second.pinCount == 0 && m_frame - it->second.lastUsedFrame > RELEASE_AFTER_FRAMES) {
+            releaseRange(it->second);
+            it = m_allocations.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+const GeometryArena::Range* GeometryArena::find(const Mesh* mesh) const {
+    auto it = m_allocations.find(mesh);
+    if (it == m_allocations.end() || it->second.range.firstVertex == RangeAllocator::INVALID_OFFSET) {
+        return nullptr;
+    }
+    return &it->second.range;
+}
+
+uint64_t GeometryArena::getUsedBytes() const {
+    uint64_t bytes = static_cast<uint64_t>(m_vertices.allocator.getUsed()) * m_vertices.elementSize;
+    for (const Pool& indices : m_indices) {
+        bytes += static_cast<uint64_t>(indices.allocator.getUsed()) * indices.elementSize;
+    }
+    return bytes;
+}
+
+void GeometryArena::releaseRange(Allocation& allocation) {
+    Range& range = allocation.range;
+    Pool& indices = m_indices[indexSlot(range.indexType)];
+    m_vertices.compactStalled = false;
+    indices.compactStalled = false;
+    if (range.firstVertex != RangeAllocator::INVALID_OFFSET) {
+        m_vertices.allocator.free(range.firstVertex, range.vertexCount);
+    }
+    if (range.firstIndex != RangeAllocator::INVALID_OFFSET) {
+        indices.allocator.free(range.firstIndex, range.indexCount);
+    }
+    range = Range{RangeAllocator::INVALID_OFFSET, 0, RangeAllocator::INVALID_OFFSET, 0, GL_UNSIGNED_INT};
+    allocation.version = 0;
+}
+
+bool GeometryArena::reserve(Pool& pool, uint32_t count, uint32_t& offset) {
+    offset = pool.allocator.allocate(count);
+    while (offset == RangeAllocator::INVALID_OFFSET) {
+        const uint64_t oldCapacity = pool.allocator.getCapacity();
+        const uint64_t newCapacity = std::max(oldCapacity * 2, oldCapacity + count);
+        if (newCapacity >= RangeAllocator::INVALID_OFFSET) {
+            return false;
+        }
+
+        growBuffer(pool.buffer, oldCapacity * pool.elementSize, newCapacity * pool.elementSize);
+        if (&pool == &m_vertices) {
+            for (GLuint vao : m_vao) {
+                glVertexArrayVertexBuffer(vao, 0, m_vertices.buffer, 0, static_cast<GLsizei>(m_vertices.elementSize));
+            }
+        } else {
+            glVertexArrayElementBuffer(m_vao[&pool - m_indices], pool.buffer);
+        }
+        pool.allocator.grow(static_cast<uint32_t>(newCapacity));
+        offset = pool.allocator.allocate(count);
+    }
+    return true;
+}
+
+void GeometryArena::growBuffer(GLuint& buffer, size_t oldBytes, size_t newBytes) {
+    GLuint newBuffer = 0;
+    glCreateBuffers(1, &newBuffer);
+    glNamedBufferStorage(newBuffer, static_cast<GLsizeiptr>(newBytes), nullptr, 0);
+
+    if (buffer) {
+        if (oldBytes > 0) {
+            glCopyNamedBufferSubData(buffer, newBuffer, 0, 0, static_cast<GLsizeiptr>(oldBytes));
+        }
+        glDeleteBuffers(1, &buffer);
+    }
+    buffer = newBuffer;
+}
+
+void GeometryArena::compact(Pool& pool, size_t& budgetBytes) {
+    RangeAllocator& allocator = pool.allocator;
+    if (pool.compactStalled || budgetBytes == 0 || !isFragmented(allocator)) {
+        return;
+    }
+
+    const bool vertices = &pool == &m_vertices;
+    auto offsetOf = [vertices](Allocation& allocation) -> uint32_t& {
+        return vertices ? allocation.range.firstVertex : allocation.range.firstIndex;
+    };
+
+    // Highest ranges move first, so the trailing free range keeps growing
+    std::vector<Allocation*> order;
+    order.reserve(m_allocations.size());
+    for (auto& entry : m_allocations) {
+        const bool inPool = vertices || &m_indices[indexSlot(entry.second.range.indexType)] == &pool;
+        if (inPool && offsetOf(entry.second) != RangeAllocator::INVALID_OFFSET) {
+            order.push_back(&entry.second);
+        }
+    }
+    std::sort(order.begin(), order.end(), [&](Allocation* a, Allocation* b) {
+        return offsetOf(*a) > offsetOf(*b);
+    });
+
+    bool moved = false;
+    for (Allocation* allocation : order) {
+        if (budgetBytes == 0 || !isFragmented(allocator)) {
+            return;
+        }
+
+        uint32_t& offset = offsetOf(*allocation);
+        const uint32_t count = vertices ? allocation->range.vertexCount : allocation->range.indexCount;
+        const uint32_t target = allocator.allocateBelow(count, offset);
+        if (target == RangeAllocator::INVALID_OFFSET) {
+            continue;
+        }
+
+        // Source and destination do not overlap: the target was free
+        const size_t bytes = static_cast<size_t>(count) * pool.elementSize;
+        glCopyNamedBufferSubData(pool.buffer, pool.buffer, static_cast<GLintptr>(offset) * pool.elementSize,
+                                 static_cast<GLintptr>(target) * pool.elementSize, static_cast<GLsizeiptr>(bytes));
+        allocator.free(offset, count);
+        offset = target;
+        moved = true;
+
+        if (allocation->pinCount > 0) {
+            ++m_layoutVersion;
+        }
+        budgetBytes -= std::min(budgetBytes, bytes);
+    }
+
+    // No range fits into a lower hole; retry once something is released
+    pool.compactStalled = !moved;
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "mesh/Mesh.h"
+#include "util/RangeAllocator.h"
+#include <glad/gl.h>
+#include <cstdint>
+#include <unordered_map>
+
+// Shared vertex and index buffers holding copies of scene meshes for the
+// batched draw paths. Meshes are copied GPU to GPU the first time they are
+// acquired (and again if their contents change); indices stay mesh-local and
+// are offset with baseVertex. Indices keep the mesh's type: 16-bit and 32-bit
+// indices live in separate buffers, each bound to its own VAO over the shared
+// vertex buffer, so one multi-draw covers one index type. All buffers grow by
+// doubling.
+//
+// Released ranges leave holes. When the free space of a buffer is split up,
+// endFrame() compacts it a few megabytes at a time: the highest ranges are
+// copied GPU-side into the lowest holes that fit, so free space collects at
+// the end and large meshes fit without growing the buffer.
+class GeometryArena {
+public:
+    struct Range {
+        uint32_t firstVertex;
+        uint32_t vertexCount;
+        uint32_t firstIndex;
+        uint32_t indexCount;
+        GLenum indexType;
+    };
+
+    GeometryArena() = default;
+    ~GeometryArena();
+
+    GeometryArena(const GeometryArena&) = delete;
+    GeometryArena& operator=(const GeometryArena&) = delete;
+
+    void init();
+
+    // Make the mesh resident and mark it used; nullptr if it cannot be placed
+    const Range* acquire(const Mesh* mesh);
+
+    // Pinned meshes are never released as unused (for ranges stored in GPU
+    // tables). Pin after a successful acquire; calls must be balanced.
+    void pin(const Mesh* mesh);
+    void unpin(const Mesh* mesh);
+
+    // Call once per frame: frees unpinned ranges that were not used recently
+    // (including those of destroyed meshes) and continues compaction
+    void endFrame();
+
+    // Current range of a resident mesh, without marking it used; the mesh
+    // itself is not accessed, so it may already be destroyed
+    const Range* find(const Mesh* mesh) const;
+
+    // Changes whenever compaction moves a pinned range; holders of stored
+    // ranges re-read them with find()
+    uint64_t getLayoutVersion() const { return m_layoutVersion; }
+
+    // VAO drawing ranges of the given index type
+    GLuint getVAO(GLenum indexType) const { return m_vao[indexSlot(indexType)]; }
+    uint64_t getUsedBytes() const;
+
+private:
+    struct Allocation {
+        Range range{RangeAllocator::INVALID_OFFSET, 0, RangeAllocator::INVALID_OFFSET, 0, GL_UNSIGNED_INT};
+        uint64_t version{0};
+        uint64_t lastUsedFrame{0};
+        uint32_t pinCount{0};
+    };
+
+    // One buffer and the allocator of its elements
+    struct Pool {
+        GLuint buffer{0};
+        RangeAllocator allocator;
+        size_t elementSize{0};
+        bool compactStalled{false};
+    };
+
+    // 16-bit indices in slot 0, 32-bit in slot 1
+    static int indexSlot(GLenum indexType) { return indexType == GL_UNSIGNED_SHORT ? 0 : 1; }
+
+    void releaseRange(Allocation& allocation);
+    bool reserve(Pool& pool, uint32_t count, uint32_t& offset);
+    static void growBuffer(GLuint& buffer, size_t oldBytes, size_t newBytes);
+
+    // Move ranges of one pool towards its start, up to budget bytes
+    void compact(Pool& pool, size_t& budgetBytes);
+
+    GLuint m_vao[2]{};
+    Pool m_vertices;
+    Pool m_indices[2];
+
+    std::unordered_map<const Mesh*, Allocation> m_allocations;
+    uint64_t m_frame{0};
+    uint64_t m_layoutVersion{0};
+};
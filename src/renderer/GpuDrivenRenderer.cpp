@@ -0,0 +1,716 @@
+#include "GpuDrivenRenderer.h"
+#include "core/TextureManager.h"
+#include "lod/LODSelector.h"
+#include "util/Hash.h"
+#include <algorithm>
+#include <string>
+
+namespace {
+    constexpr GLuint OBJECT_BINDING = 0;
+    constexpr GLuint RANGE_BINDING = 1;
+    constexpr GLuint LOD_STATE_BINDING = 2;
+    constexpr GLuint COMMAND_BINDING = 3;
+    constexpr GLuint COUNT_BINDING = 4;
+    constexpr GLuint GROUP_BINDING = 5;
+    constexpr GLuint VISIBILITY_BINDING = 6;
+    constexpr GLuint OCCLUSION_BINDING = 7;
+    constexpr GLuint DRAWN_RANGE_BINDING = 8;
+    constexpr GLuint CLUSTER_BINDING = 9;
+
+    constexpr uint32_t WORKGROUP_SIZE = 64;  // local_size_x in cull.comp and cluster_cull.comp
+    constexpr uint32_t MIN_OBJECT_CAPACITY = 1024;
+    constexpr uint32_t MIN_GROUP_CAPACITY = 16;
+    constexpr uint32_t MIN_COMMAND_CAPACITY = 2048;
+    constexpr uint32_t MIN_CLUSTER_CAPACITY = 4096;
+
+    // Ranges with fewer meshlets are drawn whole: culling a few clusters
+    // saves less than the extra draw commands cost
+    constexpr uint32_t MIN_RANGE_CLUSTERS = 32;
+
+    // Relative difference of the axis scales up to which cone tests stay valid
+    constexpr float UNIFORM_SCALE_TOLERANCE = 1e-3f;
+
+    uint32_t visibilityWords(uint32_t objectCount) {
+        return (objectCount + 31) / 32;
+    }
+
+    void createBuffer(GLuint& buffer, size_t bytes) {
+        if (buffer) {
+            glDeleteBuffers(1, &buffer);
+        }
+        glCreateBuffers(1, &buffer);
+        glNamedBufferStorage(buffer, static_cast<GLsizeiptr>(bytes), nullptr, GL_DYNAMIC_STORAGE_BIT);
+    }
+
+    void deleteBuffer(GLuint& buffer) {
+        if (buffer) {
+            glDeleteBuffers(1, &buffer);
+            buffer = 0;
+        }
+    }
+
+    // Normal cones only survive transforms that keep angles: rotation, translation
+    // and uniform scale (a mirroring matrix also flips which side is the front)
+    bool preservesAngles(const glm::mat4& model) {
+        const glm::vec3 scale(glm::length(glm::vec3(model[0])), glm::length(glm::vec3(model[1])),
+                              glm::length(glm::vec3(model[2])));
+        const float maxScale = std::max({scale.x, scale.y, scale.z});
+        const float minScale = std::min({scale.x, scale.y, scale.z});
+        return minScale > 0.0f && maxScale - minScale <= UNIFORM_SCALE_TOLERANCE * maxScale &&
+               glm::determinant(glm::mat3(model)) > 0.0f;
+    }
+}
+
+GpuDrivenRenderer::~GpuDrivenRenderer() {
+    if (m_readbackFence) {
+        glDeleteSync(m_readbackFence);
+    }
+    if (m_readbackPtr) {
+        glUnmapNamedBuffer(m_readbackBuffer);
+    }
+    deleteBuffer(m_objectBuffer);
+    deleteBuffer(m_rangeBuffer);
+    deleteBuffer(m_lodStateBuffer);
+    deleteBuffer(m_commandBuffer);
+    deleteBuffer(m_countBuffer);
+    deleteBuffer(m_groupBuffer);
+    deleteBuffer(m_visibilityBuffer);
+    deleteBuffer(m_occlusionBuffer);
+    deleteBuffer(m_drawnRangeBuffer);
+    deleteBuffer(m_clusterBuffer);
+    deleteBuffer(m_readbackBuffer);
+}
+
+void GpuDrivenRenderer::init(GeometryArena* arena) {
+    m_arena = arena;
+    m_cullShader = std::make_unique<Shader>("shaders/cull.comp");
+    m_clusterShader = std::make_unique<Shader>("shaders/cluster_cull.comp");
+
+    // LOD switch thresholds never change; same values as LODSelector::selectLOD
+    const float thresholds[] = {
+        LODSelector::LOD0_THRESHOLD, LODSelector::LOD1_THRESHOLD, LODSelector::LOD2_THRESHOLD,
+        LODSelector::LOD3_THRESHOLD, LODSelector::LOD4_THRESHOLD
+    };
+    m_cullShader->use();
+    for (int i = 0; i < 6; ++i) {
+        const std::string index = "[" + std::to_string(i) + "]";
+        const float threshold = (i < 5) ? thresholds[i] : 0.0f;
+        m_cullShader->setFloat("thresholdsUp" + index, threshold * (1.0f + LODSelector::HYSTERESIS));
+        m_cullShader->setFloat("thresholdsDown" + index, threshold * (1.0f - LODSelector::HYSTERESIS));
+    }
+    glUseProgram(0);
+}
+
+void GpuDrivenRenderer::render(const Scene& scene, const FrameParams& params, const Shader& shader) {
+    m_drawCalls = 0;
+
+    readBack();
+    syncScene(scene, params);
+    updateTextures(params);
+    uploadChanges();
+
+    const uint32_t objectCount = static_cast<uint32_t>(m_slots.size());
+    if (objectCount == 0) {
+        m_stats.fill(0);
+        m_visibleBits.clear();
+        return;
+    }
+
+    // ========== Cull pass ==========
+    const uint32_t words = visibilityWords(objectCount);
+    const GLsizeiptr countBytes = static_cast<GLsizeiptr>(STATS_COUNT + 2 * m_groups.size()) * sizeof(uint32_t);
+    glClearNamedBufferSubData(m_countBuffer, GL_R32UI, 0, countBytes, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+    glClearNamedBufferSubData(m_visibilityBuffer, GL_R32UI, 0, static_cast<GLsizeiptr>(words) * sizeof(uint32_t),
+                              GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+
+    m_cullShader->use();
+    m_cullShader->setUInt("objectCount", objectCount);
+    m_cullShader->setBool("frustumCulling", params.frustumCulling && params.frustum);
+    if (params.frustum) {
+        const auto& planes = params.frustum->getPlanes();
+        for (size_t i = 0; i < planes.size(); ++i) {
+            m_cullShader->setVec4("frustumPlanes[" + std::to_string(i) + "]", planes[i]);
+        }
+    }
+
+    // Occluded objects as a bitmask; the list is only a few entries, so the
+    // whole mask is rewritten each frame
+    const bool occlusionCulling = params.occluded && !params.occluded->empty();
+    if (occlusionCulling) {
+        m_occlusionBits.assign(words, 0u);
+        for (uint32_t index : *params.occluded) {
+            if (index < objectCount) {
+                m_occlusionBits[index >> 5] |= 1u << (index & 31u);
+            }
+        }
+        glNamedBufferSubData(m_occlusionBuffer, 0, static_cast<GLsizeiptr>(words) * sizeof(uint32_t),
+                             m_occlusionBits.data());
+    }
+    m_cullShader->setBool("occlusionCulling", occlusionCulling);
+    m_cullShader->setBool("lodEnabled", params.lodEnabled);
+    const bool clusterCulling = params.clusterCulling && m_clusterAllocator.getUsed() > 0;
+    m_cullShader->setBool("clusterCulling", clusterCulling);
+    m_cullShader->setMat4("view", params.view);
+    m_cullShader->setFloat("projScale", params.projection[1][1]);
+    // Projected size is linear in screenHeight, so the LOD bias folds into it
+    m_cullShader->setFloat("screenHeight", static_cast<float>(params.screenHeight) * params.lodScale);
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, OBJECT_BINDING, m_objectBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, RANGE_BINDING, m_rangeBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, LOD_STATE_BINDING, m_lodStateBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, COMMAND_BINDING, m_commandBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, COUNT_BINDING, m_countBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, GROUP_BINDING, m_groupBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, VISIBILITY_BINDING, m_visibilityBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, OCCLUSION_BINDING, m_occlusionBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, DRAWN_RANGE_BINDING, m_drawnRangeBuffer);
+
+    glDispatchCompute((objectCount + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE, 1, 1);
+
+    // ========== Cluster pass ==========
+    // One invocation per cluster record; only those of ranges the cull pass
+    // left to it are tested, the rest return at once
+    if (clusterCulling) {
+        glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+        const uint32_t clusterCount = m_clusterAllocator.getCapacity();
+        m_clusterShader->use();
+        m_clusterShader->setUInt("clusterCount", clusterCount);
+        m_clusterShader->setUInt("objectCount", objectCount);
+        m_clusterShader->setBool("frustumCulling", params.frustumCulling && params.frustum);
+        if (params.frustum) {
+            const auto& planes = params.frustum->getPlanes();
+            for (size_t i = 0; i < planes.size(); ++i) {
+                m_clusterShader->setVec4("frustumPlanes[" + std::to_string(i) + "]", planes[i]);
+            }
+        }
+        m_clusterShader->setBool("coneCulling", params.coneCulling);
+        m_clusterShader->setVec3("cameraPosition", glm::vec3(glm::inverse(params.view)[3]));
+
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, CLUSTER_BINDING, m_clusterBuffer);
+        glDispatchCompute((clusterCount + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE, 1, 1);
+    }
+    glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT);
+
+    // Copy stats and visibility for the CPU; read back once the fence signals
+    if (!m_readbackFence) {
+        glCopyNamedBufferSubData(m_countBuffer, m_readbackBuffer, 0, 0, STATS_COUNT * sizeof(uint32_t));
+        glCopyNamedBufferSubData(m_visibilityBuffer, m_readbackBuffer, 0, STATS_COUNT * sizeof(uint32_t),
+                                 static_cast<GLsizeiptr>(words) * sizeof(uint32_t));
+        m_readbackFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        m_readbackWords = words;
+    }
+
+    // ========== Draw pass ==========
+    // Object, range and LOD state buffers stay bound at bindings 0-2 for the vertex shader
+    shader.use();
+    shader.setBool("lodDebugColors", params.lodDebugColors);
+
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_commandBuffer);
+    glBindBuffer(GL_PARAMETER_BUFFER, m_countBuffer);
+    if (params.wireframe) {
+        glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+    }
+
+    GLuint boundVAO = 0;
+    for (size_t g = 0; g < m_groups.size(); ++g) {
+        const Group& group = m_groups[g];
+        if (group.size == 0) {
+            continue;
+        }
+
+        // Evicted textures stay grouped until the object is seen again
+        const Texture* texture = group.texture;
+        if (texture && !texture->isValid()) {
+            texture = params.defaultTexture;
+        }
+        if (texture) {
+            texture->bind(0);
+        }
+
+        // 16-bit list, then the 32-bit list if any member needs it
+        for (uint32_t wide = 0; wide < 2; ++wide) {
+            const uint32_t listSize = wide ? group.wideSize : group.size;
+            if (listSize == 0) {
+                continue;
+            }
+
+            const GLenum indexType = wide ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT;
+            const GLuint vao = m_arena->getVAO(indexType);
+            if (vao != boundVAO) {
+                glBindVertexArray(vao);
+                boundVAO = vao;
+            }
+
+            const uint32_t listOffset = wide ? group.wideOffset : group.offset;
+            glMultiDrawElementsIndirectCount(GL_TRIANGLES, indexType,
+                                             reinterpret_cast<const void*>(listOffset * sizeof(DrawCommand)),
+                                             static_cast<GLintptr>((STATS_COUNT + 2 * g + wide) * sizeof(uint32_t)),
+                                             static_cast<GLsizei>(listSize), 0);
+            ++m_drawCalls;
+        }
+    }
+
+    if (params.wireframe) {
+        glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+    }
+    glBindBuffer(GL_PARAMETER_BUFFER, 0);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+    glBindVertexArray(0);
+}
+
+void GpuDrivenRenderer::syncScene(const Scene& scene, const FrameParams& params) {
+    const auto& objects = scene.getObjects();
+    const uint32_t objectCount = static_cast<uint32_t>(objects.size());
+
+    // Toggling textures moves every object to another group
+    const bool regroup = params.texturesEnabled != m_texturesEnabled;
+    m_texturesEnabled = params.texturesEnabled;
+
+    // Arena compaction moved pinned ranges the range table still points at
+    const bool relayout = m_arena->getLayoutVersion() != m_arenaLayout;
+    m_arenaLayout = m_arena->getLayoutVersion();
+
+    // Nothing changed since the last sync: no per-object work at all
+    if (!regroup && !relayout && objectCount == m_slots.size() &&
+        SceneObject::getLatestRevision() == m_syncedRevision) {
+        return;
+    }
+
+    for (size_t i = objectCount; i < m_slots.size(); ++i) {
+        releaseSlot(m_slots[i]);
+    }
+    m_slots.resize(objectCount);
+    m_records.resize(objectCount);
+    m_ranges.resize(static_cast<size_t>(objectCount) * RANGES_PER_OBJECT);
+    ensureCapacity(objectCount);
+
+    m_texturedSlots.clear();
+    for (uint32_t i = 0; i < objectCount; ++i) {
+        SceneObject& object = *objects[i];
+        const Slot& slot = m_slots[i];
+
+        if (slot.object != &object || slot.revision != object.getRevision()) {
+            writeSlot(i, object, params);
+        } else if (relayout) {
+            refreshRanges(i);
+        }
+        if (regroup) {
+            assignGroup(i, baseTexture(params));
+        }
+        if (object.hasTexture()) {
+            m_texturedSlots.push_back(i);
+        }
+    }
+
+    m_syncedRevision = SceneObject::getLatestRevision();
+}
+
+void GpuDrivenRenderer::writeSlot(uint32_t index, SceneObject& object, const FrameParams& params) {
+    Slot& slot = m_slots[index];
+
+    // Keep a resolved texture while the object still references the same file
+    const Texture* texture = baseTexture(params);
+    if (slot.object == &object && slot.textureEntry && slot.textureEntry == object.getTexture().get()) {
+        texture = slot.texture;
+    }
+
+    for (uint32_t i = 0; i < slot.meshCount; ++i) {
+        m_arena->unpin(slot.meshes[i]);
+    }
+    slot.meshCount = 0;
+
+    MeshRange* ranges = &m_ranges[static_cast<size_t>(index) * RANGES_PER_OBJECT];
+    std::fill(ranges, ranges + RANGES_PER_OBJECT,
+              MeshRange{0, 0, 0, 0, 0, {0, 0, 0}, glm::vec4(0.0f), glm::vec4(1.0f)});
+
+    auto addMesh = [&](const Mesh* mesh) {
+        const GeometryArena::Range* range = m_arena->acquire(mesh);
+        if (!range) {
+            return false;
+        }
+        m_arena->pin(mesh);
+        const glm::mat4 transform = mesh->getPositionTransform();
+        const uint32_t wideIndices = range->indexType == GL_UNSIGNED_INT ? 1u : 0u;
+        ranges[slot.meshCount] = MeshRange{range->firstIndex, range->indexCount,
+                                           static_cast<int32_t>(range->firstVertex), wideIndices, 0, {0, 0, 0},
+                                           transform[3], glm::vec4(transform[0][0], transform[1][1], transform[2][2], 0.0f)};
+        slot.meshes[slot.meshCount++] = mesh;
+        return true;
+    };
+
+    // Base mesh first, then every LOD level; the cull pass picks the level
+    const bool drawable = object.isVisible() && addMesh(object.getMesh());
+    uint32_t lodCount = 0;
+    if (drawable && object.hasLOD()) {
+        LODMesh& lodMesh = object.getLODMesh();
+        const uint32_t levels = static_cast<uint32_t>(
+            std::min(lodMesh.getLevelCount(), static_cast<size_t>(RANGES_PER_OBJECT - 1)));
+
+        bool complete = true;
+        for (uint32_t level = 0; level < levels && complete; ++level) {
+            complete = addMesh(lodMesh.getLevel(level)->getMesh());
+        }
+        lodCount = complete ? levels : 0;
+    }
+
+    const BoundingBox& bounds = object.getWorldBounds();
+    ObjectRecord& record = m_records[index];
+    record.model = object.getModelMatrix();
+    record.normalMatrix = glm::mat4(object.getNormalMatrix());
+    record.color = glm::vec4(object.getColor(), 1.0f);
+    record.boundsMin = glm::vec4(bounds.min, 0.0f);
+    record.boundsMax = glm::vec4(bounds.max, 0.0f);
+    record.lodCount = lodCount;
+    record.flags = (drawable ? FLAG_DRAWABLE : 0u) | (object.isSelected() ? FLAG_SELECTED : 0u) |
+                   (object.isHovered() ? FLAG_HOVERED : 0u) |
+                   (preservesAngles(record.model) ? FLAG_CONE_CULLING : 0u);
+    record.reserved = 0;
+
+    slot.object = &object;
+    slot.revision = object.getRevision();
+    slot.textureEntry = object.getTexture().get();
+
+    assignGroup(index, texture);
+    record.group = slot.group;
+
+    bool wide = false;
+    for (uint32_t i = 0; i < slot.meshCount; ++i) {
+        wide = wide || ranges[i].wideIndices != 0;
+    }
+    setCommandSlots(index, wide, writeClusters(index));
+    markDirty(index);
+}
+
+uint32_t GpuDrivenRenderer::writeClusters(uint32_t index) {
+    Slot& slot = m_slots[index];
+    MeshRange* ranges = &m_ranges[static_cast<size_t>(index) * RANGES_PER_OBJECT];
+
+    // Mesh versions are unique, so equal keys mean the same meshlets
+    uint64_t key = 0;
+    uint32_t total = 0;
+    uint32_t commandSlots = 1;  // A frame draws at most every cluster of one range
+    for (uint32_t i = 0; i < slot.meshCount; ++i) {
+        key = Hash::combine(key, slot.meshes[i]->getVersion());
+        const uint32_t meshlets = static_cast<uint32_t>(slot.meshes[i]->getMeshlets().size());
+        if (meshlets >= MIN_RANGE_CLUSTERS) {
+            ranges[i].clusterCount = meshlets;
+            total += meshlets;
+            commandSlots = std::max(commandSlots, meshlets);
+        }
+    }
+
+    // Transform, selection or hover changes keep the records
+    if (total > 0 && slot.clusterCount == total && slot.clusterKey == key) {
+        return commandSlots;
+    }
+
+    releaseClusters(slot);
+    if (total == 0) {
+        return 1;
+    }
+
+    slot.clusterOffset = allocateClusters(total);
+    slot.clusterCount = total;
+    slot.clusterKey = key;
+    markClustersDirty(slot.clusterOffset, total);
+
+    uint32_t next = slot.clusterOffset;
+    for (uint32_t i = 0; i < slot.meshCount; ++i) {
+        if (ranges[i].clusterCount == 0) {
+            continue;
+        }
+
+        const uint32_t rangeIndex = index * RANGES_PER_OBJECT + i;
+        for (const Meshlet& meshlet : slot.meshes[i]->getMeshlets()) {
+            m_clusters[next++] = ClusterRecord{glm::vec4(meshlet.center, meshlet.radius),
+                                               glm::vec4(meshlet.coneApex, meshlet.coneCutoff),
+                                               glm::vec4(meshlet.coneAxis, 0.0f),
+                                               meshlet.firstIndex, meshlet.indexCount, rangeIndex, 0};
+        }
+    }
+    return commandSlots;
+}
+
+void GpuDrivenRenderer::releaseClusters(Slot& slot) {
+    if (slot.clusterCount == 0) {
+        return;
+    }
+
+    std::fill(m_clusters.begin() + slot.clusterOffset,
+              m_clusters.begin() + slot.clusterOffset + slot.clusterCount, unusedCluster());
+    markClustersDirty(slot.clusterOffset, slot.clusterCount);
+    m_clusterAllocator.free(slot.clusterOffset, slot.clusterCount);
+
+    slot.clusterOffset = RangeAllocator::INVALID_OFFSET;
+    slot.clusterCount = 0;
+}
+
+uint32_t GpuDrivenRenderer::allocateClusters(uint32_t count) {
+    uint32_t offset = m_clusterAllocator.allocate(count);
+    if (offset != RangeAllocator::INVALID_OFFSET) {
+        return offset;
+    }
+
+    // Grow by at least the request, so it fits at the new end
+    const uint32_t oldCapacity = m_clusterAllocator.getCapacity();
+    const uint32_t capacity = std::max({oldCapacity * 2, oldCapacity + count, MIN_CLUSTER_CAPACITY});
+    m_clusterAllocator.grow(capacity);
+    m_clusters.resize(capacity, unusedCluster());
+    createBuffer(m_clusterBuffer, static_cast<size_t>(capacity) * sizeof(ClusterRecord));
+
+    // New buffer holds nothing yet: upload every record
+    markClustersDirty(0, capacity);
+    return m_clusterAllocator.allocate(count);
+}
+
+GpuDrivenRenderer::ClusterRecord GpuDrivenRenderer::unusedCluster() {
+    // Matches no drawn range, so the cluster pass skips it
+    return ClusterRecord{glm::vec4(0.0f), glm::vec4(0.0f, 0.0f, 0.0f, 1.0f), glm::vec4(0.0f), 0, 0, NO_RANGE, 0};
+}
+
+void GpuDrivenRenderer::markClustersDirty(uint32_t offset, uint32_t count) {
+    m_clusterDirtyMin = std::min(m_clusterDirtyMin, offset);
+    m_clusterDirtyMax = std::max(m_clusterDirtyMax, offset + count - 1);
+}
+
+void GpuDrivenRenderer::refreshRanges(uint32_t index) {
+    const Slot& slot = m_slots[index];
+    MeshRange* ranges = &m_ranges[static_cast<size_t>(index) * RANGES_PER_OBJECT];
+
+    bool changed = false;
+    for (uint32_t i = 0; i < slot.meshCount; ++i) {
+        const GeometryArena::Range* range = m_arena->find(slot.meshes[i]);
+        if (range && (ranges[i].firstIndex != range->firstIndex ||
+                      ranges[i].baseVertex != static_cast<int32_t>(range->firstVertex))) {
+            ranges[i].firstIndex = range->firstIndex;
+            ranges[i].baseVertex = static_cast<int32_t>(range->firstVertex);
+            changed = true;
+        }
+    }
+    if (changed) {
+        markDirty(index);
+    }
+}
+
+void GpuDrivenRenderer::releaseSlot(Slot& slot) {
+    for (uint32_t i = 0; i < slot.meshCount; ++i) {
+        m_arena->unpin(slot.meshes[i]);
+    }
+    releaseClusters(slot);
+    if (slot.group != NO_GROUP) {
+        m_groups[slot.group].size -= slot.commandSlots;
+        if (slot.wideIndices) {
+            m_groups[slot.group].wideSize -= slot.commandSlots;
+        }
+        m_groupsDirty = true;
+    }
+    slot = Slot{};
+}
+
+void GpuDrivenRenderer::updateTextures(const FrameParams& params) {
+    if (!params.texturesEnabled || !params.textureManager) {
+        return;
+    }
+
+    // Only objects seen last frame request their texture, so textures of
+    // culled objects are never loaded (and age out of the budget)
+    for (uint32_t index : m_texturedSlots) {
+        if (!wasVisible(index)) {
+            continue;
+        }
+        const Texture* texture = params.textureManager->use(m_slots[index].object->getTexture());
+        assignGroup(index, texture ? texture : baseTexture(params));
+    }
+}
+
+void GpuDrivenRenderer::assignGroup(uint32_t index, const Texture* texture) {
+    Slot& slot = m_slots[index];
+    if (slot.group != NO_GROUP && slot.texture == texture) {
+        return;
+    }
+
+    if (slot.group != NO_GROUP) {
+        m_groups[slot.group].size -= slot.commandSlots;
+        if (slot.wideIndices) {
+            m_groups[slot.group].wideSize -= slot.commandSlots;
+        }
+    }
+
+    uint32_t group = 0;
+    auto it = m_groupIndex.find(texture);
+    if (it != m_groupIndex.end()) {
+        group = it->second;
+    } else {
+        group = static_cast<uint32_t>(m_groups.size());
+        m_groups.push_back(Group{texture, 0, 0});
+        m_groupIndex.emplace(texture, group);
+    }
+
+    m_groups[group].size += slot.commandSlots;
+    if (slot.wideIndices) {
+        m_groups[group].wideSize += slot.commandSlots;
+    }
+    slot.texture = texture;
+    slot.group = group;
+    m_records[index].group = group;
+    m_groupsDirty = true;
+    markDirty(index);
+}
+
+void GpuDrivenRenderer::setCommandSlots(uint32_t index, bool wide, uint32_t commandSlots) {
+    Slot& slot = m_slots[index];
+    if (slot.wideIndices == wide && slot.commandSlots == commandSlots) {
+        return;
+    }
+
+    if (slot.group != NO_GROUP) {
+        Group& group = m_groups[slot.group];
+        group.size = group.size - slot.commandSlots + commandSlots;
+        if (slot.wideIndices) {
+            group.wideSize -= slot.commandSlots;
+        }
+        if (wide) {
+            group.wideSize += commandSlots;
+        }
+        m_groupsDirty = true;
+    }
+    slot.wideIndices = wide;
+    slot.commandSlots = commandSlots;
+}
+
+void GpuDrivenRenderer::markDirty(uint32_t index) {
+    m_dirtyMin = std::min(m_dirtyMin, index);
+    m_dirtyMax = std::max(m_dirtyMax, index);
+}
+
+void GpuDrivenRenderer::uploadChanges() {
+    // One contiguous upload covering every rewritten slot
+    const uint32_t dirtyMax = std::min(m_dirtyMax, static_cast<uint32_t>(m_slots.size()) - 1);
+    if (!m_slots.empty() && m_dirtyMin <= dirtyMax) {
+        const size_t first = m_dirtyMin;
+        const size_t count = static_cast<size_t>(dirtyMax - m_dirtyMin) + 1;
+        glNamedBufferSubData(m_objectBuffer, first * sizeof(ObjectRecord),
+                             count * sizeof(ObjectRecord), &m_records[first]);
+        glNamedBufferSubData(m_rangeBuffer, first * RANGES_PER_OBJECT * sizeof(MeshRange),
+                             count * RANGES_PER_OBJECT * sizeof(MeshRange), &m_ranges[first * RANGES_PER_OBJECT]);
+    }
+    m_dirtyMin = 0xFFFFFFFFu;
+    m_dirtyMax = 0;
+
+    if (m_clusterDirtyMin <= m_clusterDirtyMax) {
+        const size_t first = m_clusterDirtyMin;
+        const size_t count = static_cast<size_t>(m_clusterDirtyMax - m_clusterDirtyMin) + 1;
+        glNamedBufferSubData(m_clusterBuffer, first * sizeof(ClusterRecord),
+                             count * sizeof(ClusterRecord), &m_clusters[first]);
+    }
+    m_clusterDirtyMin = 0xFFFFFFFFu;
+    m_clusterDirtyMax = 0;
+
+    if (!m_groupsDirty) {
+        return;
+    }
+    m_groupsDirty = false;
+
+    // Command buffer is partitioned by group, in group order, each group's
+    // 16-bit list followed by its 32-bit list
+    std::vector<uint32_t> offsets(2 * m_groups.size());
+    uint32_t offset = 0;
+    for (size_t g = 0; g < m_groups.size(); ++g) {
+        Group& group = m_groups[g];
+        group.offset = offset;
+        group.wideOffset = offset + group.size;
+        offsets[2 * g] = group.offset;
+        offsets[2 * g + 1] = group.wideOffset;
+        offset = group.wideOffset + group.wideSize;
+    }
+
+    // Contents are rewritten by every cull pass, so growing loses nothing
+    if (offset > m_commandCapacity) {
+        m_commandCapacity = std::max({offset, m_commandCapacity * 2, MIN_COMMAND_CAPACITY});
+        createBuffer(m_commandBuffer, static_cast<size_t>(m_commandCapacity) * sizeof(DrawCommand));
+    }
+
+    if (m_groups.size() > m_groupCapacity) {
+        m_groupCapacity = std::max({static_cast<uint32_t>(m_groups.size()), m_groupCapacity * 2, MIN_GROUP_CAPACITY});
+        createBuffer(m_countBuffer, (STATS_COUNT + 2 * m_groupCapacity) * sizeof(uint32_t));
+        createBuffer(m_groupBuffer, 2 * m_groupCapacity * sizeof(uint32_t));
+    }
+    if (!offsets.empty()) {
+        glNamedBufferSubData(m_groupBuffer, 0, offsets.size() * sizeof(uint32_t), offsets.data());
+    }
+}
+
+void GpuDrivenRenderer::ensureCapacity(uint32_t objectCount) {
+    if (objectCount <= m_capacity) {
+        return;
+    }
+
+    m_capacity = std::max({objectCount, m_capacity * 2, MIN_OBJECT_CAPACITY});
+    const size_t words = visibilityWords(m_capacity);
+
+    createBuffer(m_objectBuffer, m_capacity * sizeof(ObjectRecord));
+    createBuffer(m_rangeBuffer, static_cast<size_t>(m_capacity) * RANGES_PER_OBJECT * sizeof(MeshRange));
+    createBuffer(m_lodStateBuffer, m_capacity * sizeof(uint32_t));
+    createBuffer(m_drawnRangeBuffer, m_capacity * sizeof(uint32_t));
+    createBuffer(m_visibilityBuffer, words * sizeof(uint32_t));
+    createBuffer(m_occlusionBuffer, words * sizeof(uint32_t));
+    glClearNamedBufferData(m_lodStateBuffer, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+
+    // Readback buffer is written by the GPU and read through a persistent mapping
+    if (m_readbackFence) {
+        glDeleteSync(m_readbackFence);
+        m_readbackFence = nullptr;
+    }
+    if (m_readbackPtr) {
+        glUnmapNamedBuffer(m_readbackBuffer);
+        m_readbackPtr = nullptr;
+    }
+    deleteBuffer(m_readbackBuffer);
+    const GLsizeiptr readbackBytes = static_cast<GLsizeiptr>(STATS_COUNT + words) * sizeof(uint32_t);
+    const GLbitfield mapFlags = GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    glCreateBuffers(1, &m_readbackBuffer);
+    glNamedBufferStorage(m_readbackBuffer, readbackBytes, nullptr, mapFlags | GL_CLIENT_STORAGE_BIT);
+    m_readbackPtr = glMapNamedBufferRange(m_readbackBuffer, 0, readbackBytes, mapFlags);
+
+    // New buffers hold nothing yet: upload every slot
+    m_dirtyMin = 0;
+    m_dirtyMax = objectCount - 1;
+}
+
+bool GpuDrivenRenderer::readBack() {
+    if (!m_readbackFence) {
+        return false;
+    }
+
+    const GLenum status = glClientWaitSync(m_readbackFence, 0, 0);
+    if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) {
+        return false;
+    }
+    glDeleteSync(m_readbackFence);
+    m_readbackFence = nullptr;
+
+    if (!m_readbackPtr) {
+        return false;
+    }
+    const uint32_t* data = static_cast<const uint32_t*>(m_readbackPtr);
+    const uint32_t* bits = data + STATS_COUNT;
+    const bool changed = !std::equal(m_stats.begin(), m_stats.end(), data) ||
+                         m_visibleBits.size() != m_readbackWords ||
+                         !std::equal(m_visibleBits.begin(), m_visibleBits.end(), bits);
+    std::copy(data, data + STATS_COUNT, m_stats.begin());
+    m_visibleBits.assign(bits, bits + m_readbackWords);
+    return changed;
+}
+
+bool GpuDrivenRenderer::wasVisible(uint32_t index) const {
+    const size_t word = index / 32;
+    return word < m_visibleBits.size() && (m_visibleBits[word] >> (index % 32)) & 1u;
+}
+
+const Texture* GpuDrivenRenderer::baseTexture(const FrameParams& params) const {
+    if (!params.texturesEnabled) {
+        return nullptr;
+    }
+    return (params.defaultTexture && params.defaultTexture->isValid()) ? params.defaultTexture : nullptr;
+}
@@ -0,0 +1,232 @@
+#pragma once
+
+#include "GeometryArena.h"
+#include "core/Shader.h"
+#include "core/Texture.h"
+#include "scene/Frustum.h"
+#include "scene/Scene.h"
+#include "util/RangeAllocator.h"
+#include <glad/gl.h>
+#include <glm/glm.hpp>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+class TextureManager;
+struct TextureEntry;
+
+// GPU-driven rendering path.
+// Per-object records (transform, colour, world bounds, LOD index ranges) live
+// in persistent SSBOs that are only rewritten for objects whose revision
+// changed. Each frame a compute pass (cull.comp) frustum-culls every object,
+// drops those the CPU occlusion culler flagged, selects its LOD by projected
+// size and appends indirect draw commands per texture group; the groups are
+// then drawn with glMultiDrawElementsIndirectCount. Each group has one draw
+// list per index type of the arena, the second one only while the group
+// holds a mesh with 32-bit indices.
+// Large ranges are split into the mesh's meshlets (see MeshletBuilder): for
+// those, cull.comp only records the selected range, and a second compute pass
+// (cluster_cull.comp) frustum- and normal-cone-culls each cluster of it and
+// appends one draw command per surviving cluster, so the parts of a large
+// object that are off screen or facing away are not drawn.
+// Stats and per-object visibility come back asynchronously one frame late.
+class GpuDrivenRenderer {
+public:
+    struct FrameParams {
+        glm::mat4 view{1.0f};
+        glm::mat4 projection{1.0f};
+        const Frustum* frustum{nullptr};
+        int screenHeight{0};
+        float lodScale{1.0f};  // Projected sizes are scaled by this before LOD selection
+        bool frustumCulling{true};
+        const std::vector<uint32_t>* occluded{nullptr};  // Object indices hidden by OcclusionCuller
+        bool lodEnabled{true};
+        bool clusterCulling{true};   // Draw large ranges cluster by cluster
+        bool coneCulling{true};      // Skip back-facing clusters (back faces are culled)
+        bool lodDebugColors{false};
+        bool wireframe{false};
+        bool texturesEnabled{true};
+        const Texture* defaultTexture{nullptr};
+        TextureManager* textureManager{nullptr};
+    };
+
+    GpuDrivenRenderer() = default;
+    ~GpuDrivenRenderer();
+
+    GpuDrivenRenderer(const GpuDrivenRenderer&) = delete;
+    GpuDrivenRenderer& operator=(const GpuDrivenRenderer&) = delete;
+
+    void init(GeometryArena* arena);
+
+    // Cull and draw the scene. The shader (mesh_gpu.vert) must have its
+    // per-frame uniforms set; it is re-bound after the compute dispatch.
+    void render(const Scene& scene, const FrameParams& params, const Shader& shader);
+
+    // Stats from the most recent completed readback (one frame late)
+    int getVisibleObjects() const { return static_cast<int>(m_stats[0]); }
+    int getCulledObjects() const { return static_cast<int>(m_stats[1]); }
+    uint32_t getRenderedTriangles() const { return m_stats[2]; }
+    uint32_t getOriginalTriangles() const { return m_stats[3]; }
+    uint32_t getDrawnClusters() const { return m_stats[4]; }
+    uint32_t getTestedClusters() const { return m_stats[5]; }   // Of the drawn ranges
+    uint32_t getDrawCallCount() const { return m_drawCalls; }
+
+    // Stats and visibility of a drawn frame are still being copied back
+    bool hasPendingReadback() const { return m_readbackFence != nullptr; }
+
+    // Take the readback if the GPU has finished it (also done by render());
+    // true if the stats or the visibility bits changed
+    bool readBack();
+
+private:
+    // Base mesh + up to 7 LOD levels; must match RANGES_PER_OBJECT in the shaders
+    static constexpr uint32_t RANGES_PER_OBJECT = 8;
+    static constexpr uint32_t STATS_COUNT = 6;
+
+    static constexpr uint32_t FLAG_DRAWABLE = 1u;
+    static constexpr uint32_t FLAG_SELECTED = 2u;
+    static constexpr uint32_t FLAG_HOVERED = 4u;
+    static constexpr uint32_t FLAG_CONE_CULLING = 8u;  // Model matrix preserves angles
+
+    static constexpr uint32_t NO_GROUP = 0xFFFFFFFFu;
+    static constexpr uint32_t NO_RANGE = 0xFFFFFFFFu;
+
+    // Matches the std430 ObjectRecord struct in cull.comp, cluster_cull.comp and mesh_gpu.vert
+    struct ObjectRecord {
+        glm::mat4 model;
+        glm::mat4 normalMatrix;  // mat3 padded to columns of vec4
+        glm::vec4 color;
+        glm::vec4 boundsMin;
+        glm::vec4 boundsMax;
+        uint32_t lodCount;
+        uint32_t group;
+        uint32_t flags;
+        uint32_t reserved;
+    };
+
+    // Matches MeshRange in cull.comp, cluster_cull.comp and mesh_gpu.vert; the position
+    // transform maps the stored (possibly quantized) positions to object space
+    struct MeshRange {
+        uint32_t firstIndex;
+        uint32_t indexCount;
+        int32_t baseVertex;
+        uint32_t wideIndices;   // 1 for 32-bit indices: selects the group's second draw list
+        uint32_t clusterCount;  // Clusters in the cluster buffer; 0 = drawn whole
+        uint32_t reserved[3];
+        glm::vec4 positionOffset;
+        glm::vec4 positionScale;
+    };
+
+    // Matches ClusterRecord in cluster_cull.comp: one meshlet of a range
+    struct ClusterRecord {
+        glm::vec4 sphere;       // Object-space centre, radius
+        glm::vec4 coneApex;     // Apex, cutoff
+        glm::vec4 coneAxis;
+        uint32_t firstIndex;    // Relative to the range
+        uint32_t indexCount;
+        uint32_t range;         // Global range index; NO_RANGE for unused records
+        uint32_t reserved;
+    };
+
+    // Layout defined by glMultiDrawElementsIndirect
+    struct DrawCommand {
+        uint32_t count;
+        uint32_t instanceCount;
+        uint32_t firstIndex;
+        int32_t baseVertex;
+        uint32_t baseInstance;
+    };
+
+    // CPU-side state of one object slot (slot index = scene object index)
+    struct Slot {
+        const SceneObject* object{nullptr};
+        uint64_t revision{0};
+        std::array<const Mesh*, RANGES_PER_OBJECT> meshes{};  // Pinned in the arena
+        uint32_t meshCount{0};
+        const TextureEntry* textureEntry{nullptr};
+        const Texture* texture{nullptr};
+        uint32_t group{NO_GROUP};
+        bool wideIndices{false};   // Some range has 32-bit indices
+        uint32_t commandSlots{1};  // Most commands one frame can emit (clusters of a range)
+        uint32_t clusterOffset{RangeAllocator::INVALID_OFFSET};
+        uint32_t clusterCount{0};
+        uint64_t clusterKey{0};     // Mesh versions the cluster records were written for
+    };
+
+    // Command lists of a group, sized in command slots: every member's in
+    // the 16-bit list, those of members with wide indices in the 32-bit list
+    struct Group {
+        const Texture* texture{nullptr};
+        uint32_t size{0};
+        uint32_t offset{0};
+        uint32_t wideSize{0};
+        uint32_t wideOffset{0};
+    };
+
+    void syncScene(const Scene& scene, const FrameParams& params);
+    void writeSlot(uint32_t index, SceneObject& object, const FrameParams& params);
+    void refreshRanges(uint32_t index);
+    void releaseSlot(Slot& slot);
+    void updateTextures(const FrameParams& params);
+    void assignGroup(uint32_t index, const Texture* texture);
+    void setCommandSlots(uint32_t index, bool wide, uint32_t commandSlots);
+    uint32_t writeClusters(uint32_t index);
+    void releaseClusters(Slot& slot);
+    uint32_t allocateClusters(uint32_t count);
+    void markClustersDirty(uint32_t offset, uint32_t count);
+    static ClusterRecord unusedCluster();
+    void markDirty(uint32_t index);
+    void uploadChanges();
+    void ensureCapacity(uint32_t objectCount);
+    bool wasVisible(uint32_t index) const;
+    const Texture* baseTexture(const FrameParams& params) const;
+
+    GeometryArena* m_arena{nullptr};
+    std::unique_ptr<Shader> m_cullShader;
+    std::unique_ptr<Shader> m_clusterShader;
+
+    // GPU buffers (SSBO bindings 0-9 in cull.comp and cluster_cull.comp)
+    GLuint m_objectBuffer{0};      // ObjectRecord per slot
+    GLuint m_rangeBuffer{0};       // RANGES_PER_OBJECT MeshRanges per slot
+    GLuint m_lodStateBuffer{0};    // Current LOD per slot (hysteresis)
+    GLuint m_commandBuffer{0};     // DrawCommands, partitioned by group and index type
+    GLuint m_countBuffer{0};       // Stats followed by two draw counts per group
+    GLuint m_groupBuffer{0};       // Two command offsets per group
+    GLuint m_visibilityBuffer{0};  // One bit per slot
+    GLuint m_occlusionBuffer{0};   // One bit per slot, set for occluded objects
+    GLuint m_drawnRangeBuffer{0};  // Range left to the cluster pass per slot
+    GLuint m_clusterBuffer{0};     // ClusterRecords, allocated per slot
+    GLuint m_readbackBuffer{0};    // Persistently mapped copy of stats + visibility
+    void* m_readbackPtr{nullptr};
+    GLsync m_readbackFence{nullptr};
+    uint32_t m_readbackWords{0};
+    uint32_t m_capacity{0};
+    uint32_t m_groupCapacity{0};
+    uint32_t m_commandCapacity{0};
+
+    // CPU mirrors
+    std::vector<Slot> m_slots;
+    std::vector<ObjectRecord> m_records;
+    std::vector<MeshRange> m_ranges;
+    std::vector<ClusterRecord> m_clusters;
+    RangeAllocator m_clusterAllocator;
+    std::vector<Group> m_groups;
+    std::unordered_map<const Texture*, uint32_t> m_groupIndex;
+    std::vector<uint32_t> m_texturedSlots;
+    std::vector<uint32_t> m_visibleBits;  // Last completed readback
+    std::vector<uint32_t> m_occlusionBits;
+
+    uint32_t m_dirtyMin{0xFFFFFFFFu};  // Slot range to upload (empty when min > max)
+    uint32_t m_dirtyMax{0};
+    uint32_t m_clusterDirtyMin{0xFFFFFFFFu};  // Cluster records to upload
+    uint32_t m_clusterDirtyMax{0};
+    bool m_groupsDirty{false};
+    uint64_t m_syncedRevision{0};
+    uint64_t m_arenaLayout{0};
+    bool m_texturesEnabled{true};
+
+    std::array<uint32_t, STATS_COUNT> m_stats{};
+    uint32_t m_drawCalls{0};
+};
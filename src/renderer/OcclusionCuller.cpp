@@ -0,0 +1,341 @@
+#include "OcclusionCuller.h"
+#include "lod/LODSelector.h"
+#include "scene/Scene.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define OCCLUSION_SSE 1
+#endif
+
+namespace {
+    constexpr int BAND_HEIGHT = 8;   // Rows per parallel raster job
+
+    // Without a CPU LOD chain, base meshes up to this size still occlude
+    constexpr size_t MAX_BASE_MESH_TRIANGLES = 4096;
+}
+
+void OcclusionCuller::cull(const Scene& scene, const glm::mat4& view, const glm::mat4& projection,
+                           int viewportWidth, int viewportHeight, std::vector<uint32_t>& candidates) {
+    m_occluded.clear();
+    m_triangles.clear();
+    m_occluderCount = 0;
+    if (candidates.empty() || viewportWidth <= 0 || viewportHeight <= 0) {
+        return;
+    }
+
+    const auto& objects = scene.getObjects();
+    const glm::mat4 viewProjection = projection * view;
+
+    // ========== Occluder selection ==========
+    // Largest objects on screen first
+    std::vector<std::pair<float, uint32_t>> ranked;
+    for (uint32_t index : candidates) {
+        const SceneObject& object = *objects[index];
+        if (!object.isVisible() || !occluderMesh(object)) {
+            continue;
+        }
+        const BoundingBox& bounds = object.getWorldBounds();
+        float screenSize = LODSelector::calculateScreenSize(bounds.getCenter(), bounds.getRadius(),
+                                                            view, projection, viewportHeight);
+        if (screenSize >= MIN_OCCLUDER_SIZE) {
+            ranked.emplace_back(screenSize, index);
+        }
+    }
+    if (ranked.empty()) {
+        return;
+    }
+    const size_t occluderLimit = std::min(ranked.size(), static_cast<size_t>(MAX_OCCLUDERS));
+    std::partial_sort(ranked.begin(), ranked.begin() + occluderLimit, ranked.end(),
+                      [](const auto& a, const auto& b) { return a.first > b.first; });
+
+    std::vector<std::pair<const MeshData*, glm::mat4>> occluders;
+    size_t triangleBudget = MAX_OCCLUDER_TRIANGLES;
+    for (size_t i = 0; i < occluderLimit; ++i) {
+        const SceneObject& object = *objects[ranked[i].second];
+        const MeshData* mesh = occluderMesh(object);
+        const size_t triangles = mesh->indices.size() / 3;
+        if (triangles > triangleBudget) {
+            continue;
+        }
+        triangleBudget -= triangles;
+        occluders.emplace_back(mesh, viewProjection * object.getModelMatrix());
+    }
+    m_occluderCount = static_cast<uint32_t>(occluders.size());
+
+    // ========== Transform and clip (one job per occluder) ==========
+    m_height = std::clamp(static_cast<int>(std::lround(static_cast<double>(WIDTH) * viewportHeight / viewportWidth)),
+                          BAND_HEIGHT, 4 * WIDTH);
+    std::vector<std::vector<ScreenTriangle>> perOccluder(occluders.size());
+
+    #pragma omp parallel for schedule(dynamic)
+    for (int i = 0; i < static_cast<int>(occluders.size()); ++i) {
+        addTriangles(*occluders[i].first, occluders[i].second, perOccluder[i]);
+    }
+    for (const auto& triangles : perOccluder) {
+        m_triangles.insert(m_triangles.end(), triangles.begin(), triangles.end());
+    }
+
+    // ========== Rasterize (one job per row band) ==========
+    m_depth.assign(static_cast<size_t>(WIDTH) * m_height, 1.0f);
+    const int bandCount = (m_height + BAND_HEIGHT - 1) / BAND_HEIGHT;
+
+    #pragma omp parallel for schedule(dynamic)
+    for (int band = 0; band < bandCount; ++band) {
+        rasterizeBand(band * BAND_HEIGHT, std::min(m_height, (band + 1) * BAND_HEIGHT));
+    }
+
+    // ========== Test candidates ==========
+    m_hidden.assign(candidates.size(), 0);
+
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < static_cast<int>(candidates.size()); ++i) {
+        m_hidden[i] = isOccluded(objects[candidates[i]]->getWorldBounds(), viewProjection) ? 1 : 0;
+    }
+
+    size_t kept = 0;
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        if (m_hidden[i]) {
+            m_occluded.push_back(candidates[i]);
+        } else {
+            candidates[kept++] = candidates[i];
+        }
+    }
+    candidates.resize(kept);
+}
+
+const MeshData* OcclusionCuller::occluderMesh(const SceneObject& object) {
+    // Coarsest LOD level that still has its CPU data
+    const LODMesh& lodMesh = object.getLODMesh();
+    for (size_t level = lodMesh.getLevelCount(); level-- > 0;) {
+        const LODLevel* lod = lodMesh.getLevel(level);
+        if (lod && !lod->meshData.empty()) {
+            return &lod->meshData;
+        }
+    }
+
+    const MeshData& base = object.getMeshData();
+    if (!base.empty() && base.indices.size() / 3 <= MAX_BASE_MESH_TRIANGLES) {
+        return &base;
+    }
+    return nullptr;
+}
+
+void OcclusionCuller::addTriangles(const MeshData& mesh, const glm::mat4& mvp,
+                                   std::vector<ScreenTriangle>& out) const {
+    std::vector<glm::vec4> clip(mesh.vertices.size());
+    for (size_t v = 0; v < mesh.vertices.size(); ++v) {
+        clip[v] = mvp * glm::vec4(mesh.vertices[v].position, 1.0f);
+    }
+
+    for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3) {
+        glm::vec4 triangle[3] = {clip[mesh.indices[i]], clip[mesh.indices[i + 1]], clip[mesh.indices[i + 2]]};
+
+        // Entirely outside one side of the frustum
+        bool outside = false;
+        for (int axis = 0; axis < 2 && !outside; ++axis) {
+            outside = (triangle[0][axis] > triangle[0].w && triangle[1][axis] > triangle[1].w &&
+                       triangle[2][axis] > triangle[2].w) ||
+                      (triangle[0][axis] < -triangle[0].w && triangle[1][axis] < -triangle[1].w &&
+                       triangle[2][axis] < -triangle[2].w);
+        }
+        if (!outside) {
+            addClipped(triangle, 3, out);
+        }
+    }
+}
+
+void OcclusionCuller::addClipped(const glm::vec4* clip, int count, std::vector<ScreenTriangle>& out) const {
+    // Clip against the near plane (z >= -w); one triangle becomes up to two
+    glm::vec4 polygon[4];
+    int polygonSize = 0;
+    for (int i = 0; i < count; ++i) {
+        const glm::vec4& a = clip[i];
+        const glm::vec4& b = clip[(i + 1) % count];
+        const float da = a.z + a.w;
+        const float db = b.z + b.w;
+        if (da >= 0.0f) {
+            polygon[polygonSize++] = a;
+        }
+        if ((da >= 0.0f) != (db >= 0.0f)) {
+            polygon[polygonSize++] = a + (b - a) * (da / (da - db));
+        }
+    }
+    if (polygonSize < 3) {
+        return;
+    }
+
+    float sx[4], sy[4], sz[4];
+    for (int i = 0; i < polygonSize; ++i) {
+        const float invW = 1.0f / std::max(polygon[i].w, 1e-6f);
+        sx[i] = (polygon[i].x * invW * 0.5f + 0.5f) * WIDTH;
+        sy[i] = (0.5f - polygon[i].y * invW * 0.5f) * m_height;
+        sz[i] = polygon[i].z * invW;
+    }
+
+    for (int i = 1; i + 1 < polygonSize; ++i) {
+        ScreenTriangle triangle;
+        const int corners[3] = {0, i, i + 1};
+        for (int c = 0; c < 3; ++c) {
+            triangle.x[c] = sx[corners[c]];
+            triangle.y[c] = sy[corners[c]];
+            triangle.z[c] = sz[corners[c]];
+        }
+
+        // Counter-clockwise in pixel space, so inside means all edge functions >= 0
+        const float area = (triangle.x[1] - triangle.x[0]) * (triangle.y[2] - triangle.y[0]) -
+                           (triangle.y[1] - triangle.y[0]) * (triangle.x[2] - triangle.x[0]);
+        if (std::abs(area) < 1e-8f) {
+            continue;
+        }
+        if (area < 0.0f) {
+            std::swap(triangle.x[1], triangle.x[2]);
+            std::swap(triangle.y[1], triangle.y[2]);
+            std::swap(triangle.z[1], triangle.z[2]);
+        }
+
+        const float minY = std::min({triangle.y[0], triangle.y[1], triangle.y[2]});
+        const float maxY = std::max({triangle.y[0], triangle.y[1], triangle.y[2]});
+        triangle.minY = std::max(0, static_cast<int>(std::floor(minY)));
+        triangle.maxY = std::min(m_height - 1, static_cast<int>(std::ceil(maxY)));
+        if (triangle.minY <= triangle.maxY) {
+            out.push_back(triangle);
+        }
+    }
+}
+
+void OcclusionCuller::rasterizeBand(int y0, int y1) {
+    for (const ScreenTriangle& t : m_triangles) {
+        const int rowBegin = std::max(y0, t.minY);
+        const int rowEnd = std::min(y1 - 1, t.maxY);
+        if (rowBegin > rowEnd) {
+            continue;
+        }
+
+        const float minX = std::min({t.x[0], t.x[1], t.x[2]});
+        const float maxX = std::max({t.x[0], t.x[1], t.x[2]});
+        // Start on a four-pixel boundary so SIMD groups never cross the row end
+        const int colBegin = std::max(0, static_cast<int>(std::floor(minX))) & ~3;
+        const int colEnd = std::min(WIDTH - 1, static_cast<int>(std::ceil(maxX)));
+        if (colBegin > colEnd) {
+            continue;
+        }
+
+        // Edge function i is opposite vertex i: E(p) = (b - a) x (p - a)
+        float stepX[3], stepY[3], origin[3];
+        for (int e = 0; e < 3; ++e) {
+            const int a = (e + 1) % 3;
+            const int b = (e + 2) % 3;
+            stepX[e] = t.y[a] - t.y[b];
+            stepY[e] = t.x[b] - t.x[a];
+            origin[e] = (t.x[b] - t.x[a]) * (-t.y[a]) - (t.y[b] - t.y[a]) * (-t.x[a]);
+        }
+
+        // Depth is affine in screen space: z = sum(E_i * z_i) / area
+        const float area = origin[0] + origin[1] + origin[2];   // Sum of the E_i at (0, 0)
+        const float invArea = 1.0f / area;
+        const float zStepX = (stepX[0] * t.z[0] + stepX[1] * t.z[1] + stepX[2] * t.z[2]) * invArea;
+        const float zStepY = (stepY[0] * t.z[0] + stepY[1] * t.z[1] + stepY[2] * t.z[2]) * invArea;
+        const float zOrigin = (origin[0] * t.z[0] + origin[1] * t.z[1] + origin[2] * t.z[2]) * invArea;
+
+        for (int y = rowBegin; y <= rowEnd; ++y) {
+            const float py = y + 0.5f;
+            const float px = colBegin + 0.5f;
+            float* row = &m_depth[static_cast<size_t>(y) * WIDTH];
+
+            float w[3];
+            for (int e = 0; e < 3; ++e) {
+                w[e] = origin[e] + stepX[e] * px + stepY[e] * py;
+            }
+            float z = zOrigin + zStepX * px + zStepY * py;
+
+#ifdef OCCLUSION_SSE
+            const __m128 lane = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+            __m128 w0 = _mm_add_ps(_mm_set1_ps(w[0]), _mm_mul_ps(lane, _mm_set1_ps(stepX[0])));
+            __m128 w1 = _mm_add_ps(_mm_set1_ps(w[1]), _mm_mul_ps(lane, _mm_set1_ps(stepX[1])));
+            __m128 w2 = _mm_add_ps(_mm_set1_ps(w[2]), _mm_mul_ps(lane, _mm_set1_ps(stepX[2])));
+            __m128 depth = _mm_add_ps(_mm_set1_ps(z), _mm_mul_ps(lane, _mm_set1_ps(zStepX)));
+            const __m128 w0Step = _mm_set1_ps(4.0f * stepX[0]);
+            const __m128 w1Step = _mm_set1_ps(4.0f * stepX[1]);
+            const __m128 w2Step = _mm_set1_ps(4.0f * stepX[2]);
+            const __m128 depthStep = _mm_set1_ps(4.0f * zStepX);
+            const __m128 zero = _mm_setzero_ps();
+
+            for (int x = colBegin; x <= colEnd; x += 4) {
+                const __m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(w0, zero), _mm_cmpge_ps(w1, zero)),
+                                                 _mm_cmpge_ps(w2, zero));
+                if (_mm_movemask_ps(inside)) {
+                    const __m128 current = _mm_loadu_ps(row + x);
+                    const __m128 nearer = _mm_min_ps(current, depth);
+                    _mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, nearer), _mm_andnot_ps(inside, current)));
+                }
+                w0 = _mm_add_ps(w0, w0Step);
+                w1 = _mm_add_ps(w1, w1Step);
+                w2 = _mm_add_ps(w2, w2Step);
+                depth = _mm_add_ps(depth, depthStep);
+            }
+#else
+            for (int x = colBegin; x <= colEnd; ++x) {
+                if (w[0] >= 0.0f && w[1] >= 0.0f && w[2] >= 0.0f) {
+                    row[x] = std::min(row[x], z);
+                }
+                w[0] += stepX[0];
+                w[1] += stepX[1];
+                w[2] += stepX[2];
+                z += zStepX;
+            }
+#endif
+        }
+    }
+}
+
+bool OcclusionCuller::isOccluded(const BoundingBox& bounds, const glm::mat4& viewProjection) const {
+    glm::vec3 corners[8];
+    bounds.getCorners(corners);
+
+    float minX = 1e30f, minY = 1e30f, maxX = -1e30f, maxY = -1e30f;
+    float nearest = 1.0f;
+    for (const glm::vec3& corner : corners) {
+        const glm::vec4 clip = viewProjection * glm::vec4(corner, 1.0f);
+        if (clip.z < -clip.w) {
+            return false;   // Reaches in front of the near plane
+        }
+        const float invW = 1.0f / clip.w;
+        const float sx = (clip.x * invW * 0.5f + 0.5f) * WIDTH;
+        const float sy = (0.5f - clip.y * invW * 0.5f) * m_height;
+        minX = std::min(minX, sx);
+        maxX = std::max(maxX, sx);
+        minY = std::min(minY, sy);
+        maxY = std::max(maxY, sy);
+        nearest = std::min(nearest, clip.z * invW);
+    }
+
+    const int x0 = std::max(0, static_cast<int>(std::floor(minX)));
+    const int x1 = std::min(WIDTH - 1, static_cast<int>(std::floor(maxX)));
+    const int y0 = std::max(0, static_cast<int>(std::floor(minY)));
+    const int y1 = std::min(m_height - 1, static_cast<int>(std::floor(maxY)));
+    if (x0 > x1 || y0 > y1) {
+        return false;
+    }
+
+    // Hidden only if every covered pixel has an occluder in front
+    for (int y = y0; y <= y1; ++y) {
+        const float* row = &m_depth[static_cast<size_t>(y) * WIDTH];
+        int x = x0;
+#ifdef OCCLUSION_SSE
+        const __m128 limit = _mm_set1_ps(nearest);
+        for (; x + 3 <= x1; x += 4) {
+            if (_mm_movemask_ps(_mm_cmpge_ps(_mm_loadu_ps(row + x), limit))) {
+                return false;
+            }
+        }
+#endif
+        for (; x <= x1; ++x) {
+            if (row[x] >= nearest) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "scene/BoundingBox.h"
+#include "mesh/MeshData.h"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+class Scene;
+class SceneObject;
+
+// CPU occlusion culling against a low-resolution software depth buffer.
+// Each frame the largest objects on screen become occluders: their coarsest
+// LOD level is rasterized into a WIDTH-wide buffer of NDC depths, in parallel
+// row bands (OpenMP) and four pixels at a time (SSE). Every candidate is then
+// hidden if its world bounds lie behind the buffer at every pixel they cover.
+// Coarse LODs are not strictly conservative, so an object right behind an
+// occluder's silhouette can be culled slightly early.
+class OcclusionCuller {
+public:
+    static constexpr int WIDTH = 256;                           // Depth buffer width; height follows the aspect
+    static constexpr int MAX_OCCLUDERS = 32;
+    static constexpr uint32_t MAX_OCCLUDER_TRIANGLES = 65536;   // Rasterized per frame
+    static constexpr float MIN_OCCLUDER_SIZE = 64.0f;           // Screen diameter in pixels
+
+    OcclusionCuller() = default;
+
+    // Remove objects hidden behind the frame's occluders from candidates
+    // (indices into Scene::getObjects() that passed frustum culling)
+    void cull(const Scene& scene, const glm::mat4& view, const glm::mat4& projection,
+              int viewportWidth, int viewportHeight, std::vector<uint32_t>& candidates);
+
+    // Objects removed by the last cull()
+    const std::vector<uint32_t>& getOccluded() const { return m_occluded; }
+    uint32_t getOccludedCount() const { return static_cast<uint32_t>(m_occluded.size()); }
+    uint32_t getOccluderCount() const { return m_occluderCount; }
+    uint32_t getOccluderTriangles() const { return static_cast<uint32_t>(m_triangles.size()); }
+
+private:
+    // Triangle in depth buffer pixels; z is NDC depth
+    struct ScreenTriangle {
+        float x[3], y[3], z[3];
+        int minY, maxY;
+    };
+
+    static const MeshData* occluderMesh(const SceneObject& object);
+    void addTriangles(const MeshData& mesh, const glm::mat4& mvp, std::vector<ScreenTriangle>& out) const;
+    void addClipped(const glm::vec4* clip, int count, std::vector<ScreenTriangle>& out) const;
+    void rasterizeBand(int y0, int y1);
+    bool isOccluded(const BoundingBox& bounds, const glm::mat4& viewProjection) const;
+
+    int m_height{0};
+    std::vector<float> m_depth;                // WIDTH * m_height, 1 = far
+    std::vector<ScreenTriangle> m_triangles;
+    std::vector<uint32_t> m_occluded;
+    std::vector<uint8_t> m_hidden;             // Per candidate
+    uint32_t m_occluderCount{0};
+};
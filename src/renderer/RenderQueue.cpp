@@ -0,0 +1,115 @@
+#include "RenderQueue.h"
+#include <algorithm>
+#include <limits>
+
+void RenderQueue::clear() {
+    m_packets.clear();
+    m_textureIds.clear();
+    m_meshIds.clear();
+    m_minDepth = std::numeric_limits<float>::max();
+    m_maxDepth = std::numeric_limits<float>::lowest();
+}
+
+void RenderQueue::add(const Mesh* mesh, const Texture* texture, GLintptr uniformOffset, float depth) {
+    if (!mesh || uniformOffset < 0) {
+        return;
+    }
+
+    Packet packet;
+    packet.key = 0;
+    packet.mesh = mesh;
+    packet.texture = texture;
+    packet.uniformOffset = uniformOffset;
+    packet.depth = depth;
+    m_packets.push_back(packet);
+
+    m_minDepth = std::min(m_minDepth, depth);
+    m_maxDepth = std::max(m_maxDepth, depth);
+}
+
+uint32_t RenderQueue::denseId(std::unordered_map<const void*, uint32_t>& ids, const void* pointer, int bits) {
+    const uint32_t maxId = (1u << bits) - 1;
+    auto it = ids.find(pointer);
+    if (it != ids.end()) {
+        return it->second;
+    }
+    const uint32_t id = std::min(static_cast<uint32_t>(ids.size()), maxId);
+    ids.emplace(pointer, id);
+    return id;
+}
+
+void RenderQueue::sort() {
+    if (m_packets.size() < 2) {
+        return;
+    }
+
+    // ========== Keys ==========
+    const float depthRange = m_maxDepth - m_minDepth;
+    const uint64_t maxDepth = (1u << DEPTH_BITS) - 1;
+    const float depthScale = depthRange > 0.0f ? maxDepth / depthRange : 0.0f;
+    for (Packet& packet : m_packets) {
+        const uint64_t texture = denseId(m_textureIds, packet.texture, TEXTURE_BITS);
+        const uint64_t mesh = denseId(m_meshIds, packet.mesh, MESH_BITS);
+        const uint64_t depth = std::min(static_cast<uint64_t>((packet.depth - m_minDepth) * depthScale), maxDepth);
+        packet.key = (texture << (MESH_BITS + DEPTH_BITS)) | (mesh << DEPTH_BITS) | depth;
+    }
+
+    // ========== LSD radix sort, 8 bits per pass ==========
+    const size_t count = m_packets.size();
+    m_scratch.resize(count);
+    for (int shift = 0; shift < 64; shift += 8) {
+        size_t offsets[256] = {};
+        for (const Packet& packet : m_packets) {
+            ++offsets[(packet.key >> shift) & 0xFF];
+        }
+
+        // All keys share this digit (typical for the high texture bits): nothing to do
+        if (offsets[(m_packets[0].key >> shift) & 0xFF] == count) {
+            continue;
+        }
+
+        size_t sum = 0;
+        for (size_t& offset : offsets) {
+            const size_t bucket = offset;
+            offset = sum;
+            sum += bucket;
+        }
+        for (const Packet& packet : m_packets) {
+            m_scratch[offsets[(packet.key >> shift) & 0xFF]++] = packet;
+        }
+        m_packets.swap(m_scratch);
+    }
+}
+
+uint32_t RenderQueue::submit(const UniformRing& ring, GLuint objectBinding, size_t objectBlockSize) {
+    m_stateChanges = 0;
+
+    const Texture* boundTexture = nullptr;
+    GLuint boundVAO = 0;
+    uint32_t drawCalls = 0;
+
+    for (const Packet& packet : m_packets) {
+        if (packet.texture && packet.texture != boundTexture) {
+            packet.texture->bind(0);
+            boundTexture = packet.texture;
+            ++m_stateChanges;
+        }
+
+        const GLuint vao = packet.mesh->getVertexArray();
+        if (!vao) {
+            continue;
+        }
+        if (vao != boundVAO) {
+            glBindVertexArray(vao);
+            boundVAO = vao;
+            ++m_stateChanges;
+        }
+
+        ring.bind(objectBinding, packet.uniformOffset, objectBlockSize);
+        packet.mesh->drawBound();
+        ++drawCalls;
+    }
+
+    glBindVertexArray(0);
+    return drawCalls;
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "UniformRing.h"
+#include "core/Texture.h"
+#include "mesh/Mesh.h"
+#include <glad/gl.h>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Draw packets for the per-object path. Each packet gets a 64-bit sort key
+// (texture, mesh, quantized view depth) and the queue is radix-sorted by it:
+// packets sharing a texture and mesh become adjacent and are submitted
+// without rebinding, and within a mesh they are drawn front to back so
+// early-Z rejects hidden fragments.
+class RenderQueue {
+public:
+    RenderQueue() = default;
+
+    void clear();
+
+    // uniformOffset is the object's block in the uniform ring; depth is the
+    // view-space distance used for front-to-back ordering
+    void add(const Mesh* mesh, const Texture* texture, GLintptr uniformOffset, float depth);
+
+    // Build the keys and sort
+    void sort();
+
+    // Draw all packets in order; binds textures, VAOs and object blocks only
+    // when they change. Returns the number of draw calls.
+    uint32_t submit(const UniformRing& ring, GLuint objectBinding, size_t objectBlockSize);
+
+    size_t size() const { return m_packets.size(); }
+
+    // State changes (texture + VAO binds) in the last submit
+    uint32_t getStateChanges() const { return m_stateChanges; }
+
+private:
+    struct Packet {
+        uint64_t key;
+        const Mesh* mesh;
+        const Texture* texture;
+        GLintptr uniformOffset;
+        float depth;
+    };
+
+    // Key layout, most significant first
+    static constexpr int TEXTURE_BITS = 16;
+    static constexpr int MESH_BITS = 24;
+    static constexpr int DEPTH_BITS = 24;
+
+    // Dense per-frame id in order of first use (saturates at the field width)
+    static uint32_t denseId(std::unordered_map<const void*, uint32_t>& ids, const void* pointer, int bits);
+
+    std::vector<Packet> m_packets;
+    std::vector<Packet> m_scratch;
+    std::unordered_map<const void*, uint32_t> m_textureIds;
+    std::unordered_map<const void*, uint32_t> m_meshIds;
+    float m_minDepth{0.0f};
+    float m_maxDepth{0.0f};
+    uint32_t m_stateChanges{0};
+};
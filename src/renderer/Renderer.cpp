@@ -2,13 +2,22 @@
 #include "lod/LODSelector.h"
 #include "lod/LODManager.h"
 #include "multipatch/MultiPatchManager.h"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <numeric>
+
+namespace {
+    // LOD thresholds halve from level to level, so dividing screen sizes by
+    // 2^bias shifts the selection about bias levels coarser
+    constexpr float INTERACTION_LOD_BIAS = 2.0f;
+    constexpr float REFINE_STEP = 0.25f;   // Bias removed per frame once the camera stops
+}
 
 Renderer::Renderer() {
 }
 
 Renderer::~Renderer() {
-    cleanupPickingFBO();
     if (m_backgroundVAO) {
         glDeleteVertexArrays(1, &m_backgroundVAO);
     }
@@ -19,8 +28,10 @@ Renderer::~Renderer() {
 
 void Renderer::init(int width, int height, const std::string& defaultTexturePath) {
     m_meshShader = std::make_unique<Shader>("shaders/mesh.vert", "shaders/mesh.frag");
-    m_pickingShader = std::make_unique<Shader>("shaders/picking.vert", "shaders/picking.frag");
+    m_batchedMeshShader = std::make_unique<Shader>("shaders/mesh_batched.vert", "shaders/mesh.frag");
+    m_gpuMeshShader = std::make_unique<Shader>("shaders/mesh_gpu.vert", "shaders/mesh.frag");
     m_backgroundShader = std::make_unique<Shader>("shaders/background.vert", "shaders/background.frag");
+    m_edgeShader = std::make_unique<Shader>("shaders/edges.vert", "shaders/edges.frag");
 
     // Create full-screen quad for background
     float quadVertices[] = {
@@ -44,7 +55,13 @@ void Renderer::init(int width, int height, const std::string& defaultTexturePath
     glVertexArrayAttribFormat(m_backgroundVAO, 0, 2, GL_FLOAT, GL_FALSE, 0);
     glVertexArrayAttribBinding(m_backgroundVAO, 0, 0);
 
-    initPickingFBO(width, height);
+    m_viewportWidth = width;
+    m_viewportHeight = height;
+    m_geometryArena.init();
+    m_uniformRing.init();
+    m_batchRenderer.init(&m_geometryArena);
+    m_gpuRenderer.init(&m_geometryArena);
+    m_dynamicResolution.init();
 
     // Load default texture for untextured objects
     m_defaultTexture = std::make_unique<Texture>();
@@ -58,58 +75,26 @@ void Renderer::init(int width, int height, const std::string& defaultTexturePath
     m_progressOverlay.setTextRenderer(&m_textRenderer);
 }
 
-void Renderer::initPickingFBO(int width, int height) {
-    cleanupPickingFBO();
-
-    m_pickingWidth = width;
-    m_pickingHeight = height;
-
-    // Create framebuffer
-    glCreateFramebuffers(1, &m_pickingFBO);
-
-    // Create color texture
-    glCreateTextures(GL_TEXTURE_2D, 1, &m_pickingTexture);
-    glTextureStorage2D(m_pickingTexture, 1, GL_RGB8, width, height);
-    glTextureParameteri(m_pickingTexture, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glTextureParameteri(m_pickingTexture, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-
-    // Create depth renderbuffer
-    glCreateRenderbuffers(1, &m_pickingDepth);
-    glNamedRenderbufferStorage(m_pickingDepth, GL_DEPTH_COMPONENT24, width, height);
-
-    // Attach to framebuffer
-    glNamedFramebufferTexture(m_pickingFBO, GL_COLOR_ATTACHMENT0, m_pickingTexture, 0);
-    glNamedFramebufferRenderbuffer(m_pickingFBO, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, m_pickingDepth);
-
-    // Check framebuffer status
-    GLenum status = glCheckNamedFramebufferStatus(m_pickingFBO, GL_FRAMEBUFFER);
-    if (status != GL_FRAMEBUFFER_COMPLETE) {
-        std::cerr << "Framebuffer incomplete: 0x" << std::hex << status << std::dec << std::endl;
-    }
-}
-
-void Renderer::cleanupPickingFBO() {
-    if (m_pickingFBO) {
-        glDeleteFramebuffers(1, &m_pickingFBO);
-        m_pickingFBO = 0;
-    }
-    if (m_pickingTexture) {
-        glDeleteTextures(1, &m_pickingTexture);
-        m_pickingTexture = 0;
-    }
-    if (m_pickingDepth) {
-        glDeleteRenderbuffers(1, &m_pickingDepth);
-        m_pickingDepth = 0;
-    }
-}
-
 void Renderer::resize(int width, int height) {
     if (width > 0 && height > 0) {
-        initPickingFBO(width, height);
+        m_viewportWidth = width;
+        m_viewportHeight = height;
     }
 }
 
 void Renderer::render(const Scene& scene, const Camera& camera, float aspectRatio) {
+    // Coarser LODs while the camera moves, refined progressively afterwards
+    const bool interacting = m_interactiveQuality && m_interacting;
+    m_lodBias = interacting ? INTERACTION_LOD_BIAS : std::max(0.0f, m_lodBias - REFINE_STEP);
+    m_lodScale = std::exp2(-m_lodBias);
+
+    // With dynamic resolution the scene goes into a scaled offscreen target
+    // that is upscaled to the window before the overlays
+    const bool dynamicResolution = m_dynamicResolution.isEnabled();
+    if (dynamicResolution) {
+        m_dynamicResolution.beginScene(m_viewportWidth, m_viewportHeight, !m_interacting && !isRefining());
+    }
+
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
     // Render gradient background first
@@ -122,7 +107,11 @@ void Renderer::render(const Scene& scene, const Camera& camera, float aspectRati
         glDisable(GL_CULL_FACE);
     }
 
-    m_meshShader->use();
+    // All programs read the same per-frame uniform blocks; per-object data differs
+    const Shader& shader = (m_drawPath == DrawPath::GpuDriven) ? *m_gpuMeshShader
+                         : (m_drawPath == DrawPath::Batched)   ? *m_batchedMeshShader
+                                                               : *m_meshShader;
+    shader.use();
 
     glm::mat4 view = camera.getViewMatrix();
     glm::mat4 projection = camera.getProjectionMatrix(aspectRatio);
@@ -133,39 +122,47 @@ void Renderer::render(const Scene& scene, const Camera& camera, float aspectRati
         m_frustum.update(viewProjection);
     }
 
-    m_meshShader->setMat4("view", view);
-    m_meshShader->setMat4("projection", projection);
-    m_meshShader->setVec3("viewPos", camera.getPosition());
-    m_meshShader->setInt("diffuseMap", 0);  // Texture unit 0, constant for all objects
-
-    // Main light
-    m_meshShader->setVec3("light.direction", glm::normalize(m_light.direction));
-    m_meshShader->setVec3("light.color", m_light.color);
-    m_meshShader->setFloat("light.ambient", m_light.ambient);
-    m_meshShader->setFloat("light.diffuse", m_light.diffuse);
-    m_meshShader->setFloat("light.specular", m_light.specular);
-
-    // Rim lighting
-    m_meshShader->setFloat("rimStrength", m_rimLight.strength);
-    m_meshShader->setVec3("rimColor", m_rimLight.color);
+    // Per-frame uniform blocks, plus one object block per draw on the per-object
+    // path and per edge draw in the edge overlay
+    const size_t objectBlockBytes = m_uniformRing.alignedSize(sizeof(UniformBlocks::Object));
+    const size_t objectBlocks = (m_drawPath == DrawPath::PerObject ? scene.getObjectCount() : 0) +
+                                (m_wireframeMode == WireframeMode::FeatureEdges ? scene.getObjectCount() : 0);
+    m_uniformRing.beginFrame(m_uniformRing.alignedSize(sizeof(UniformBlocks::Camera)) +
+                             m_uniformRing.alignedSize(sizeof(UniformBlocks::Lighting)) +
+                             m_uniformRing.alignedSize(sizeof(UniformBlocks::Solution)) +
+                             objectBlocks * objectBlockBytes);
+
+    UniformBlocks::Camera cameraBlock{};
+    cameraBlock.view = view;
+    cameraBlock.projection = projection;
+    cameraBlock.viewPos = camera.getPosition();
+    m_uniformRing.bind(UniformBlocks::CAMERA_BINDING, m_uniformRing.push(cameraBlock), sizeof(cameraBlock));
+
+    // Main light and rim lighting; textures are always sampled from unit 0
+    UniformBlocks::Lighting lightingBlock{};
+    lightingBlock.direction = glm::normalize(m_light.direction);
+    lightingBlock.color = m_light.color;
+    lightingBlock.ambient = m_light.ambient;
+    lightingBlock.diffuse = m_light.diffuse;
+    lightingBlock.specular = m_light.specular;
+    lightingBlock.rimColor = m_rimLight.color;
+    lightingBlock.rimStrength = m_rimLight.strength;
+    lightingBlock.hasTexture = m_texturesEnabled ? 1u : 0u;
+    m_uniformRing.bind(UniformBlocks::LIGHTING_BINDING, m_uniformRing.push(lightingBlock), sizeof(lightingBlock));
 
     // Solution visualization
     bool showSol = m_showSolution && m_multipatchManager && m_multipatchManager->hasSolution();
-    m_meshShader->setBool("showSolution", showSol);
-    if (showSol) {
-        float solMin = m_multipatchManager->getSolutionMin();
-        float solMax = m_multipatchManager->getSolutionMax();
-        m_meshShader->setFloat("solutionMin", solMin);
-        m_meshShader->setFloat("solutionMax", solMax);
-    } else {
-        m_meshShader->setFloat("solutionMin", 0.0f);
-        m_meshShader->setFloat("solutionMax", 1.0f);
-    }
+    UniformBlocks::Solution solutionBlock{};
+    solutionBlock.showSolution = showSol ? 1u : 0u;
+    solutionBlock.solutionMin = showSol ? m_multipatchManager->getSolutionMin() : 0.0f;
+    solutionBlock.solutionMax = showSol ? m_multipatchManager->getSolutionMax() : 1.0f;
+    m_uniformRing.bind(UniformBlocks::SOLUTION_BINDING, m_uniformRing.push(solutionBlock), sizeof(solutionBlock));
 
     m_visibleObjects = 0;
     m_culledObjects = 0;
     m_renderedTriangles = 0;
     m_originalTriangles = 0;
+    m_drawCalls = 0;
 
     // LOD debug colors (Green -> Yellow -> Orange -> Red for LOD 0-5)
     static const glm::vec3 lodDebugColors[] = {
@@ -177,101 +174,187 @@ void Renderer::render(const Scene& scene, const Camera& camera, float aspectRati
         {1.0f, 0.2f, 0.2f}    // LOD 5: Red (lowest detail)
     };
 
-    for (const auto& obj : scene.getObjects()) {
-        if (!obj->isVisible()) {
-            continue;
+    // Candidate list: frustum culling through the scene BVH (whole subtrees at a
+    // time), then occlusion culling. The GPU-driven path frustum-culls in its
+    // compute pass and only needs the list for occlusion and the edge overlay
+    const auto& objects = scene.getObjects();
+    int frustumCulled = 0;
+    m_occludedObjects = 0;
+    if (m_drawPath != DrawPath::GpuDriven || m_occlusionCulling ||
+        m_wireframeMode == WireframeMode::FeatureEdges) {
+        if (m_frustumCulling) {
+            collectVisible(scene, m_candidates);
+            frustumCulled = static_cast<int>(objects.size() - m_candidates.size());
+        } else {
+            m_candidates.resize(objects.size());
+            std::iota(m_candidates.begin(), m_candidates.end(), 0u);
         }
-
-        // Frustum culling
-        if (m_frustumCulling && !m_frustum.isBoxVisible(obj->getWorldBounds())) {
-            ++m_culledObjects;
-            continue;
+        if (m_occlusionCulling) {
+            m_occlusionCuller.cull(scene, view, projection, m_viewportWidth, m_viewportHeight, m_candidates);
+            m_occludedObjects = static_cast<int>(m_occlusionCuller.getOccludedCount());
         }
+    }
 
-        // Calculate screen size for LOD selection
-        float screenSize = 10000.0f;  // Default to max detail
-        bool useLOD = m_lodEnabled && !showSol;  // Disable LOD when showing solution
-        if (useLOD) {
-            glm::vec3 worldCenter = obj->getWorldBounds().getCenter();
-            float worldRadius = obj->getWorldBounds().getRadius();
-            screenSize = LODSelector::calculateScreenSize(
-                worldCenter, worldRadius, view, projection, m_pickingHeight);
-        }
+    if (m_drawPath == DrawPath::GpuDriven) {
+        // Culling, LOD selection and stats happen on the GPU
+        GpuDrivenRenderer::FrameParams params;
+        params.view = view;
+        params.projection = projection;
+        params.frustum = &m_frustum;
+        params.screenHeight = m_viewportHeight;
+        params.lodScale = m_lodScale;
+        params.frustumCulling = m_frustumCulling;
+        params.occluded = m_occlusionCulling ? &m_occlusionCuller.getOccluded() : nullptr;
+        params.lodEnabled = m_lodEnabled && !showSol;
+        params.clusterCulling = m_clusterCulling;
+        params.coneCulling = m_backfaceCulling;
+        params.lodDebugColors = m_lodDebugColors;
+        params.wireframe = isWireframe();
+        params.texturesEnabled = m_texturesEnabled;
+        params.defaultTexture = m_defaultTexture.get();
+        params.textureManager = m_textureManager;
+        m_gpuRenderer.render(scene, params, shader);
+
+        m_visibleObjects = m_gpuRenderer.getVisibleObjects();
+        m_culledObjects = m_gpuRenderer.getCulledObjects();
+        m_renderedTriangles = m_gpuRenderer.getRenderedTriangles();
+        m_originalTriangles = m_gpuRenderer.getOriginalTriangles();
+        m_drawCalls = m_gpuRenderer.getDrawCallCount();
+    } else {
+        m_culledObjects = frustumCulled + m_occludedObjects;
 
-        // Get appropriate mesh (LOD or original)
-        Mesh* meshToRender = nullptr;
-        if (useLOD && obj->hasLOD()) {
-            meshToRender = const_cast<SceneObject*>(obj.get())->getMeshForRendering(screenSize);
-        } else {
-            meshToRender = obj->getMesh();
-        }
+        m_renderQueue.clear();
+        for (uint32_t index : m_candidates) {
+            const auto& obj = objects[index];
+            if (!obj->isVisible()) {
+                continue;
+            }
 
-        if (!meshToRender) {
-            continue;
-        }
+            // Calculate screen size for LOD selection
+            float screenSize = 10000.0f;  // Default to max detail
+            bool useLOD = m_lodEnabled && !showSol;  // Disable LOD when showing solution
+            if (useLOD) {
+                glm::vec3 worldCenter = obj->getWorldBounds().getCenter();
+                float worldRadius = obj->getWorldBounds().getRadius();
+                screenSize = LODSelector::calculateScreenSize(
+                    worldCenter, worldRadius, view, projection, m_viewportHeight) * m_lodScale;
+            }
 
-        ++m_visibleObjects;
+            // Get appropriate mesh (LOD or original)
+            Mesh* meshToRender = nullptr;
+            if (useLOD && obj->hasLOD()) {
+                meshToRender = const_cast<SceneObject*>(obj.get())->getMeshForRendering(screenSize);
+            } else {
+                meshToRender = obj->getMesh();
+            }
 
-        // Track triangle counts for stats
-        m_renderedTriangles += meshToRender->getIndexCount() / 3;
-        if (obj->hasLOD()) {
-            // Get original triangle count from LOD level 0
-            const auto* lod0 = obj->getLODMesh().getLevel(0);
-            if (lod0) {
-                m_originalTriangles += lod0->triangleCount;
+            if (!meshToRender) {
+                continue;
             }
-        } else if (obj->getMesh()) {
-            m_originalTriangles += obj->getMesh()->getIndexCount() / 3;
-        }
 
-        m_meshShader->setMat4("model", obj->getModelMatrix());
+            ++m_visibleObjects;
+
+            // Track triangle counts for stats
+            m_renderedTriangles += meshToRender->getIndexCount() / 3;
+            if (obj->hasLOD()) {
+                // Get original triangle count from LOD level 0
+                const auto* lod0 = obj->getLODMesh().getLevel(0);
+                if (lod0) {
+                    m_originalTriangles += lod0->triangleCount;
+                }
+            } else if (obj->getMesh()) {
+                m_originalTriangles += obj->getMesh()->getIndexCount() / 3;
+            }
 
-        // Determine color
-        glm::vec3 color = obj->getColor();
+            // Determine color
+            glm::vec3 color = obj->getColor();
 
-        // LOD debug colors override
-        if (m_lodDebugColors && obj->hasLOD()) {
-            int lodIndex = obj->getCurrentLODIndex();
-            if (lodIndex >= 0 && lodIndex < 6) {
-                color = lodDebugColors[lodIndex];
+            // LOD debug colors override
+            if (m_lodDebugColors && obj->hasLOD()) {
+                int lodIndex = obj->getCurrentLODIndex();
+                if (lodIndex >= 0 && lodIndex < 6) {
+                    color = lodDebugColors[lodIndex];
+                }
             }
-        }
 
-        // Highlight selected objects
-        if (obj->isSelected()) {
-            color = glm::mix(color, glm::vec3(1.0f, 0.5f, 0.0f), 0.5f);
-        }
-        m_meshShader->setVec3("objectColor", color);
-
-        m_meshShader->setMat3("normalMatrix", obj->getNormalMatrix());
-
-        // Bind texture (only if textures are enabled globally)
-        bool hasObjectTexture = obj->hasTexture();
-        m_meshShader->setBool("hasTexture", m_texturesEnabled);
-        if (m_texturesEnabled) {
-            if (hasObjectTexture) {
-                obj->getTexture()->bind(0);
-            } else if (m_defaultTexture && m_defaultTexture->isValid()) {
-                m_defaultTexture->bind(0);
+            // Highlight selected objects
+            if (obj->isSelected()) {
+                color = glm::mix(color, glm::vec3(1.0f, 0.5f, 0.0f), 0.5f);
+            }
+
+            // Lighten the object under the cursor
+            if (obj->isHovered()) {
+                color = glm::mix(color, glm::vec3(1.0f), 0.25f);
+            }
+
+            // Pick texture (only if textures are enabled globally). Only visible
+            // objects reach this point, so their textures are requested lazily here;
+            // the default texture stands in until the first mip level is resident
+            const Texture* texture = nullptr;
+            if (m_texturesEnabled) {
+                texture = (m_textureManager && obj->hasTexture())
+                    ? m_textureManager->use(obj->getTexture()) : nullptr;
+                if (!texture && m_defaultTexture && m_defaultTexture->isValid()) {
+                    texture = m_defaultTexture.get();
+                }
+            }
+
+            if (m_drawPath == DrawPath::Batched) {
+                m_batchRenderer.add(meshToRender, obj->getModelMatrix(), obj->getNormalMatrix(), color, texture);
+                continue;
             }
+
+            UniformBlocks::Object objectBlock;
+            objectBlock.model = obj->getModelMatrix() * meshToRender->getPositionTransform();
+            objectBlock.normalMatrix = glm::mat4(obj->getNormalMatrix());
+            objectBlock.color = color;
+            objectBlock.padding = 0.0f;
+            const float depth = -(view * glm::vec4(obj->getWorldBounds().getCenter(), 1.0f)).z;
+            m_renderQueue.add(meshToRender, texture, m_uniformRing.push(objectBlock), depth);
         }
-        if (m_wireframe) {
+
+        if (isWireframe()) {
             glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-            meshToRender->draw();
-            glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+        }
+        if (m_drawPath == DrawPath::PerObject) {
+            // Sorted by texture, mesh and depth: few binds, front to back
+            m_renderQueue.sort();
+            m_drawCalls = m_renderQueue.submit(m_uniformRing, UniformBlocks::OBJECT_BINDING,
+                                               sizeof(UniformBlocks::Object));
         } else {
-            meshToRender->draw();
+            m_batchRenderer.flush();
+            m_drawCalls = m_batchRenderer.getDrawCallCount();
+        }
+        if (isWireframe()) {
+            glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
         }
     }
 
+    // The edge overlay is skipped while the camera moves
+    if (m_wireframeMode == WireframeMode::FeatureEdges && !interacting) {
+        renderFeatureEdges(scene, view, projection);
+    }
+    m_geometryArena.endFrame();
+    m_uniformRing.endFrame();
+    if (dynamicResolution) {
+        m_dynamicResolution.endScene();
+    }
+
     // Render stats overlay (always visible, top-right)
     ToggleStates toggles;
-    toggles.wireframe = m_wireframe;
+    toggles.wireframe = m_wireframeMode != WireframeMode::Off;
+    toggles.wireframeMode = getWireframeModeName(m_wireframeMode);
     toggles.backfaceCulling = m_backfaceCulling;
     toggles.frustumCulling = m_frustumCulling;
+    toggles.dynamicResolution = m_dynamicResolution.isEnabled();
+    toggles.occlusionCulling = m_occlusionCulling;
+    toggles.clusterCulling = m_clusterCulling;
     toggles.lodEnabled = m_lodEnabled;
     toggles.lodDebugColors = m_lodDebugColors;
+    toggles.interactiveQuality = m_interactiveQuality;
     toggles.texturesEnabled = m_texturesEnabled;
+    toggles.batchingEnabled = m_drawPath != DrawPath::PerObject;
+    toggles.drawPath = getDrawPathName(m_drawPath);
     toggles.solutionVisualization = m_showSolution;
     toggles.hasSolution = m_multipatchManager && m_multipatchManager->hasSolution();
     toggles.isSolvingPoisson = m_multipatchManager && m_multipatchManager->isSolvingPoisson();
@@ -281,71 +364,189 @@ void Renderer::render(const Scene& scene, const Camera& camera, float aspectRati
     toggles.renderedTriangles = m_renderedTriangles;
     toggles.originalTriangles = m_originalTriangles;
     toggles.lodSavingsPercent = getLODSavingsPercent();
-    m_helpOverlay.renderStats(m_pickingWidth, m_pickingHeight, toggles);
+    toggles.drawCalls = m_drawCalls;
+    toggles.resolutionScale = getResolutionScale();
+    toggles.gpuTimeMs = m_dynamicResolution.getGpuTimeMs();
+    toggles.occludedObjects = static_cast<uint32_t>(m_occludedObjects);
+    toggles.occluders = m_occlusionCulling ? m_occlusionCuller.getOccluderCount() : 0;
+    toggles.clusterStats = m_drawPath == DrawPath::GpuDriven && m_clusterCulling;
+    toggles.drawnClusters = m_gpuRenderer.getDrawnClusters();
+    toggles.testedClusters = m_gpuRenderer.getTestedClusters();
+
+    // All overlays go into one text batch, drawn by end()
+    m_textRenderer.begin(m_viewportWidth, m_viewportHeight);
+    m_helpOverlay.renderStats(m_viewportWidth, toggles);
 
     // Render help overlay on top (toggled with H key)
-    m_helpOverlay.render(m_pickingWidth, m_pickingHeight, toggles);
+    m_helpOverlay.render(toggles);
 
     // Render progress overlay if subdivision, LOD generation, or tessellation is active
-    m_progressOverlay.render(m_pickingWidth, m_pickingHeight, m_subdivisionManager, m_lodManager, m_multipatchManager);
+    m_progressOverlay.render(m_viewportWidth, m_viewportHeight, m_subdivisionManager, m_lodManager, m_multipatchManager);
+    m_textRenderer.end();
 }
 
-int Renderer::pick(const Scene& scene, const Camera& camera, float aspectRatio, int mouseX, int mouseY) {
-    // Bind picking framebuffer
-    glBindFramebuffer(GL_FRAMEBUFFER, m_pickingFBO);
-    glViewport(0, 0, m_pickingWidth, m_pickingHeight);
-
-    // Clear with background color (ID 0 = no object)
-    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+void Renderer::renderFeatureEdges(const Scene& scene, const glm::mat4& view, const glm::mat4& projection) {
+    // Same candidates as the shaded geometry (computed in render() for every path)
+    const auto& objects = scene.getObjects();
 
-    m_pickingShader->use();
+    const glm::vec3 edgeColor(0.05f, 0.05f, 0.07f);
+    const glm::vec3 selectedEdgeColor(1.0f, 0.6f, 0.1f);
 
-    glm::mat4 view = camera.getViewMatrix();
-    glm::mat4 projection = camera.getProjectionMatrix(aspectRatio);
-
-    m_pickingShader->setMat4("view", view);
-    m_pickingShader->setMat4("projection", projection);
-
-    // Render each object with its ID as color (ID starts at 1, 0 = background)
-    uint32_t objectID = 1;
-    for (const auto& obj : scene.getObjects()) {
-        if (!obj->isVisible() || !obj->getMesh()) {
-            ++objectID;
+    m_edgeShader->use();
+    for (uint32_t index : m_candidates) {
+        const auto& obj = objects[index];
+        const auto& edges = obj->getFeatureEdges();
+        if (!obj->isVisible() || !edges || !edges->isUploaded()) {
             continue;
         }
 
-        m_pickingShader->setMat4("model", obj->getModelMatrix());
-        m_pickingShader->setUInt("objectID", objectID);
+        // Fewer, only the most prominent edges for objects small on screen
+        int level = 0;
+        if (m_lodEnabled) {
+            float screenSize = LODSelector::calculateScreenSize(
+                obj->getWorldBounds().getCenter(), obj->getWorldBounds().getRadius(),
+                view, projection, m_viewportHeight) * m_lodScale;
+            level = const_cast<SceneObject*>(obj.get())->selectEdgeLevel(screenSize);
+        }
+
+        UniformBlocks::Object objectBlock;
+        objectBlock.model = obj->getModelMatrix();
+        objectBlock.normalMatrix = glm::mat4(1.0f);
+        objectBlock.color = obj->isSelected() ? selectedEdgeColor : edgeColor;
+        objectBlock.padding = 0.0f;
+        m_uniformRing.bind(UniformBlocks::OBJECT_BINDING, m_uniformRing.push(objectBlock), sizeof(objectBlock));
 
-        obj->draw();
-        ++objectID;
+        edges->draw(level);
+        ++m_drawCalls;
     }
+    glBindVertexArray(0);
+}
 
-    // Read pixel at mouse position (flip Y coordinate)
-    int readX = mouseX;
-    int readY = m_pickingHeight - mouseY - 1;
+void Renderer::collectVisible(const Scene& scene, std::vector<uint32_t>& indices) {
+    m_sceneBVH.update(scene);
+    m_sceneBVH.cull(m_frustum, indices);
+}
 
-    if (readX < 0 || readX >= m_pickingWidth || readY < 0 || readY >= m_pickingHeight) {
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
-        return -1;
+void Renderer::cycleDrawPath() {
+    switch (m_drawPath) {
+        case DrawPath::PerObject: m_drawPath = DrawPath::Batched; break;
+        case DrawPath::Batched:   m_drawPath = DrawPath::GpuDriven; break;
+        case DrawPath::GpuDriven: m_drawPath = DrawPath::PerObject; break;
     }
+}
 
-    unsigned char pixel[3];
-    glReadPixels(readX, readY, 1, 1, GL_RGB, GL_UNSIGNED_BYTE, pixel);
+bool Renderer::pollReadback() {
+    return m_drawPath == DrawPath::GpuDriven && m_gpuRenderer.readBack();
+}
 
-    // Decode object ID from color
-    uint32_t pickedID = pixel[0] | (pixel[1] << 8) | (pixel[2] << 16);
+void Renderer::toggleDynamicResolution() {
+    DynamicResolution::Settings settings = m_dynamicResolution.getSettings();
+    settings.enabled = !settings.enabled;
+    m_dynamicResolution.setSettings(settings);
+}
+
+void Renderer::cycleWireframeMode() {
+    switch (m_wireframeMode) {
+        case WireframeMode::Off:          m_wireframeMode = WireframeMode::FeatureEdges; break;
+        case WireframeMode::FeatureEdges: m_wireframeMode = WireframeMode::Full; break;
+        case WireframeMode::Full:         m_wireframeMode = WireframeMode::Off; break;
+    }
+}
 
-    // Unbind framebuffer and restore viewport
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
-    glViewport(0, 0, m_pickingWidth, m_pickingHeight);
+const char* Renderer::getWireframeModeName(WireframeMode mode) {
+    switch (mode) {
+        case WireframeMode::Off:          return "Off";
+        case WireframeMode::FeatureEdges: return "Edges";
+        case WireframeMode::Full:         return "Full";
+    }
+    return "";
+}
 
-    // Return object index (0-based) or -1 if background
-    if (pickedID == 0) {
-        return -1;
+const char* Renderer::getDrawPathName(DrawPath path) {
+    switch (path) {
+        case DrawPath::PerObject: return "Per-object";
+        case DrawPath::Batched:   return "Batched";
+        case DrawPath::GpuDriven: return "GPU";
     }
-    return static_cast<int>(pickedID - 1);
+    return "";
+}
+
+bool Renderer::raycast(const Scene& scene, const Camera& camera, float aspectRatio,
+                       int mouseX, int mouseY, RayHit& hit) {
+    hit = RayHit();
+    if (mouseX < 0 || mouseX >= m_viewportWidth || mouseY < 0 || mouseY >= m_viewportHeight) {
+        return false;
+    }
+
+    // Unproject the pixel centre on the near and far planes
+    const glm::mat4 inverseViewProjection =
+        glm::inverse(camera.getProjectionMatrix(aspectRatio) * camera.getViewMatrix());
+    const float ndcX = 2.0f * (mouseX + 0.5f) / m_viewportWidth - 1.0f;
+    const float ndcY = 1.0f - 2.0f * (mouseY + 0.5f) / m_viewportHeight;
+    glm::vec4 nearPoint = inverseViewProjection * glm::vec4(ndcX, ndcY, -1.0f, 1.0f);
+    glm::vec4 farPoint = inverseViewProjection * glm::vec4(ndcX, ndcY, 1.0f, 1.0f);
+    nearPoint /= nearPoint.w;
+    farPoint /= farPoint.w;
+
+    Ray ray;
+    ray.origin = glm::vec3(nearPoint);
+    ray.direction = glm::normalize(glm::vec3(farPoint) - glm::vec3(nearPoint));
+
+    const auto& objects = scene.getObjects();
+    m_sceneBVH.update(scene);
+
+    auto testObject = [&](uint32_t index, RayHit& best) {
+        const SceneObject& obj = *objects[index];
+        if (!obj.isVisible() || !obj.getMesh()) {
+            return false;
+        }
+
+        // Object-space ray with an unnormalized direction keeps t in world units
+        const glm::mat4 inverseModel = glm::inverse(obj.getModelMatrix());
+        Ray local;
+        local.origin = glm::vec3(inverseModel * glm::vec4(ray.origin, 1.0f));
+        local.direction = glm::vec3(inverseModel * glm::vec4(ray.direction, 0.0f));
+
+        RayHit candidate;
+        candidate.distance = best.distance;
+        bool found = false;
+        if (const auto& bvh = obj.getTriangleBVH()) {
+            found = bvh->intersect(local, candidate);
+        } else if (!obj.getMeshData().empty()) {
+            // BVH still building: test every triangle
+            found = TriangleBVH::intersectMesh(obj.getMeshData(), local, candidate);
+        } else {
+            // No CPU-side geometry (mesh set directly): bounds only
+            const BoundingBox& box = obj.getWorldBounds();
+            const glm::vec3 t0 = (box.min - ray.origin) / ray.direction;
+            const glm::vec3 t1 = (box.max - ray.origin) / ray.direction;
+            const glm::vec3 tMin = glm::min(t0, t1);
+            const glm::vec3 tMax = glm::max(t0, t1);
+            const float entry = std::max(std::max(tMin.x, tMin.y), std::max(tMin.z, 0.0f));
+            const float exit = std::min(std::min(tMax.x, tMax.y), tMax.z);
+            if (entry <= exit && entry < best.distance) {
+                candidate.distance = entry;
+                candidate.triangle = -1;
+                found = true;
+            }
+        }
+
+        if (!found) {
+            return false;
+        }
+        candidate.objectIndex = static_cast<int>(index);
+        candidate.position = ray.at(candidate.distance);
+        best = candidate;
+        return true;
+    };
+
+    return m_sceneBVH.raycast(ray, testObject, hit);
+}
+
+int Renderer::pick(const Scene& scene, const Camera& camera, float aspectRatio, int mouseX, int mouseY) {
+    RayHit hit;
+    raycast(scene, camera, aspectRatio, mouseX, mouseY, hit);
+    return hit.objectIndex;
 }
 
 void Renderer::renderBackground() {
@@ -1,10 +1,19 @@
 #pragma once
 
 #include "Camera.h"
+#include "BatchRenderer.h"
+#include "DynamicResolution.h"
+#include "GeometryArena.h"
+#include "GpuDrivenRenderer.h"
+#include "OcclusionCuller.h"
+#include "RenderQueue.h"
+#include "UniformBlocks.h"
+#include "UniformRing.h"
 #include "core/Shader.h"
 #include "core/Texture.h"
 #include "scene/Scene.h"
 #include "scene/Frustum.h"
+#include "scene/SceneBVH.h"
 #include "scene/BoundingBox.h"
 #include "util/TextRenderer.h"
 #include "ui/HelpOverlay.h"
@@ -12,10 +21,12 @@
 #include <glm/glm.hpp>
 #include <glad/gl.h>
 #include <memory>
+#include <vector>
 
 class SubdivisionManager;
 class LODManager;
 class MultiPatchManager;
+class TextureManager;
 
 struct Light {
     glm::vec3 direction{-0.5f, -1.0f, -0.3f};
@@ -44,14 +55,28 @@ public:
     void render(const Scene& scene, const Camera& camera, float aspectRatio);
     void resize(int width, int height);
 
+    // Closest object under the pixel, tested on the CPU against the scene BVH
+    // and the objects' triangle BVHs; no GPU round trip
+    bool raycast(const Scene& scene, const Camera& camera, float aspectRatio,
+                 int mouseX, int mouseY, RayHit& hit);
+
     // Picking - returns object index or -1 if nothing picked
     int pick(const Scene& scene, const Camera& camera, float aspectRatio, int mouseX, int mouseY);
 
     void setClearColor(const glm::vec3& color) { m_clearColor = color; }
     const glm::vec3& getClearColor() const { return m_clearColor; }
-    void setWireframe(bool wireframe) { m_wireframe = wireframe; }
-    bool isWireframe() const { return m_wireframe; }
-    void toggleWireframe() { m_wireframe = !m_wireframe; }
+
+    // Line display on top of (or instead of) shaded faces
+    enum class WireframeMode {
+        Off,
+        FeatureEdges,  // Precomputed boundary and crease edges over shaded geometry
+        Full           // Every triangle edge (glPolygonMode)
+    };
+    void setWireframeMode(WireframeMode mode) { m_wireframeMode = mode; }
+    WireframeMode getWireframeMode() const { return m_wireframeMode; }
+    bool isWireframe() const { return m_wireframeMode == WireframeMode::Full; }
+    void cycleWireframeMode();
+    static const char* getWireframeModeName(WireframeMode mode);
 
     void setBackfaceCulling(bool enabled) { m_backfaceCulling = enabled; }
     bool isBackfaceCulling() const { return m_backfaceCulling; }
@@ -63,6 +88,7 @@ public:
     void setSubdivisionManager(SubdivisionManager* manager) { m_subdivisionManager = manager; }
     void setLODManager(LODManager* manager) { m_lodManager = manager; }
     void setMultiPatchManager(MultiPatchManager* manager) { m_multipatchManager = manager; }
+    void setTextureManager(TextureManager* manager) { m_textureManager = manager; }
 
     // LOD controls
     void setLODEnabled(bool enabled) { m_lodEnabled = enabled; }
@@ -73,6 +99,28 @@ public:
     bool isLODDebugColors() const { return m_lodDebugColors; }
     void toggleLODDebugColors() { m_lodDebugColors = !m_lodDebugColors; }
 
+    // Draw submission path
+    enum class DrawPath {
+        PerObject,  // One draw call per object
+        Batched,    // CPU culling, one multi-draw per texture
+        GpuDriven   // Compute culling and LOD selection, one multi-draw per texture
+    };
+    void setDrawPath(DrawPath path) { m_drawPath = path; }
+    DrawPath getDrawPath() const { return m_drawPath; }
+    void cycleDrawPath();
+    static const char* getDrawPathName(DrawPath path);
+    uint32_t getDrawCalls() const { return m_drawCalls; }
+
+    // Interaction-aware quality: while the camera moves, LOD selection is biased
+    // coarser and the edge overlay is skipped; once it stops, the bias is
+    // stepped back to zero over the next frames
+    void setInteractiveQuality(bool enabled) { m_interactiveQuality = enabled; }
+    bool isInteractiveQuality() const { return m_interactiveQuality; }
+    void toggleInteractiveQuality() { m_interactiveQuality = !m_interactiveQuality; }
+    void setInteracting(bool interacting) { m_interacting = interacting; }
+    float getLODBias() const { return m_lodBias; }   // In LOD levels, 0 = full quality
+    bool isRefining() const { return m_lodBias > 0.0f; }
+
     void setTexturesEnabled(bool enabled) { m_texturesEnabled = enabled; }
     bool isTexturesEnabled() const { return m_texturesEnabled; }
     void toggleTextures() { m_texturesEnabled = !m_texturesEnabled; }
@@ -106,22 +154,59 @@ public:
     bool isFrustumCulling() const { return m_frustumCulling; }
     void toggleFrustumCulling() { m_frustumCulling = !m_frustumCulling; }
 
+    // Software occlusion culling against the largest objects' coarsest LODs
+    void setOcclusionCulling(bool enabled) { m_occlusionCulling = enabled; }
+    bool isOcclusionCulling() const { return m_occlusionCulling; }
+    void toggleOcclusionCulling() { m_occlusionCulling = !m_occlusionCulling; }
+
+    // Per-cluster frustum and back-face culling of large meshes (GPU-driven path)
+    void setClusterCulling(bool enabled) { m_clusterCulling = enabled; }
+    bool isClusterCulling() const { return m_clusterCulling; }
+    void toggleClusterCulling() { m_clusterCulling = !m_clusterCulling; }
+
+    // Dynamic resolution: the scene is rendered at a scale that holds a GPU
+    // frame-time target and upscaled; overlays stay at native resolution
+    void setDynamicResolution(const DynamicResolution::Settings& settings) { m_dynamicResolution.setSettings(settings); }
+    const DynamicResolution::Settings& getDynamicResolution() const { return m_dynamicResolution.getSettings(); }
+    void toggleDynamicResolution();
+    float getResolutionScale() const { return m_dynamicResolution.isEnabled() ? m_dynamicResolution.getScale() : 1.0f; }
+    // Still frames (no interaction, LODs refined) are drawn at maxScale; true
+    // if the last frame was not, i.e. one more is needed before going idle
+    bool isResolutionReduced() const { return getResolutionScale() < getDynamicResolution().maxScale; }
+
+    // GPU-driven stats and visibility (which also decide texture requests)
+    // come from a fenced readback that completes after the frame
+    bool hasPendingReadback() const { return m_drawPath == DrawPath::GpuDriven && m_gpuRenderer.hasPendingReadback(); }
+    // Take a completed readback; true if the next frame would show something new
+    bool pollReadback();
+
     // Get last frame's culling stats
     int getVisibleObjects() const { return m_visibleObjects; }
-    int getCulledObjects() const { return m_culledObjects; }
+    int getCulledObjects() const { return m_culledObjects; }    // Frustum and occlusion
+    int getOccludedObjects() const { return m_occludedObjects; }
 
     // Check if a bounding box is visible in the current frustum
     bool isVisible(const BoundingBox& box) const { return m_frustum.isBoxVisible(box); }
 
+    // Indices of scene objects whose bounds intersect the current frustum
+    void collectVisible(const Scene& scene, std::vector<uint32_t>& indices);
+
 private:
     void renderBackground();
-    void initPickingFBO(int width, int height);
-    void cleanupPickingFBO();
+    void renderFeatureEdges(const Scene& scene, const glm::mat4& view, const glm::mat4& projection);
 
     std::unique_ptr<Shader> m_meshShader;
-    std::unique_ptr<Shader> m_pickingShader;
+    std::unique_ptr<Shader> m_batchedMeshShader;
+    std::unique_ptr<Shader> m_gpuMeshShader;
     std::unique_ptr<Shader> m_backgroundShader;
+    std::unique_ptr<Shader> m_edgeShader;
     TextRenderer m_textRenderer;
+    GeometryArena m_geometryArena;  // Shared by both indirect paths; declared first
+    BatchRenderer m_batchRenderer;
+    GpuDrivenRenderer m_gpuRenderer;
+    DynamicResolution m_dynamicResolution;
+    UniformRing m_uniformRing;      // Camera, lighting, solution and per-object blocks
+    RenderQueue m_renderQueue;      // Per-object path draw packets
 
     // Default texture for untextured objects
     std::unique_ptr<Texture> m_defaultTexture;
@@ -130,34 +215,42 @@ private:
     GLuint m_backgroundVAO{0};
     GLuint m_backgroundVBO{0};
 
-    // Picking framebuffer
-    GLuint m_pickingFBO{0};
-    GLuint m_pickingTexture{0};
-    GLuint m_pickingDepth{0};
-    int m_pickingWidth{0};
-    int m_pickingHeight{0};
+    int m_viewportWidth{0};
+    int m_viewportHeight{0};
 
     glm::vec3 m_clearColor{0.1f, 0.1f, 0.15f};
     Light m_light;
     RimLight m_rimLight;
     Background m_background;
-    bool m_wireframe{false};
+    WireframeMode m_wireframeMode{WireframeMode::Off};
     bool m_backfaceCulling{true};
     bool m_frustumCulling{true};
+    bool m_occlusionCulling{true};
+    bool m_clusterCulling{true};
 
     Frustum m_frustum;
+    SceneBVH m_sceneBVH;
+    OcclusionCuller m_occlusionCuller;
+    std::vector<uint32_t> m_candidates;  // Objects passing frustum and occlusion culling this frame
     int m_visibleObjects{0};
     int m_culledObjects{0};
+    int m_occludedObjects{0};
 
     HelpOverlay m_helpOverlay;
     ProgressOverlay m_progressOverlay;
     SubdivisionManager* m_subdivisionManager{nullptr};
     LODManager* m_lodManager{nullptr};
     MultiPatchManager* m_multipatchManager{nullptr};
+    TextureManager* m_textureManager{nullptr};
 
     bool m_lodEnabled{true};
     bool m_lodDebugColors{false};
+    bool m_interactiveQuality{true};
+    bool m_interacting{false};
+    float m_lodBias{0.0f};
+    float m_lodScale{1.0f};       // Screen-size factor for LOD selection, 2^-bias
     bool m_texturesEnabled{true};
+    DrawPath m_drawPath{DrawPath::GpuDriven};
     bool m_showSolution{false};
     bool m_animationPlaying{false};
     bool m_animationLoaded{false};
@@ -165,4 +258,5 @@ private:
     // Triangle count stats
     uint32_t m_renderedTriangles{0};
     uint32_t m_originalTriangles{0};
+    uint32_t m_drawCalls{0};
 };
@@ -0,0 +1,257 @@
+#include "StagingRing.h"
+#include "async/Progress.h"
+#include "mesh/VertexFormat.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+namespace {
+    // Re-check cancellation this often while waiting for ring space
+    constexpr auto SPACE_WAIT = std::chrono::milliseconds(10);
+
+    // Ring regions start at multiples of this (the vertex encoders write 32-bit words)
+    constexpr size_t RING_ALIGNMENT = 4;
+}
+
+// ========== StagedMesh ==========
+
+StagedMesh::~StagedMesh() {
+    if (m_vbo || m_ebo) {
+        m_ring.releaseBuffers(m_vbo, m_ebo);
+    }
+}
+
+void StagedMesh::takeBuffers(GLuint& vbo, GLuint& ebo) {
+    vbo = m_vbo;
+    ebo = m_ebo;
+    m_vbo = 0;
+    m_ebo = 0;
+}
+
+// ========== StagingRing ==========
+
+StagingRing::~StagingRing() {
+    for (FrameFence& frame : m_fences) {
+        glDeleteSync(frame.fence);
+    }
+    if (!m_releasedBuffers.empty()) {
+        glDeleteBuffers(static_cast<GLsizei>(m_releasedBuffers.size()), m_releasedBuffers.data());
+    }
+    if (m_buffer) {
+        glUnmapNamedBuffer(m_buffer);
+        glDeleteBuffers(1, &m_buffer);
+    }
+}
+
+bool StagingRing::init(size_t capacity) {
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+    glCreateBuffers(1, &m_buffer);
+    glNamedBufferStorage(m_buffer, static_cast<GLsizeiptr>(capacity), nullptr, flags);
+    m_mapped = static_cast<uint8_t*>(glMapNamedBufferRange(m_buffer, 0, static_cast<GLsizeiptr>(capacity), flags));
+    if (!m_mapped) {
+        std::cerr << "StagingRing: failed to map " << capacity << " bytes" << std::endl;
+        glDeleteBuffers(1, &m_buffer);
+        m_buffer = 0;
+        return false;
+    }
+
+    m_capacity = capacity;
+    return true;
+}
+
+std::shared_ptr<StagedMesh> StagingRing::stage(const MeshData& data, const Progress* progress) {
+    if (!m_mapped || data.empty()) {
+        return nullptr;
+    }
+
+    const size_t stride = VertexFormat::getStride();
+    const GLenum indexType = VertexFormat::getIndexType(data.vertices.size());
+    const size_t indexSize = VertexFormat::getIndexSize(indexType);
+    const size_t vertexBytes = data.vertices.size() * stride;
+    const size_t indexBytes = data.indices.size() * indexSize;
+    auto staged = std::make_shared<StagedMesh>(*this, vertexBytes, indexBytes);
+
+    // Vertices are quantized and indices narrowed straight into the ring on this worker
+    auto writeVertices = [&](uint8_t* dst, size_t offset, size_t size) {
+        VertexFormat::encode(data.vertices.data() + offset / stride, size / stride,
+                             data.minBounds, data.maxBounds, dst);
+    };
+    auto writeIndices = [&](uint8_t* dst, size_t offset, size_t size) {
+        VertexFormat::encodeIndices(data.indices.data() + offset / indexSize, size / indexSize, indexType, dst);
+    };
+
+    if (!stageBytes(staged, vertexBytes, stride, 0, progress, writeVertices) ||
+        !stageBytes(staged, indexBytes, indexSize, vertexBytes, progress, writeIndices)) {
+        return nullptr;
+    }
+    return staged;
+}
+
+bool StagingRing::stageBytes(const std::shared_ptr<StagedMesh>& target, size_t bytes, size_t unitBytes,
+                             size_t targetOffset, const Progress* progress, const Writer& write) {
+    const size_t chunkBytes = std::max(unitBytes, std::min(CHUNK_BYTES, m_capacity / 2) / unitBytes * unitBytes);
+    size_t written = 0;
+
+    while (written < bytes) {
+        const size_t size = std::min(bytes - written, chunkBytes);
+        // Regions stay aligned for the encoders whatever the element size
+        const size_t reserved = (size + RING_ALIGNMENT - 1) / RING_ALIGNMENT * RING_ALIGNMENT;
+        uint64_t sequence = 0;
+        size_t offset = 0;
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+
+            // A chunk never wraps: skip the tail of the ring if it is too short
+            size_t padding = 0;
+            for (;;) {
+                if (progress && progress->isCancelled()) {
+                    return false;
+                }
+                padding = (m_head + reserved > m_capacity) ? m_capacity - m_head : 0;
+                if (m_used + padding + reserved <= m_capacity) {
+                    break;
+                }
+                m_spaceAvailable.wait_for(lock, SPACE_WAIT);
+            }
+
+            if (padding > 0) {
+                m_chunks.push_back(Chunk{m_nextSequence++, m_head, padding, 0, {}, 0, true, false});
+                m_used += padding;
+                m_head = 0;
+            }
+
+            sequence = m_nextSequence++;
+            offset = m_head;
+            m_chunks.push_back(Chunk{sequence, offset, reserved, size, target, targetOffset, false, false});
+            m_used += reserved;
+            m_head = (m_head + reserved) % m_capacity;
+        }
+
+        // The region is ours until the main thread copies it
+        write(m_mapped + offset, written, size);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_chunks[sequence - m_chunks.front().sequence].written = true;
+        }
+        if (m_wakeCallback) {
+            m_wakeCallback();
+        }
+
+        written += size;
+        targetOffset += size;
+    }
+    return true;
+}
+
+void StagingRing::update(size_t budgetBytes) {
+    std::vector<GLuint> released;
+    {
+        std::lock_guard<std::mutex> lock(m_releaseMutex);
+        released.swap(m_releasedBuffers);
+    }
+    if (!released.empty()) {
+        glDeleteBuffers(static_cast<GLsizei>(released.size()), released.data());
+    }
+
+    if (!m_mapped) return;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    retireChunks();
+
+    // Copy in ring order; the first chunk always goes so oversized chunks progress
+    size_t copiedBytes = 0;
+    uint64_t lastCopied = 0;
+    while (m_nextCopy < m_chunks.size()) {
+        Chunk& chunk = m_chunks[m_nextCopy];
+        if (!chunk.written) break;
+        if (copiedBytes > 0 && copiedBytes + chunk.copyBytes > budgetBytes) break;
+
+        copiedBytes += copyChunk(chunk);
+        chunk.copied = true;
+        lastCopied = chunk.sequence;
+        ++m_nextCopy;
+    }
+
+    if (lastCopied != 0) {
+        m_fences.push_back(FrameFence{glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0), lastCopied});
+    }
+}
+
+size_t StagingRing::copyChunk(Chunk& chunk) {
+    std::shared_ptr<StagedMesh> target = chunk.target.lock();
+    if (!target || chunk.copyBytes == 0) {
+        return 0;
+    }
+
+    // Destination storage without data: allocating is cheap, filling happens below
+    if (!target->m_vbo) {
+        glCreateBuffers(1, &target->m_vbo);
+        glNamedBufferStorage(target->m_vbo, static_cast<GLsizeiptr>(target->m_vertexBytes), nullptr, 0);
+        if (target->m_indexBytes > 0) {
+            glCreateBuffers(1, &target->m_ebo);
+            glNamedBufferStorage(target->m_ebo, static_cast<GLsizeiptr>(target->m_indexBytes), nullptr, 0);
+        }
+    }
+
+    const bool vertexData = chunk.targetOffset < target->m_vertexBytes;
+    const GLuint destination = vertexData ? target->m_vbo : target->m_ebo;
+    const size_t destinationOffset = vertexData ? chunk.targetOffset : chunk.targetOffset - target->m_vertexBytes;
+    glCopyNamedBufferSubData(m_buffer, destination, static_cast<GLintptr>(chunk.offset),
+                             static_cast<GLintptr>(destinationOffset), static_cast<GLsizeiptr>(chunk.copyBytes));
+
+    target->m_copiedBytes += chunk.copyBytes;
+    if (target->m_copiedBytes == target->m_vertexBytes + target->m_indexBytes) {
+        target->m_lastChunk = chunk.sequence;
+    }
+    return chunk.copyBytes;
+}
+
+void StagingRing::retireChunks() {
+    bool freed = false;
+
+    while (!m_fences.empty()) {
+        FrameFence& frame = m_fences.front();
+        GLenum result = glClientWaitSync(frame.fence, 0, 0);
+        if (result != GL_ALREADY_SIGNALED && result != GL_CONDITION_SATISFIED) {
+            break;
+        }
+
+        while (!m_chunks.empty() && m_chunks.front().copied &&
+               m_chunks.front().sequence <= frame.lastChunk) {
+            Chunk& chunk = m_chunks.front();
+            if (std::shared_ptr<StagedMesh> target = chunk.target.lock()) {
+                if (target->m_lastChunk == chunk.sequence) {
+                    target->m_ready = true;
+                }
+            }
+            m_used -= chunk.size;
+            m_chunks.pop_front();
+            --m_nextCopy;
+            freed = true;
+        }
+
+        glDeleteSync(frame.fence);
+        m_fences.pop_front();
+    }
+
+    if (m_chunks.empty()) {
+        m_head = 0;
+    }
+    if (freed) {
+        m_spaceAvailable.notify_all();
+    }
+}
+
+bool StagingRing::hasPendingWork() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return !m_chunks.empty();
+}
+
+void StagingRing::releaseBuffers(GLuint vbo, GLuint ebo) {
+    std::lock_guard<std::mutex> lock(m_releaseMutex);
+    if (vbo) m_releasedBuffers.push_back(vbo);
+    if (ebo) m_releasedBuffers.push_back(ebo);
+}
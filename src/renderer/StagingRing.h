@@ -0,0 +1,144 @@
+#pragma once
+
+#include <glad/gl.h>
+#include "mesh/MeshData.h"
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+struct Progress;
+class StagingRing;
+
+// One mesh transferred through a StagingRing. The destination buffers are
+// created on the main thread when the first chunk is copied; once every copy
+// has finished on the GPU, a Mesh takes them over (see Mesh::uploadStaged).
+// Chunks of a StagedMesh nobody holds any more are skipped.
+class StagedMesh {
+public:
+    StagedMesh(StagingRing& ring, size_t vertexBytes, size_t indexBytes)
+        : m_ring(ring), m_vertexBytes(vertexBytes), m_indexBytes(indexBytes) {}
+    ~StagedMesh();
+
+    StagedMesh(const StagedMesh&) = delete;
+    StagedMesh& operator=(const StagedMesh&) = delete;
+
+    // All bytes copied and the copies completed (main thread only)
+    bool isReady() const { return m_ready; }
+
+    // Hand the destination buffers to the caller (main thread, once ready)
+    void takeBuffers(GLuint& vbo, GLuint& ebo);
+
+private:
+    friend class StagingRing;
+
+    StagingRing& m_ring;
+    size_t m_vertexBytes;
+    size_t m_indexBytes;
+    GLuint m_vbo{0};
+    GLuint m_ebo{0};
+
+    // Main-thread state
+    size_t m_copiedBytes{0};
+    uint64_t m_lastChunk{0};    // Sequence number of the chunk finishing the copy
+    bool m_ready{false};
+};
+
+// Persistently mapped upload ring shared by the background workers. A worker
+// copies a finished mesh into the ring in fixed-size chunks, waiting while the
+// ring is full; the main thread copies ready chunks into the destination
+// buffers with glCopyNamedBufferSubData, at most a byte budget per frame, and
+// recycles a chunk's region once the fence of the frame that copied it has
+// signalled. Large results thus reach the GPU over several frames instead of
+// one glNamedBufferStorage call that stalls the frame.
+class StagingRing {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 64ull << 20;
+    static constexpr size_t DEFAULT_FRAME_BUDGET = 16ull << 20;
+    static constexpr size_t CHUNK_BYTES = 4ull << 20;
+
+    StagingRing() = default;
+    ~StagingRing();
+
+    StagingRing(const StagingRing&) = delete;
+    StagingRing& operator=(const StagingRing&) = delete;
+
+    // Main thread, with a current context
+    bool init(size_t capacity = DEFAULT_CAPACITY);
+
+    // Worker thread: copy the mesh into the ring, vertices and indices in the GPU
+    // layout (see VertexFormat). Blocks while the ring is full; returns null
+    // if the task is cancelled meanwhile (the caller then falls back to a
+    // direct upload). Managers cancel their active task before joining, so
+    // shutdown never waits on the ring.
+    std::shared_ptr<StagedMesh> stage(const MeshData& data, const Progress* progress = nullptr);
+
+    // Main thread, once per frame: copy up to budgetBytes of staged chunks
+    // and recycle regions whose copies have completed
+    void update(size_t budgetBytes = DEFAULT_FRAME_BUDGET);
+
+    // Chunks waiting to be copied or for their copies to complete
+    bool hasPendingWork() const;
+
+    // Called on the worker thread whenever a chunk is staged
+    void setWakeCallback(std::function<void()> callback) { m_wakeCallback = std::move(callback); }
+
+    size_t getCapacity() const { return m_capacity; }
+
+private:
+    struct Chunk {
+        uint64_t sequence;
+        size_t offset;
+        size_t size;        // Region size: aligned, or the padding skipped at the end of the ring
+        size_t copyBytes;   // 0 for padding
+        std::weak_ptr<StagedMesh> target;
+        size_t targetOffset;   // Byte offset in the target's vertex + index data
+        bool written{false};
+        bool copied{false};
+    };
+
+    friend class StagedMesh;
+
+    struct FrameFence {
+        GLsync fence;
+        uint64_t lastChunk;   // Chunks up to this sequence number were copied before the fence
+    };
+
+    // Writes bytes [offset, offset + size) of one array into dst
+    using Writer = std::function<void(uint8_t* dst, size_t offset, size_t size)>;
+
+    // Stage one array in chunks of whole elements of unitBytes
+    bool stageBytes(const std::shared_ptr<StagedMesh>& target, size_t bytes, size_t unitBytes,
+                    size_t targetOffset, const Progress* progress, const Writer& write);
+    size_t copyChunk(Chunk& chunk);
+    void retireChunks();
+
+    // Buffers of a StagedMesh dropped before a Mesh took them; deleted on the
+    // main thread since the last reference may go away on a worker
+    void releaseBuffers(GLuint vbo, GLuint ebo);
+
+    GLuint m_buffer{0};
+    uint8_t* m_mapped{nullptr};
+    size_t m_capacity{0};
+
+    // Ring state, guarded by m_mutex
+    mutable std::mutex m_mutex;
+    std::condition_variable m_spaceAvailable;
+    std::deque<Chunk> m_chunks;     // In ring order
+    size_t m_head{0};               // Next free offset
+    size_t m_used{0};
+    uint64_t m_nextSequence{1};
+
+    std::mutex m_releaseMutex;
+    std::vector<GLuint> m_releasedBuffers;
+
+    // Main-thread state
+    std::deque<FrameFence> m_fences;
+    size_t m_nextCopy{0};           // Index into m_chunks of the first chunk not yet copied
+
+    std::function<void()> m_wakeCallback;
+};
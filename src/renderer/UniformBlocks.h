@@ -0,0 +1,56 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+
+// std140 uniform blocks shared by the mesh shaders. Layouts must match the
+// block declarations in shaders/mesh*.vert and shaders/mesh.frag.
+namespace UniformBlocks {
+
+// Uniform buffer binding points
+constexpr uint32_t CAMERA_BINDING = 0;
+constexpr uint32_t LIGHTING_BINDING = 1;
+constexpr uint32_t SOLUTION_BINDING = 2;
+constexpr uint32_t OBJECT_BINDING = 3;   // Per-object path only
+
+struct Camera {
+    glm::mat4 view;
+    glm::mat4 projection;
+    glm::vec3 viewPos;
+    float padding;
+};
+
+// vec3 members are followed by a float so each pair fills one 16-byte slot
+struct Lighting {
+    glm::vec3 direction;   // Normalized
+    float ambient;
+    glm::vec3 color;
+    float diffuse;
+    glm::vec3 rimColor;
+    float specular;
+    float rimStrength;
+    uint32_t hasTexture;   // GLSL bool
+    float padding[2];
+};
+
+struct Solution {
+    uint32_t showSolution;  // GLSL bool
+    float solutionMin;
+    float solutionMax;
+    float padding;
+};
+
+struct Object {
+    glm::mat4 model;
+    glm::mat4 normalMatrix;  // mat3 padded to columns of vec4
+    glm::vec3 color;
+    float padding;
+};
+
+static_assert(sizeof(Camera) == 144, "Camera block must match std140");
+static_assert(offsetof(Lighting, rimStrength) == 48 && sizeof(Lighting) == 64, "Lighting block must match std140");
+static_assert(sizeof(Solution) == 16, "Solution block must match std140");
+static_assert(offsetof(Object, color) == 128 && sizeof(Object) == 144, "Object block must match std140");
+
+} // namespace UniformBlocks
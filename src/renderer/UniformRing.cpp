@@ -0,0 +1,103 @@
+#include "UniformRing.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace {
+    constexpr size_t INITIAL_REGION_BYTES = 64 * 1024;
+}
+
+UniformRing::~UniformRing() {
+    release();
+}
+
+void UniformRing::init() {
+    GLint alignment = 0;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    if (alignment > 0) {
+        m_alignment = static_cast<size_t>(alignment);
+    }
+    allocate(INITIAL_REGION_BYTES);
+}
+
+void UniformRing::beginFrame(size_t bytes) {
+    if (bytes > m_regionBytes) {
+        // Orphans the old buffer; the driver keeps it alive for in-flight frames
+        allocate(std::max(bytes, m_regionBytes * 2));
+    }
+
+    m_region = (m_region + 1) % FRAME_COUNT;
+    m_cursor = 0;
+
+    // Wait until the GPU has finished the frame that last used this region
+    if (GLsync fence = m_fences[m_region]) {
+        GLenum status = glClientWaitSync(fence, 0, 0);
+        while (status == GL_TIMEOUT_EXPIRED) {
+            status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);  // 1 ms
+        }
+        if (status == GL_WAIT_FAILED) {
+            std::cerr << "UniformRing: fence wait failed" << std::endl;
+        }
+        glDeleteSync(fence);
+        m_fences[m_region] = nullptr;
+    }
+}
+
+void UniformRing::endFrame() {
+    if (m_fences[m_region]) {
+        glDeleteSync(m_fences[m_region]);
+    }
+    m_fences[m_region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+GLintptr UniformRing::push(const void* data, size_t size) {
+    const size_t aligned = alignedSize(size);
+    if (!m_mapped || m_cursor + aligned > m_regionBytes) {
+        return -1;
+    }
+
+    const size_t offset = static_cast<size_t>(m_region) * m_regionBytes + m_cursor;
+    std::memcpy(m_mapped + offset, data, size);
+    m_cursor += aligned;
+    return static_cast<GLintptr>(offset);
+}
+
+void UniformRing::bind(GLuint binding, GLintptr offset, size_t size) const {
+    if (offset >= 0) {
+        glBindBufferRange(GL_UNIFORM_BUFFER, binding, m_buffer, offset, static_cast<GLsizeiptr>(size));
+    }
+}
+
+size_t UniformRing::alignedSize(size_t size) const {
+    return (size + m_alignment - 1) / m_alignment * m_alignment;
+}
+
+void UniformRing::allocate(size_t regionBytes) {
+    release();
+
+    m_regionBytes = alignedSize(regionBytes);
+    const size_t totalBytes = m_regionBytes * FRAME_COUNT;
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+    glCreateBuffers(1, &m_buffer);
+    glNamedBufferStorage(m_buffer, static_cast<GLsizeiptr>(totalBytes), nullptr, flags);
+    m_mapped = static_cast<uint8_t*>(glMapNamedBufferRange(m_buffer, 0, static_cast<GLsizeiptr>(totalBytes), flags));
+    if (!m_mapped) {
+        std::cerr << "UniformRing: failed to map " << totalBytes << " bytes" << std::endl;
+    }
+}
+
+void UniformRing::release() {
+    for (GLsync& fence : m_fences) {
+        if (fence) {
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+    }
+    if (m_buffer) {
+        glUnmapNamedBuffer(m_buffer);
+        glDeleteBuffers(1, &m_buffer);
+        m_buffer = 0;
+    }
+    m_mapped = nullptr;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <glad/gl.h>
+#include <cstddef>
+#include <cstdint>
+
+// Persistently mapped, triple-buffered uniform buffer. Each frame writes into
+// its own third of the buffer while the GPU may still read the previous two;
+// a fence per region makes beginFrame() wait only if the GPU falls three
+// frames behind. Blocks are bound with glBindBufferRange at their offset, so
+// per-object updates are a memcpy plus one bind instead of uniform lookups.
+class UniformRing {
+public:
+    static constexpr int FRAME_COUNT = 3;
+
+    UniformRing() = default;
+    ~UniformRing();
+
+    UniformRing(const UniformRing&) = delete;
+    UniformRing& operator=(const UniformRing&) = delete;
+
+    void init();
+
+    // Start the next frame region with room for at least the given bytes of
+    // blocks (aligned as push() places them). Grows the buffer if needed.
+    void beginFrame(size_t bytes);
+
+    // Fence the current region once all draws reading it are submitted
+    void endFrame();
+
+    // Copy a block into the current region; returns its offset (-1 if full)
+    GLintptr push(const void* data, size_t size);
+
+    template<typename Block>
+    GLintptr push(const Block& block) { return push(&block, sizeof(Block)); }
+
+    // Bind size bytes at offset to a uniform binding point
+    void bind(GLuint binding, GLintptr offset, size_t size) const;
+
+    // Space a block of the given size takes in the ring
+    size_t alignedSize(size_t size) const;
+
+private:
+    void allocate(size_t regionBytes);
+    void release();
+
+    GLuint m_buffer{0};
+    uint8_t* m_mapped{nullptr};
+    size_t m_regionBytes{0};
+    size_t m_alignment{256};
+
+    int m_region{0};
+    size_t m_cursor{0};           // Write offset within the current region
+    GLsync m_fences[FRAME_COUNT]{};
+};
@@ -111,6 +111,9 @@ public:
         return true;
     }
 
+    // Normalized planes (a, b, c, d); a point is inside if dot(abc, p) + d >= 0
+    const std::array<glm::vec4, Count>& getPlanes() const { return m_planes; }
+
 private:
     std::array<glm::vec4, Count> m_planes;
 };
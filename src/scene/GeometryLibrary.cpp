@@ -0,0 +1,72 @@
+#include "GeometryLibrary.h"
+#include "util/Hash.h"
+#include <limits>
+#include <vector>
+
+std::shared_ptr<SharedGeometry> GeometryLibrary::find(const MeshData& data, glm::vec3& offset) const {
+    if (data.empty()) {
+        return nullptr;
+    }
+
+    const glm::vec3 origin = minimumCorner(data);
+    auto range = m_entries.equal_range(contentHash(data));
+    for (auto it = range.first; it != range.second; ++it) {
+        auto geometry = it->second.lock();
+        if (!geometry) {
+            continue;
+        }
+
+        // Hash collisions and geometry modified since it was added fail here
+        const glm::vec3 geometryOrigin = minimumCorner(geometry->meshData);
+        if (sameContent(data, origin, geometry->meshData, geometryOrigin)) {
+            offset = origin - geometryOrigin;
+            return geometry;
+        }
+    }
+    return nullptr;
+}
+
+void GeometryLibrary::add(const std::shared_ptr<SharedGeometry>& geometry) {
+    if (geometry && !geometry->meshData.empty()) {
+        m_entries.emplace(contentHash(geometry->meshData), geometry);
+    }
+}
+
+uint64_t GeometryLibrary::contentHash(const MeshData& data) {
+    const glm::vec3 origin = minimumCorner(data);
+
+    std::vector<Vertex> relative(data.vertices);
+    for (auto& vertex : relative) {
+        vertex.position -= origin;
+    }
+
+    uint64_t h = Hash::bytes(relative.data(), relative.size() * sizeof(Vertex));
+    h = Hash::bytes(data.indices.data(), data.indices.size() * sizeof(uint32_t), h);
+    return Hash::string(data.texturePath, h);
+}
+
+glm::vec3 GeometryLibrary::minimumCorner(const MeshData& data) {
+    glm::vec3 corner(std::numeric_limits<float>::max());
+    for (const auto& vertex : data.vertices) {
+        corner = glm::min(corner, vertex.position);
+    }
+    return corner;
+}
+
+bool GeometryLibrary::sameContent(const MeshData& a, const glm::vec3& originA,
+                                  const MeshData& b, const glm::vec3& originB) {
+    if (a.vertices.size() != b.vertices.size() || a.indices != b.indices ||
+        a.texturePath != b.texturePath) {
+        return false;
+    }
+
+    for (size_t i = 0; i < a.vertices.size(); ++i) {
+        const Vertex& va = a.vertices[i];
+        const Vertex& vb = b.vertices[i];
+        if (va.position - originA != vb.position - originB || va.normal != vb.normal ||
+            va.texCoord != vb.texCoord || va.solutionValue != vb.solutionValue) {
+            return false;
+        }
+    }
+    return true;
+}
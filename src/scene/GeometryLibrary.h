@@ -0,0 +1,36 @@
+#pragma once
+
+#include "SharedGeometry.h"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+
+// Content-addressed index of loaded geometry for load-time instancing.
+// Meshes are compared relative to the minimum corner of their bounds, so
+// copies of a part that only differ by a translation baked into the vertices
+// (typical for exported assemblies) are recognised as the same geometry.
+class GeometryLibrary {
+public:
+    GeometryLibrary() = default;
+
+    // Geometry with exactly the same content as data (up to a translation), or
+    // null. offset receives the translation that places it where data lies.
+    std::shared_ptr<SharedGeometry> find(const MeshData& data, glm::vec3& offset) const;
+
+    // Make geometry available to later find() calls
+    void add(const std::shared_ptr<SharedGeometry>& geometry);
+
+    void clear() { m_entries.clear(); }
+
+    // Hash of vertices (positions relative to their minimum), indices and texture
+    static uint64_t contentHash(const MeshData& data);
+
+private:
+    static glm::vec3 minimumCorner(const MeshData& data);
+    static bool sameContent(const MeshData& a, const glm::vec3& originA,
+                            const MeshData& b, const glm::vec3& originB);
+
+    // Entries do not keep geometry alive; expired ones are skipped
+    std::unordered_multimap<uint64_t, std::weak_ptr<SharedGeometry>> m_entries;
+};
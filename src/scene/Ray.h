@@ -0,0 +1,27 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <limits>
+
+// Ray with origin and direction; points are origin + t * direction.
+// The direction does not have to be normalized (object-space rays keep the
+// world-space parameter t).
+struct Ray {
+    glm::vec3 origin{0.0f};
+    glm::vec3 direction{0.0f, 0.0f, -1.0f};
+
+    glm::vec3 at(float t) const {
+        return origin + direction * t;
+    }
+};
+
+// Closest intersection found along a ray
+struct RayHit {
+    float distance{std::numeric_limits<float>::max()};  // Ray parameter t
+    int objectIndex{-1};
+    int triangle{-1};                  // -1 if only the object's bounds were hit
+    glm::vec3 position{0.0f};          // World space
+    glm::vec3 barycentric{0.0f};       // Weights of the triangle's vertices 0, 1, 2
+
+    bool isHit() const { return objectIndex >= 0; }
+};
@@ -32,6 +32,15 @@ void Scene::update() {
     }
 }
 
+bool Scene::hasPendingUploads() const {
+    for (const auto& obj : m_objects) {
+        if (obj->getMesh() && obj->getMesh()->hasPendingUpload()) {
+            return true;
+        }
+    }
+    return false;
+}
+
 SceneObject* Scene::getObject(size_t index) const {
     if (index < m_objects.size()) {
         return m_objects[index].get();
@@ -17,6 +17,9 @@ public:
     // Call each frame to update all objects (checks for async GPU uploads)
     void update();
 
+    // Any object mesh with an async upload that has not swapped in yet
+    bool hasPendingUploads() const;
+
     SceneObject* getObject(size_t index) const;
     SceneObject* findObject(const std::string& name) const;
     size_t getObjectCount() const { return m_objects.size(); }
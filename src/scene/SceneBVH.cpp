@@ -0,0 +1,415 @@
+#include "SceneBVH.h"
+#include "Scene.h"
+#include <algorithm>
+#include <iterator>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define SCENE_BVH_SSE 1
+#endif
+
+namespace {
+    // Rebuild once refits have grown the summed child area by this factor
+    constexpr float REBUILD_AREA_RATIO = 2.0f;
+
+    float surfaceArea(const BoundingBox& box) {
+        if (!box.isValid()) {
+            return 0.0f;
+        }
+        glm::vec3 size = box.getSize();
+        return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+    }
+
+    bool sameBounds(const BoundingBox& a, const BoundingBox& b) {
+        return a.min == b.min && a.max == b.max;
+    }
+}
+
+void SceneBVH::update(const Scene& scene) {
+    const auto& objects = scene.getObjects();
+    if (objects.size() == m_objects.size() && SceneObject::getLatestRevision() == m_syncedRevision) {
+        return;
+    }
+
+    bool needsRebuild = objects.size() != m_objects.size();
+    for (size_t i = 0; i < objects.size() && !needsRebuild; ++i) {
+        needsRebuild = objects[i].get() != m_objects[i];
+    }
+
+    if (!needsRebuild) {
+        // Same objects: refit only those whose bounds moved
+        for (size_t i = 0; i < objects.size(); ++i) {
+            const SceneObject& object = *objects[i];
+            if (object.getRevision() == m_revisions[i]) {
+                continue;
+            }
+            m_revisions[i] = object.getRevision();
+            if (!sameBounds(object.getWorldBounds(), m_bounds[i])) {
+                refit(static_cast<uint32_t>(i), object.getWorldBounds());
+            }
+        }
+        needsRebuild = m_area > REBUILD_AREA_RATIO * m_builtArea;
+    }
+
+    if (needsRebuild) {
+        rebuild(scene);
+    }
+    m_syncedRevision = SceneObject::getLatestRevision();
+}
+
+void SceneBVH::cull(const Frustum& frustum, std::vector<uint32_t>& visible) const {
+    visible.clear();
+    if (m_nodes.empty()) {
+        return;
+    }
+
+    const auto& planes = frustum.getPlanes();
+    constexpr uint32_t ALL_PLANES = (1u << Frustum::Count) - 1;
+
+    // Each entry carries the planes its box still straddles
+    struct Entry {
+        uint32_t node;
+        uint32_t planeMask;
+    };
+    Entry stack[64];
+    int stackSize = 0;
+    stack[stackSize++] = Entry{0, ALL_PLANES};
+
+    while (stackSize > 0) {
+        const Entry entry = stack[--stackSize];
+        const Node& node = m_nodes[entry.node];
+        const uint32_t childMask = (1u << node.childCount) - 1;
+
+        uint32_t outside = 0;
+        uint32_t straddling[4] = {0, 0, 0, 0};
+        for (uint32_t p = 0; p < Frustum::Count; ++p) {
+            if (!(entry.planeMask & (1u << p))) {
+                continue;
+            }
+
+            uint32_t planeOutside = 0;
+            uint32_t planeInside = 0;
+            classify(node, planes[p], planeOutside, planeInside);
+            outside |= planeOutside;
+            if ((outside & childMask) == childMask) {
+                break;
+            }
+            for (uint32_t i = 0; i < 4; ++i) {
+                if (!(planeInside & (1u << i))) {
+                    straddling[i] |= 1u << p;
+                }
+            }
+        }
+
+        for (uint32_t i = 0; i < node.childCount; ++i) {
+            if (outside & (1u << i)) {
+                continue;
+            }
+
+            const int32_t child = node.child[i];
+            if (child < 0) {
+                visible.push_back(static_cast<uint32_t>(~child));
+            } else if (straddling[i] == 0) {
+                // Entirely inside: take the whole subtree without testing it
+                const Node& inner = m_nodes[child];
+                visible.insert(visible.end(), m_items.begin() + inner.firstItem,
+                               m_items.begin() + inner.firstItem + inner.itemCount);
+            } else {
+                stack[stackSize++] = Entry{static_cast<uint32_t>(child), straddling[i]};
+            }
+        }
+    }
+}
+
+void SceneBVH::classify(const Node& node, const glm::vec4& plane, uint32_t& outside, uint32_t& inside) {
+    // Positive vertex (max of each product) decides "outside", negative vertex
+    // (min) decides "entirely inside"; same sum order as Frustum::isBoxVisible
+#ifdef SCENE_BVH_SSE
+    const __m128 a = _mm_set1_ps(plane.x);
+    const __m128 b = _mm_set1_ps(plane.y);
+    const __m128 c = _mm_set1_ps(plane.z);
+    const __m128 d = _mm_set1_ps(plane.w);
+
+    const __m128 x0 = _mm_mul_ps(a, _mm_load_ps(node.minX));
+    const __m128 x1 = _mm_mul_ps(a, _mm_load_ps(node.maxX));
+    const __m128 y0 = _mm_mul_ps(b, _mm_load_ps(node.minY));
+    const __m128 y1 = _mm_mul_ps(b, _mm_load_ps(node.maxY));
+    const __m128 z0 = _mm_mul_ps(c, _mm_load_ps(node.minZ));
+    const __m128 z1 = _mm_mul_ps(c, _mm_load_ps(node.maxZ));
+
+    const __m128 positive = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_max_ps(x0, x1), _mm_max_ps(y0, y1)),
+                                                  _mm_max_ps(z0, z1)), d);
+    const __m128 negative = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_min_ps(x0, x1), _mm_min_ps(y0, y1)),
+                                                  _mm_min_ps(z0, z1)), d);
+
+    const __m128 zero = _mm_setzero_ps();
+    outside = static_cast<uint32_t>(_mm_movemask_ps(_mm_cmplt_ps(positive, zero)));
+    inside = static_cast<uint32_t>(_mm_movemask_ps(_mm_cmpge_ps(negative, zero)));
+#else
+    outside = 0;
+    inside = 0;
+    for (int i = 0; i < 4; ++i) {
+        const float x0 = plane.x * node.minX[i], x1 = plane.x * node.maxX[i];
+        const float y0 = plane.y * node.minY[i], y1 = plane.y * node.maxY[i];
+        const float z0 = plane.z * node.minZ[i], z1 = plane.z * node.maxZ[i];
+        const float positive = std::max(x0, x1) + std::max(y0, y1) + std::max(z0, z1) + plane.w;
+        const float negative = std::min(x0, x1) + std::min(y0, y1) + std::min(z0, z1) + plane.w;
+        if (positive < 0.0f) outside |= 1u << i;
+        if (negative >= 0.0f) inside |= 1u << i;
+    }
+#endif
+}
+
+bool SceneBVH::raycast(const Ray& ray, const std::function<bool(uint32_t, RayHit&)>& testObject,
+                       RayHit& hit) const {
+    if (m_nodes.empty()) {
+        return false;
+    }
+
+    const glm::vec3 invDirection = 1.0f / ray.direction;
+
+    // Children are pushed far to near, so the nearest is popped first
+    struct Entry {
+        int32_t child;
+        float distance;
+    };
+    Entry stack[256];
+    int stackSize = 0;
+    stack[stackSize++] = Entry{0, 0.0f};
+    bool found = false;
+
+    while (stackSize > 0) {
+        const Entry entry = stack[--stackSize];
+        if (entry.distance > hit.distance) {
+            continue;
+        }
+
+        if (entry.child < 0) {
+            found |= testObject(static_cast<uint32_t>(~entry.child), hit);
+            continue;
+        }
+
+        const Node& node = m_nodes[entry.child];
+        float distances[4];
+        const uint32_t mask = intersectChildren(node, ray.origin, invDirection, hit.distance, distances);
+
+        int order[4];
+        int orderCount = 0;
+        for (int i = 0; i < static_cast<int>(node.childCount); ++i) {
+            if (!(mask & (1u << i))) {
+                continue;
+            }
+            // Insertion sort by descending entry distance
+            int j = orderCount++;
+            while (j > 0 && distances[order[j - 1]] < distances[i]) {
+                order[j] = order[j - 1];
+                --j;
+            }
+            order[j] = i;
+        }
+        for (int k = 0; k < orderCount && stackSize < 256; ++k) {
+            stack[stackSize++] = Entry{node.child[order[k]], distances[order[k]]};
+        }
+    }
+
+    return found;
+}
+
+uint32_t SceneBVH::intersectChildren(const Node& node, const glm::vec3& origin, const glm::vec3& invDirection,
+                                     float maxDistance, float entry[4]) {
+    // Slab test against all four child boxes
+#ifdef SCENE_BVH_SSE
+    const __m128 ox = _mm_set1_ps(origin.x);
+    const __m128 oy = _mm_set1_ps(origin.y);
+    const __m128 oz = _mm_set1_ps(origin.z);
+    const __m128 ix = _mm_set1_ps(invDirection.x);
+    const __m128 iy = _mm_set1_ps(invDirection.y);
+    const __m128 iz = _mm_set1_ps(invDirection.z);
+
+    const __m128 x0 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.minX), ox), ix);
+    const __m128 x1 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.maxX), ox), ix);
+    const __m128 y0 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.minY), oy), iy);
+    const __m128 y1 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.maxY), oy), iy);
+    const __m128 z0 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.minZ), oz), iz);
+    const __m128 z1 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.maxZ), oz), iz);
+
+    const __m128 tNear = _mm_max_ps(_mm_max_ps(_mm_min_ps(x0, x1), _mm_min_ps(y0, y1)),
+                                    _mm_max_ps(_mm_min_ps(z0, z1), _mm_setzero_ps()));
+    const __m128 tFar = _mm_min_ps(_mm_min_ps(_mm_max_ps(x0, x1), _mm_max_ps(y0, y1)),
+                                   _mm_min_ps(_mm_max_ps(z0, z1), _mm_set1_ps(maxDistance)));
+
+    _mm_storeu_ps(entry, tNear);
+    return static_cast<uint32_t>(_mm_movemask_ps(_mm_cmple_ps(tNear, tFar)));
+#else
+    uint32_t mask = 0;
+    for (int i = 0; i < 4; ++i) {
+        const float x0 = (node.minX[i] - origin.x) * invDirection.x, x1 = (node.maxX[i] - origin.x) * invDirection.x;
+        const float y0 = (node.minY[i] - origin.y) * invDirection.y, y1 = (node.maxY[i] - origin.y) * invDirection.y;
+        const float z0 = (node.minZ[i] - origin.z) * invDirection.z, z1 = (node.maxZ[i] - origin.z) * invDirection.z;
+        const float tNear = std::max(std::max(std::min(x0, x1), std::min(y0, y1)), std::max(std::min(z0, z1), 0.0f));
+        const float tFar = std::min(std::min(std::max(x0, x1), std::max(y0, y1)), std::min(std::max(z0, z1), maxDistance));
+        entry[i] = tNear;
+        if (tNear <= tFar) mask |= 1u << i;
+    }
+    return mask;
+#endif
+}
+
+// ========== Build ==========
+
+void SceneBVH::rebuild(const Scene& scene) {
+    const auto& objects = scene.getObjects();
+    const uint32_t count = static_cast<uint32_t>(objects.size());
+
+    m_objects.resize(count);
+    m_revisions.resize(count);
+    m_bounds.resize(count);
+    m_locations.assign(count, Location{0, 0});
+    m_items.resize(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        m_objects[i] = objects[i].get();
+        m_revisions[i] = objects[i]->getRevision();
+        m_bounds[i] = objects[i]->getWorldBounds();
+        m_items[i] = i;
+    }
+
+    m_nodes.clear();
+    m_area = 0.0f;
+    if (count > 0) {
+        m_nodes.reserve(count / 2 + 1);
+        buildNode(0, count, NO_PARENT, 0);
+    }
+    m_builtArea = m_area;
+}
+
+uint32_t SceneBVH::buildNode(uint32_t first, uint32_t count, uint32_t parent, uint32_t parentSlot) {
+    const uint32_t nodeIndex = static_cast<uint32_t>(m_nodes.size());
+    m_nodes.emplace_back();
+    {
+        Node& node = m_nodes.back();
+        std::fill(std::begin(node.minX), std::end(node.minX), 0.0f);
+        std::fill(std::begin(node.minY), std::end(node.minY), 0.0f);
+        std::fill(std::begin(node.minZ), std::end(node.minZ), 0.0f);
+        std::fill(std::begin(node.maxX), std::end(node.maxX), 0.0f);
+        std::fill(std::begin(node.maxY), std::end(node.maxY), 0.0f);
+        std::fill(std::begin(node.maxZ), std::end(node.maxZ), 0.0f);
+        std::fill(std::begin(node.child), std::end(node.child), -1);
+        node.childCount = 0;
+        node.parent = parent;
+        node.parentSlot = parentSlot;
+        node.firstItem = first;
+        node.itemCount = count;
+    }
+
+    // Up to four children: objects directly, or ranges split twice
+    uint32_t partFirst[4];
+    uint32_t partCount[4];
+    uint32_t parts = 0;
+    if (count <= 4) {
+        for (uint32_t i = 0; i < count; ++i) {
+            partFirst[parts] = first + i;
+            partCount[parts++] = 1;
+        }
+    } else {
+        const uint32_t half = splitRange(first, count);
+        const uint32_t lowQuarter = splitRange(first, half);
+        const uint32_t highQuarter = splitRange(first + half, count - half);
+        partFirst[0] = first;                      partCount[0] = lowQuarter;
+        partFirst[1] = first + lowQuarter;         partCount[1] = half - lowQuarter;
+        partFirst[2] = first + half;               partCount[2] = highQuarter;
+        partFirst[3] = first + half + highQuarter; partCount[3] = count - half - highQuarter;
+        parts = 4;
+    }
+
+    m_nodes[nodeIndex].childCount = parts;
+    for (uint32_t slot = 0; slot < parts; ++slot) {
+        if (partCount[slot] == 1) {
+            const uint32_t object = m_items[partFirst[slot]];
+            m_nodes[nodeIndex].child[slot] = ~static_cast<int32_t>(object);
+            m_locations[object] = Location{nodeIndex, slot};
+        } else {
+            // m_nodes may reallocate during recursion
+            const uint32_t child = buildNode(partFirst[slot], partCount[slot], nodeIndex, slot);
+            m_nodes[nodeIndex].child[slot] = static_cast<int32_t>(child);
+        }
+        setSlot(nodeIndex, slot, rangeBounds(partFirst[slot], partCount[slot]));
+    }
+    return nodeIndex;
+}
+
+uint32_t SceneBVH::splitRange(uint32_t first, uint32_t count) {
+    // Median split along the longest axis of the centroids
+    BoundingBox centroids;
+    for (uint32_t i = first; i < first + count; ++i) {
+        centroids.expand(m_bounds[m_items[i]].getCenter());
+    }
+    const glm::vec3 extent = centroids.getSize();
+    int axis = 0;
+    if (extent.y > extent.x) axis = 1;
+    if (extent.z > extent[axis]) axis = 2;
+
+    const uint32_t half = count / 2;
+    std::nth_element(m_items.begin() + first, m_items.begin() + first + half, m_items.begin() + first + count,
+                     [this, axis](uint32_t a, uint32_t b) {
+                         return m_bounds[a].getCenter()[axis] < m_bounds[b].getCenter()[axis];
+                     });
+    return half;
+}
+
+BoundingBox SceneBVH::rangeBounds(uint32_t first, uint32_t count) const {
+    BoundingBox bounds;
+    for (uint32_t i = first; i < first + count; ++i) {
+        bounds.expand(m_bounds[m_items[i]]);
+    }
+    return bounds;
+}
+
+// ========== Refit ==========
+
+void SceneBVH::setSlot(uint32_t nodeIndex, uint32_t slot, const BoundingBox& box) {
+    Node& node = m_nodes[nodeIndex];
+    const BoundingBox old({node.minX[slot], node.minY[slot], node.minZ[slot]},
+                          {node.maxX[slot], node.maxY[slot], node.maxZ[slot]});
+    m_area += surfaceArea(box) - surfaceArea(old);
+
+    node.minX[slot] = box.min.x;
+    node.minY[slot] = box.min.y;
+    node.minZ[slot] = box.min.z;
+    node.maxX[slot] = box.max.x;
+    node.maxY[slot] = box.max.y;
+    node.maxZ[slot] = box.max.z;
+}
+
+BoundingBox SceneBVH::nodeBounds(const Node& node) const {
+    BoundingBox bounds;
+    for (uint32_t i = 0; i < node.childCount; ++i) {
+        bounds.expand(BoundingBox({node.minX[i], node.minY[i], node.minZ[i]},
+                                  {node.maxX[i], node.maxY[i], node.maxZ[i]}));
+    }
+    return bounds;
+}
+
+void SceneBVH::refit(uint32_t objectIndex, const BoundingBox& box) {
+    m_bounds[objectIndex] = box;
+
+    Location location = m_locations[objectIndex];
+    setSlot(location.node, location.slot, box);
+
+    // Propagate towards the root until a parent box stops changing
+    uint32_t nodeIndex = location.node;
+    while (m_nodes[nodeIndex].parent != NO_PARENT) {
+        const Node& node = m_nodes[nodeIndex];
+        const uint32_t parent = node.parent;
+        const uint32_t slot = node.parentSlot;
+        const BoundingBox bounds = nodeBounds(node);
+
+        const Node& parentNode = m_nodes[parent];
+        const BoundingBox current({parentNode.minX[slot], parentNode.minY[slot], parentNode.minZ[slot]},
+                                  {parentNode.maxX[slot], parentNode.maxY[slot], parentNode.maxZ[slot]});
+        if (sameBounds(bounds, current)) {
+            break;
+        }
+        setSlot(parent, slot, bounds);
+        nodeIndex = parent;
+    }
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "BoundingBox.h"
+#include "Frustum.h"
+#include "Ray.h"
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+class Scene;
+class SceneObject;
+
+// Four-wide bounding volume hierarchy over object world bounds.
+// Every node stores the boxes of its (up to) four children in SoA layout, so a
+// single SSE test classifies all four children against one frustum plane.
+// Subtrees entirely inside the frustum are accepted without further tests and
+// subtrees outside any plane are rejected as a whole.
+//
+// update() rebuilds the tree when objects are added or removed; otherwise only
+// the paths of objects whose bounds changed are refitted. A full rebuild is
+// done once refitting has inflated the tree too much.
+class SceneBVH {
+public:
+    SceneBVH() = default;
+
+    // Bring the tree in sync with the scene (cheap when nothing changed)
+    void update(const Scene& scene);
+
+    // Indices into Scene::getObjects() of objects whose bounds intersect the
+    // frustum (same test as Frustum::isBoxVisible), in tree order
+    void cull(const Frustum& frustum, std::vector<uint32_t>& visible) const;
+
+    // Closest hit along the ray. Objects whose bounds the ray enters before
+    // hit.distance are passed to testObject roughly front to back; it does the
+    // exact test and, if that hits closer, updates hit and returns true.
+    bool raycast(const Ray& ray, const std::function<bool(uint32_t, RayHit&)>& testObject,
+                 RayHit& hit) const;
+
+    size_t getNodeCount() const { return m_nodes.size(); }
+
+private:
+    static constexpr uint32_t NO_PARENT = 0xFFFFFFFFu;
+
+    struct alignas(16) Node {
+        float minX[4], minY[4], minZ[4];
+        float maxX[4], maxY[4], maxZ[4];
+        int32_t child[4];     // >= 0: inner node, < 0: object ~child
+        uint32_t childCount;
+        uint32_t parent;      // NO_PARENT for the root
+        uint32_t parentSlot;
+        uint32_t firstItem;   // Objects below this node: m_items[firstItem, firstItem + itemCount)
+        uint32_t itemCount;
+    };
+
+    // Where an object sits in the tree
+    struct Location {
+        uint32_t node;
+        uint32_t slot;
+    };
+
+    void rebuild(const Scene& scene);
+    uint32_t buildNode(uint32_t first, uint32_t count, uint32_t parent, uint32_t parentSlot);
+    uint32_t splitRange(uint32_t first, uint32_t count);
+    void setSlot(uint32_t nodeIndex, uint32_t slot, const BoundingBox& box);
+    BoundingBox rangeBounds(uint32_t first, uint32_t count) const;
+    BoundingBox nodeBounds(const Node& node) const;
+    void refit(uint32_t objectIndex, const BoundingBox& box);
+
+    // Bit i set: child i is outside / entirely inside the plane
+    static void classify(const Node& node, const glm::vec4& plane, uint32_t& outside, uint32_t& inside);
+
+    // Bit i set: the ray enters child i's box at entry[i] <= maxDistance
+    static uint32_t intersectChildren(const Node& node, const glm::vec3& origin, const glm::vec3& invDirection,
+                                      float maxDistance, float entry[4]);
+
+    std::vector<Node> m_nodes;
+    std::vector<uint32_t> m_items;        // Object indices, contiguous per subtree
+    std::vector<Location> m_locations;    // Per object
+
+    // Scene state the tree was built from
+    std::vector<const SceneObject*> m_objects;
+    std::vector<uint64_t> m_revisions;
+    std::vector<BoundingBox> m_bounds;
+    uint64_t m_syncedRevision{0};
+
+    // Summed surface area of all child boxes, at build time and now
+    float m_builtArea{0.0f};
+    float m_area{0.0f};
+};
@@ -2,75 +2,124 @@
 #include "geometry/Subdivision.h"
 #include <iostream>
 
+namespace {
+    uint64_t s_latestRevision = 0;
+    uint64_t s_latestMeshDataVersion = 0;
+}
+
 SceneObject::SceneObject(const std::string& name)
     : m_name(name)
+    , m_geometry(std::make_shared<SharedGeometry>())
 {
     updateModelMatrix();
+    touch();
+}
+
+uint64_t SceneObject::getLatestRevision() {
+    return s_latestRevision;
+}
+
+void SceneObject::touch() {
+    m_revision = ++s_latestRevision;
 }
 
 void SceneObject::setMesh(std::unique_ptr<Mesh> mesh) {
-    m_mesh = std::move(mesh);
-    if (m_mesh) {
-        m_localBounds = BoundingBox(m_mesh->getMinBounds(), m_mesh->getMaxBounds());
-        updateWorldBounds();
+    m_geometry->mesh = std::move(mesh);
+    if (m_geometry->mesh) {
+        m_geometry->bounds = BoundingBox(m_geometry->mesh->getMinBounds(), m_geometry->mesh->getMaxBounds());
     }
+    geometryChanged();
 }
 
 void SceneObject::setMeshData(const MeshData& data) {
-    m_meshData = data;
+    // Fresh geometry: other instances keep the old one
+    m_geometry = std::make_shared<SharedGeometry>();
+    m_geometry->meshData = data;
 
     // Also upload to GPU
-    m_mesh = std::make_unique<Mesh>();
-    m_mesh->upload(m_meshData);
+    m_geometry->mesh = std::make_unique<Mesh>();
+    m_geometry->mesh->upload(m_geometry->meshData);
 
-    m_localBounds = BoundingBox(m_mesh->getMinBounds(), m_mesh->getMaxBounds());
-    updateWorldBounds();
+    m_geometry->bounds = BoundingBox(m_geometry->mesh->getMinBounds(), m_geometry->mesh->getMaxBounds());
+    meshDataChanged();
+
+    // Textures are attached by the owner through the TextureManager
+}
 
-    // Load texture if specified
-    if (!m_meshData.texturePath.empty()) {
-        m_texture = std::make_unique<Texture>();
-        if (!m_texture->load(m_meshData.texturePath)) {
-            m_texture.reset();
-        }
+void SceneObject::setGeometry(std::shared_ptr<SharedGeometry> geometry) {
+    if (!geometry) {
+        return;
     }
+    m_geometry = std::move(geometry);
+    m_currentLOD = 0;
+    syncGeometry();
 }
 
 void SceneObject::subdivide(bool smooth, float creaseAngle) {
-    if (m_meshData.empty()) {
+    MeshData& meshData = m_geometry->meshData;
+    if (meshData.empty()) {
         return;
     }
 
     // Apply subdivision
     if (smooth) {
-        m_meshData = Subdivision::loopSubdivide(m_meshData, creaseAngle);
+        meshData = Subdivision::loopSubdivide(meshData, creaseAngle);
     } else {
-        m_meshData = Subdivision::midpointSubdivide(m_meshData);
+        meshData = Subdivision::midpointSubdivide(meshData);
     }
 
     // Re-upload to GPU
-    m_mesh = std::make_unique<Mesh>();
-    m_mesh->upload(m_meshData);
+    m_geometry->mesh = std::make_unique<Mesh>();
+    m_geometry->mesh->upload(meshData);
 
-    m_localBounds = BoundingBox(m_mesh->getMinBounds(), m_mesh->getMaxBounds());
-    updateWorldBounds();
+    m_geometry->bounds = BoundingBox(m_geometry->mesh->getMinBounds(), m_geometry->mesh->getMaxBounds());
+    meshDataChanged();
 }
 
-void SceneObject::applySubdividedMesh(MeshData&& data) {
-    m_meshData = std::move(data);
+void SceneObject::applySubdividedMesh(MeshData&& data, std::shared_ptr<StagedMesh> staged) {
+    m_geometry->meshData = std::move(data);
 
     // Use async upload for double-buffering (GPU upload on main thread)
-    if (!m_mesh) {
-        m_mesh = std::make_unique<Mesh>();
+    if (!m_geometry->mesh) {
+        m_geometry->mesh = std::make_unique<Mesh>();
+    }
+    if (staged) {
+        m_geometry->mesh->uploadStaged(std::move(staged), m_geometry->meshData);
+    } else {
+        m_geometry->mesh->uploadAsync(m_geometry->meshData);
     }
-    m_mesh->uploadAsync(m_meshData);
 
     // Update bounds immediately from mesh data
-    m_localBounds = BoundingBox(m_meshData.minBounds, m_meshData.maxBounds);
-    updateWorldBounds();
+    m_geometry->bounds = BoundingBox(m_geometry->meshData.minBounds, m_geometry->meshData.maxBounds);
 
     // Clear existing LOD since mesh has changed - needs regeneration
-    m_lodMesh.clear();
-    m_needsLODRegeneration = true;
+    m_geometry->lodMesh.clear();
+    m_geometry->needsLODRegeneration = true;
+    meshDataChanged();
+}
+
+void SceneObject::meshDataChanged() {
+    // The old BVH and edges no longer match; picking falls back to brute force
+    // and the edge overlay skips the object until the new ones are built
+    m_geometry->triangleBVH.reset();
+    m_geometry->needsTriangleBVH = !m_geometry->meshData.empty();
+    m_geometry->featureEdges.reset();
+    m_geometry->needsFeatureEdges = !m_geometry->meshData.empty();
+    m_geometry->meshDataVersion = ++s_latestMeshDataVersion;
+    geometryChanged();
+}
+
+void SceneObject::geometryChanged() {
+    ++m_geometry->version;
+    syncGeometry();
+}
+
+void SceneObject::syncGeometry() {
+    m_geometryVersion = m_geometry->version;
+    if (m_geometry->bounds.isValid()) {
+        m_localBounds = m_geometry->bounds;
+    }
+    updateWorldBounds();
 }
 
 void SceneObject::setPosition(const glm::vec3& position) {
@@ -107,35 +156,44 @@ void SceneObject::updateWorldBounds() {
     if (m_localBounds.isValid()) {
         m_worldBounds = m_localBounds.transformed(m_modelMatrix);
     }
+    touch();
 }
 
 void SceneObject::update() {
-    if (m_mesh && m_mesh->swapBuffers()) {
-        // Buffer swap occurred, update bounds
-        m_localBounds = BoundingBox(m_mesh->getMinBounds(), m_mesh->getMaxBounds());
-        updateWorldBounds();
+    Mesh* mesh = m_geometry->mesh.get();
+    if (mesh && mesh->swapBuffers()) {
+        // Buffer swap occurred, update bounds (the first instance to see it
+        // swaps; the others pick it up through the version below)
+        m_geometry->bounds = BoundingBox(mesh->getMinBounds(), mesh->getMaxBounds());
+        ++m_geometry->version;
+    }
+
+    // Another instance changed the shared geometry
+    if (m_geometryVersion != m_geometry->version) {
+        syncGeometry();
     }
 }
 
 void SceneObject::draw() const {
-    if (m_visible && m_mesh) {
-        m_mesh->draw();
+    if (m_visible && m_geometry->mesh) {
+        m_geometry->mesh->draw();
     }
 }
 
 void SceneObject::drawWireframe() const {
-    if (m_visible && m_mesh) {
-        m_mesh->drawWireframe();
+    if (m_visible && m_geometry->mesh) {
+        m_geometry->mesh->drawWireframe();
     }
 }
 
 void SceneObject::applyLODLevels(std::vector<LODLevel>&& levels) {
-    m_lodMesh.setLevels(std::move(levels));
+    m_geometry->lodMesh.setLevels(std::move(levels));
+    geometryChanged();
 }
 
 Mesh* SceneObject::getMeshForRendering(float screenSize) {
-    if (m_lodMesh.hasLOD()) {
-        return m_lodMesh.selectLOD(screenSize);
+    if (m_geometry->lodMesh.hasLOD()) {
+        return m_geometry->lodMesh.selectLOD(screenSize, m_currentLOD);
     }
-    return m_mesh.get();
+    return m_geometry->mesh.get();
 }
@@ -1,11 +1,14 @@
 #pragma once
 
 #include "BoundingBox.h"
+#include "SharedGeometry.h"
 #include "mesh/Mesh.h"
 #include "mesh/MeshData.h"
 #include "lod/LODMesh.h"
 #include "lod/LODLevel.h"
-#include "core/Texture.h"
+#include "core/TextureManager.h"
+#include "geometry/TriangleBVH.h"
+#include "geometry/FeatureEdges.h"
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <memory>
@@ -18,36 +21,70 @@ public:
 
     void setMesh(std::unique_ptr<Mesh> mesh);
     void setMeshData(const MeshData& data);
+
+    // Instancing: objects sharing a geometry share its mesh data, GPU mesh, LOD
+    // chain and BVH; transform, colour, selection and LOD choice stay per object
+    void setGeometry(std::shared_ptr<SharedGeometry> geometry);
+    const std::shared_ptr<SharedGeometry>& getGeometry() const { return m_geometry; }
+    bool isInstanced() const { return m_geometry.use_count() > 1; }
     void setPosition(const glm::vec3& position);
     void setRotation(const glm::vec3& eulerAngles);
     void setScale(const glm::vec3& scale);
-    void setColor(const glm::vec3& color) { m_color = color; }
+    void setColor(const glm::vec3& color) { m_color = color; touch(); }
 
     // Subdivision
     void subdivide(bool smooth = true, float creaseAngle = 180.0f);
-    bool canSubdivide() const { return !m_meshData.empty(); }
+    bool canSubdivide() const { return !m_geometry->meshData.empty(); }
 
-    // Apply pre-computed subdivision result (for background threading)
-    void applySubdividedMesh(MeshData&& data);
+    // Apply pre-computed subdivision result (for background threading); with
+    // a staged transfer the GPU mesh switches once its copies complete
+    void applySubdividedMesh(MeshData&& data, std::shared_ptr<StagedMesh> staged = nullptr);
 
     // Get current mesh data (for background subdivision)
-    const MeshData& getMeshData() const { return m_meshData; }
+    const MeshData& getMeshData() const { return m_geometry->meshData; }
 
     // LOD support
     void applyLODLevels(std::vector<LODLevel>&& levels);
-    LODMesh& getLODMesh() { return m_lodMesh; }
-    const LODMesh& getLODMesh() const { return m_lodMesh; }
-    bool hasLOD() const { return m_lodMesh.hasLOD(); }
+    LODMesh& getLODMesh() { return m_geometry->lodMesh; }
+    const LODMesh& getLODMesh() const { return m_geometry->lodMesh; }
+    bool hasLOD() const { return m_geometry->lodMesh.hasLOD(); }
 
     // Get mesh for rendering based on screen size (uses LOD if available)
     Mesh* getMeshForRendering(float screenSize);
 
     // Get current LOD index (-1 if no LOD)
-    int getCurrentLODIndex() const { return m_lodMesh.hasLOD() ? m_lodMesh.getCurrentLODIndex() : -1; }
+    int getCurrentLODIndex() const { return hasLOD() ? m_currentLOD : -1; }
 
     // Check if LOD needs regeneration (after subdivision)
-    bool needsLODRegeneration() const { return m_needsLODRegeneration; }
-    void clearLODRegenerationFlag() { m_needsLODRegeneration = false; }
+    bool needsLODRegeneration() const { return m_geometry->needsLODRegeneration; }
+    void clearLODRegenerationFlag() { m_geometry->needsLODRegeneration = false; }
+
+    // Triangle BVH for ray casts, built in the background after the mesh data
+    // changes (null until then)
+    const std::shared_ptr<const TriangleBVH>& getTriangleBVH() const { return m_geometry->triangleBVH; }
+    void setTriangleBVH(std::shared_ptr<const TriangleBVH> bvh) { m_geometry->triangleBVH = std::move(bvh); }
+    bool needsTriangleBVH() const { return m_geometry->needsTriangleBVH; }
+    void clearTriangleBVHFlag() { m_geometry->needsTriangleBVH = false; }
+
+    // Boundary and crease edges for the edge overlay, extracted in the
+    // background after the mesh data changes (null until then)
+    const std::shared_ptr<const FeatureEdges>& getFeatureEdges() const { return m_geometry->featureEdges; }
+    void setFeatureEdges(std::shared_ptr<const FeatureEdges> edges) { m_geometry->featureEdges = std::move(edges); }
+    bool needsFeatureEdges() const { return m_geometry->needsFeatureEdges; }
+    void clearFeatureEdgesFlag() { m_geometry->needsFeatureEdges = false; }
+
+    // Edge level for the object's screen size (keeps hysteresis per instance)
+    int selectEdgeLevel(float screenSize) {
+        m_currentEdgeLevel = FeatureEdges::selectLevel(screenSize, m_currentEdgeLevel);
+        return m_currentEdgeLevel;
+    }
+
+    // Changes whenever the mesh data is replaced (unique across objects)
+    uint64_t getMeshDataVersion() const { return m_geometry->meshDataVersion; }
+
+    // Geometry cache key of the current mesh data (0 = not cached)
+    uint64_t getCacheKey() const { return m_geometry->cacheKey; }
+    void setCacheKey(uint64_t key) { m_geometry->cacheKey = key; }
 
     const std::string& getName() const { return m_name; }
     const glm::vec3& getPosition() const { return m_position; }
@@ -58,33 +95,50 @@ public:
     const glm::mat4& getModelMatrix() const { return m_modelMatrix; }
     const glm::mat3& getNormalMatrix() const { return m_normalMatrix; }
     const BoundingBox& getWorldBounds() const { return m_worldBounds; }
-    Mesh* getMesh() const { return m_mesh.get(); }
+    Mesh* getMesh() const { return m_geometry->mesh.get(); }
 
     bool isVisible() const { return m_visible; }
-    void setVisible(bool visible) { m_visible = visible; }
+    void setVisible(bool visible) { m_visible = visible; touch(); }
 
     bool isSelected() const { return m_selected; }
-    void setSelected(bool selected) { m_selected = selected; }
+    void setSelected(bool selected) { m_selected = selected; touch(); }
+
+    bool isHovered() const { return m_hovered; }
+    void setHovered(bool hovered) { m_hovered = hovered; touch(); }
 
-    // Texture support
-    Texture* getTexture() const { return m_texture.get(); }
-    bool hasTexture() const { return m_texture && m_texture->isValid(); }
+    // Texture support (shared entry from the TextureManager, loaded on first use)
+    const std::shared_ptr<TextureEntry>& getTexture() const { return m_texture; }
+    void setTexture(std::shared_ptr<TextureEntry> texture) { m_texture = std::move(texture); touch(); }
+    bool hasTexture() const { return m_texture != nullptr; }
 
     void draw() const;
     void drawWireframe() const;
 
-    // Call each frame to check for completed async GPU uploads
+    // Call each frame to check for completed async GPU uploads and changes
+    // made to the shared geometry through other instances
     void update();
 
+    // Bumped on every change the renderer mirrors on the GPU (transform, mesh,
+    // LODs, colour, visibility, selection, hover, texture)
+    uint64_t getRevision() const { return m_revision; }
+
+    // Highest revision of any object (unchanged = no object changed)
+    static uint64_t getLatestRevision();
+
 private:
+    void touch();
     void updateModelMatrix();
     void updateWorldBounds();
+    void meshDataChanged();
+    void geometryChanged();
+    void syncGeometry();
 
     std::string m_name;
-    std::unique_ptr<Mesh> m_mesh;
-    std::unique_ptr<Texture> m_texture;
-    MeshData m_meshData;
-    LODMesh m_lodMesh;
+    std::shared_ptr<SharedGeometry> m_geometry;  // Never null
+    uint64_t m_geometryVersion{0};                // Last version synced from m_geometry
+    int m_currentLOD{0};                          // Per instance (LOD hysteresis state)
+    int m_currentEdgeLevel{0};                    // Per instance (edge level hysteresis state)
+    std::shared_ptr<TextureEntry> m_texture;
 
     glm::vec3 m_position{0.0f};
     glm::vec3 m_rotation{0.0f};
@@ -97,5 +151,6 @@ private:
     BoundingBox m_worldBounds;
     bool m_visible{true};
     bool m_selected{false};
-    bool m_needsLODRegeneration{false};
+    bool m_hovered{false};
+    uint64_t m_revision{0};
 };
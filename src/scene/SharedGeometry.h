@@ -0,0 +1,34 @@
+#pragma once
+
+#include "BoundingBox.h"
+#include "mesh/Mesh.h"
+#include "mesh/MeshData.h"
+#include "lod/LODMesh.h"
+#include "geometry/TriangleBVH.h"
+#include "geometry/FeatureEdges.h"
+#include <cstdint>
+#include <memory>
+
+// Geometry referenced by every instance of one mesh: CPU mesh data, GPU mesh,
+// LOD chain, picking BVH and feature edges. Objects loaded from identical meshes point at the
+// same SharedGeometry, so it is uploaded, simplified and indexed only once.
+// Changing it (subdivision, new LOD levels) changes every instance.
+struct SharedGeometry {
+    MeshData meshData;
+    std::unique_ptr<Mesh> mesh;
+    LODMesh lodMesh;
+    std::shared_ptr<const TriangleBVH> triangleBVH;
+    std::shared_ptr<const FeatureEdges> featureEdges;
+    BoundingBox bounds;        // Object space
+    uint64_t cacheKey{0};      // Geometry cache key of meshData (0 = not cached)
+
+    // Bumped on every change; instances compare it to pick up new bounds
+    uint64_t version{0};
+
+    // Unique across all geometries; changes only when meshData is replaced
+    uint64_t meshDataVersion{0};
+
+    bool needsLODRegeneration{false};
+    bool needsTriangleBVH{false};
+    bool needsFeatureEdges{false};
+};
@@ -3,24 +3,29 @@
 #include <sstream>
 #include <iomanip>
 
-void HelpOverlay::render(int screenWidth, int screenHeight, const ToggleStates& toggles) {
+void HelpOverlay::render(const ToggleStates& toggles) {
     if (!m_visible || !m_textRenderer) return;
 
     // Help content with toggle indicators
     struct HelpLine {
         std::string text;
-        int toggleType;  // 0=none, 1=wireframe, 2=backface, 3=frustum, 4=lod, 5=lodDebug, 6=textures, 7=solution
+        int toggleType;  // 0=none, 1=wireframe, 2=backface, 3=frustum, 4=lod, 5=lodDebug, 6=textures, 7=solution, 8=animation, 9=batching, 10=occlusion, 11=dynamic resolution, 12=interactive LOD, 13=cluster culling
     };
 
     std::vector<HelpLine> helpLines = {
         {"=== KEYBOARD ===", 0},
         {"H      Help toggle", 0},
-        {"W      Wireframe", 1},
+        {"W      Wireframe: " + toggles.wireframeMode, 1},
         {"T      Textures", 6},
         {"C      Back-face culling", 2},
         {"G      Frustum culling", 3},
+        {"O      Occlusion culling", 10},
+        {"M      Cluster culling", 13},
+        {"R      Dynamic resolution", 11},
         {"L      LOD system", 4},
         {"K      LOD debug colors", 5},
+        {"I      Interactive LOD", 12},
+        {"B      Draw path: " + toggles.drawPath, 9},
         {"F      Focus", 0},
         {"S      Subdivide (smooth)", 0},
         {"D      Subdivide (midpoint)", 0},
@@ -74,7 +79,45 @@ void HelpOverlay::render(int screenWidth, int screenHeight, const ToggleStates&
     const glm::vec4 normalColor(0.7f, 0.7f, 0.75f, 1.0f);   // Gray for normal text
     const glm::vec4 activeColor(0.4f, 1.0f, 0.5f, 1.0f);    // Bright green for ON
 
-    m_textRenderer->begin(screenWidth, screenHeight);
+    // Pick each line's color; the lines and their colors are the cache key
+    std::vector<glm::vec4> lineColors;
+    std::string key;
+    for (const auto& line : helpLines) {
+        // Determine if this toggle is active
+        bool isActive = false;
+        if (line.toggleType == 1) isActive = toggles.wireframe;
+        else if (line.toggleType == 2) isActive = toggles.backfaceCulling;
+        else if (line.toggleType == 3) isActive = toggles.frustumCulling;
+        else if (line.toggleType == 4) isActive = toggles.lodEnabled;
+        else if (line.toggleType == 5) isActive = toggles.lodDebugColors;
+        else if (line.toggleType == 6) isActive = toggles.texturesEnabled;
+        else if (line.toggleType == 7) isActive = toggles.solutionVisualization;
+        else if (line.toggleType == 8) isActive = toggles.animationPlaying;
+        else if (line.toggleType == 9) isActive = toggles.batchingEnabled;
+        else if (line.toggleType == 10) isActive = toggles.occlusionCulling;
+        else if (line.toggleType == 11) isActive = toggles.dynamicResolution;
+        else if (line.toggleType == 12) isActive = toggles.interactiveQuality;
+        else if (line.toggleType == 13) isActive = toggles.clusterCulling;
+
+        // Set color based on state
+        if (line.text.find("===") != std::string::npos) {
+            lineColors.push_back(headerColor);
+        } else if (isActive) {
+            lineColors.push_back(activeColor);
+        } else {
+            lineColors.push_back(normalColor);
+        }
+        key += line.text;
+        key += isActive ? "\1\n" : "\n";
+    }
+
+    // Reuse the vertices from the last frame unless the text changed
+    if (m_helpBlock < 0) {
+        m_helpBlock = m_textRenderer->createBlock();
+    }
+    if (m_textRenderer->drawBlock(m_helpBlock, key)) {
+        return;
+    }
 
     // Draw background
     m_textRenderer->renderQuad(overlayX, overlayY, overlayWidth, overlayHeight,
@@ -89,37 +132,17 @@ void HelpOverlay::render(int screenWidth, int screenHeight, const ToggleStates&
     m_textRenderer->renderQuad(overlayX + overlayWidth - borderWidth, overlayY, borderWidth, overlayHeight, borderColor);
 
     float textY = overlayY + padding;
-    for (const auto& line : helpLines) {
-        if (!line.text.empty()) {
-            // Determine if this toggle is active
-            bool isActive = false;
-            if (line.toggleType == 1) isActive = toggles.wireframe;
-            else if (line.toggleType == 2) isActive = toggles.backfaceCulling;
-            else if (line.toggleType == 3) isActive = toggles.frustumCulling;
-            else if (line.toggleType == 4) isActive = toggles.lodEnabled;
-            else if (line.toggleType == 5) isActive = toggles.lodDebugColors;
-            else if (line.toggleType == 6) isActive = toggles.texturesEnabled;
-            else if (line.toggleType == 7) isActive = toggles.solutionVisualization;
-            else if (line.toggleType == 8) isActive = toggles.animationPlaying;
-
-            // Set color based on state
-            glm::vec4 color;
-            if (line.text.find("===") != std::string::npos) {
-                color = headerColor;
-            } else if (isActive) {
-                color = activeColor;
-            } else {
-                color = normalColor;
-            }
-            m_textRenderer->renderText(line.text, overlayX + padding, textY, scale, color);
+    for (size_t i = 0; i < helpLines.size(); ++i) {
+        if (!helpLines[i].text.empty()) {
+            m_textRenderer->renderText(helpLines[i].text, overlayX + padding, textY, scale, lineColors[i]);
         }
         textY += lineHeight;
     }
 
-    m_textRenderer->end();
+    m_textRenderer->endBlock();
 }
 
-void HelpOverlay::renderStats(int screenWidth, int screenHeight, const ToggleStates& toggles) {
+void HelpOverlay::renderStats(int screenWidth, const ToggleStates& toggles) {
     if (!m_textRenderer) return;
 
     // Format triangle count with K suffix for thousands
@@ -142,6 +165,19 @@ void HelpOverlay::renderStats(int screenWidth, int screenHeight, const ToggleSta
     std::ostringstream savingsStream;
     savingsStream << "LOD:  " << std::fixed << std::setprecision(0) << toggles.lodSavingsPercent << "%";
     std::string triSavings = savingsStream.str();
+    std::string drawCalls = "Draws: " + std::to_string(toggles.drawCalls);
+    std::string occlusion = "Occl: " + (toggles.occlusionCulling
+        ? std::to_string(toggles.occludedObjects) + " (" + std::to_string(toggles.occluders) + ")"
+        : std::string("off"));
+    std::string clusters = "Clus: " + (toggles.clusterStats
+        ? formatTriangles(toggles.drawnClusters) + "/" + formatTriangles(toggles.testedClusters)
+        : std::string("off"));
+    std::ostringstream resolutionStream;
+    resolutionStream << "Res:  " << std::fixed << std::setprecision(0) << toggles.resolutionScale * 100.0f << "%";
+    if (toggles.dynamicResolution) {
+        resolutionStream << " " << std::setprecision(1) << toggles.gpuTimeMs << "ms";
+    }
+    std::string resolution = resolutionStream.str();
 
     const float scale = 1.5f;
     const float charW = TextRenderer::getCharWidth() * scale;
@@ -150,9 +186,11 @@ void HelpOverlay::renderStats(int screenWidth, int screenHeight, const ToggleSta
     const float padding = 8.0f;
 
     // Calculate overlay dimensions
-    size_t maxLen = std::max({triRendered.length(), triOriginal.length(), triSavings.length()});
+    size_t maxLen = std::max({triRendered.length(), triOriginal.length(), triSavings.length(),
+                              drawCalls.length(), occlusion.length(), clusters.length(),
+                              resolution.length()});
     float overlayWidth = maxLen * charW + padding * 2;
-    float overlayHeight = 3 * lineHeight + padding * 2;
+    float overlayHeight = 7 * lineHeight + padding * 2;
 
     // Position at top-right corner with margin
     float overlayX = screenWidth - overlayWidth - 10.0f;
@@ -163,8 +201,6 @@ void HelpOverlay::renderStats(int screenWidth, int screenHeight, const ToggleSta
     const glm::vec4 normalColor(0.7f, 0.7f, 0.75f, 1.0f);   // Gray for original
     const glm::vec4 savingsColor(0.4f, 1.0f, 0.8f, 1.0f);   // Cyan for savings
 
-    m_textRenderer->begin(screenWidth, screenHeight);
-
     // Draw background
     m_textRenderer->renderQuad(overlayX, overlayY, overlayWidth, overlayHeight,
                                glm::vec4(0.1f, 0.1f, 0.15f, 0.85f));
@@ -189,6 +225,20 @@ void HelpOverlay::renderStats(int screenWidth, int screenHeight, const ToggleSta
 
     // LOD savings
     m_textRenderer->renderText(triSavings, overlayX + padding, textY, scale, savingsColor);
+    textY += lineHeight;
+
+    // Draw calls
+    m_textRenderer->renderText(drawCalls, overlayX + padding, textY, scale, normalColor);
+    textY += lineHeight;
+
+    // Occlusion culling: hidden objects (occluders)
+    m_textRenderer->renderText(occlusion, overlayX + padding, textY, scale, normalColor);
+    textY += lineHeight;
+
+    // Cluster culling: drawn / tested clusters of the drawn ranges
+    m_textRenderer->renderText(clusters, overlayX + padding, textY, scale, normalColor);
+    textY += lineHeight;
 
-    m_textRenderer->end();
+    // Render scale and scene GPU time
+    m_textRenderer->renderText(resolution, overlayX + padding, textY, scale, normalColor);
 }
@@ -6,12 +6,19 @@
 
 // Toggle states for help overlay display
 struct ToggleStates {
-    bool wireframe{false};
+    bool wireframe{false};       // Edge overlay or full wireframe
+    std::string wireframeMode{"Off"};
     bool backfaceCulling{true};
     bool frustumCulling{true};
+    bool occlusionCulling{true};
+    bool clusterCulling{true};
+    bool dynamicResolution{true};
     bool lodEnabled{true};
     bool lodDebugColors{false};
+    bool interactiveQuality{true};
     bool texturesEnabled{true};
+    bool batchingEnabled{true};  // Any multi-draw-indirect path
+    std::string drawPath{"GPU"};
     bool solutionVisualization{false};
     bool hasSolution{false};
     bool isSolvingPoisson{false};
@@ -23,6 +30,14 @@ struct ToggleStates {
     uint32_t renderedTriangles{0};
     uint32_t originalTriangles{0};
     float lodSavingsPercent{0.0f};
+    uint32_t drawCalls{0};
+    uint32_t occludedObjects{0};
+    uint32_t occluders{0};
+    bool clusterStats{false};   // Cluster counts apply (GPU-driven path, culling on)
+    uint32_t drawnClusters{0};
+    uint32_t testedClusters{0};
+    float resolutionScale{1.0f};
+    float gpuTimeMs{0.0f};      // Scene pass, measured while dynamic resolution is on
 };
 
 class HelpOverlay {
@@ -31,8 +46,10 @@ public:
     ~HelpOverlay() = default;
 
     void setTextRenderer(TextRenderer* renderer) { m_textRenderer = renderer; }
-    void render(int screenWidth, int screenHeight, const ToggleStates& toggles);
-    void renderStats(int screenWidth, int screenHeight, const ToggleStates& toggles);
+
+    // Queue the overlays into the text renderer's current batch
+    void render(const ToggleStates& toggles);
+    void renderStats(int screenWidth, const ToggleStates& toggles);
 
     void setVisible(bool visible) { m_visible = visible; }
     bool isVisible() const { return m_visible; }
@@ -40,5 +57,6 @@ public:
 
 private:
     TextRenderer* m_textRenderer{nullptr};
+    int m_helpBlock{-1};   // Cached help text, rebuilt when lines or toggles change
     bool m_visible{false};
 };
@@ -97,8 +97,6 @@ void ProgressOverlay::render(int screenWidth, int screenHeight,
     float overlayX = (screenWidth - overlayWidth) / 2.0f;
     float overlayY = screenHeight - overlayHeight - 20.0f;
 
-    m_textRenderer->begin(screenWidth, screenHeight);
-
     // Draw background
     m_textRenderer->renderQuad(overlayX, overlayY, overlayWidth, overlayHeight,
                                glm::vec4(0.1f, 0.1f, 0.15f, 0.95f));
@@ -144,6 +142,4 @@ void ProgressOverlay::render(int screenWidth, int screenHeight,
         m_textRenderer->renderText(queueStr.str(), overlayX + padding, queueY, scale,
                                    glm::vec4(0.6f, 0.6f, 0.65f, 1.0f));
     }
-
-    m_textRenderer->end();
 }
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+// Fast non-cryptographic 64-bit hashing for content addressing
+namespace Hash {
+
+constexpr uint64_t DEFAULT_SEED = 0x9E3779B97F4A7C15ull;
+
+inline uint64_t mix(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDull;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ull;
+    h ^= h >> 33;
+    return h;
+}
+
+inline uint64_t combine(uint64_t h, uint64_t value) {
+    return mix(h ^ (value + 0x9E3779B97F4A7C15ull + (h << 6) + (h >> 2)));
+}
+
+// Hash a byte range, consuming 8 bytes per step
+inline uint64_t bytes(const void* data, size_t size, uint64_t seed = DEFAULT_SEED) {
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    uint64_t h = seed ^ (size * 0xC6A4A7935BD1E995ull);
+
+    size_t words = size / 8;
+    for (size_t i = 0; i < words; ++i) {
+        uint64_t w;
+        std::memcpy(&w, p + i * 8, 8);
+        w *= 0xC6A4A7935BD1E995ull;
+        w ^= w >> 47;
+        w *= 0xC6A4A7935BD1E995ull;
+        h = (h ^ w) * 0xC6A4A7935BD1E995ull;
+    }
+
+    uint64_t tail = 0;
+    std::memcpy(&tail, p + words * 8, size % 8);
+    h ^= tail;
+
+    return mix(h);
+}
+
+inline uint64_t string(const std::string& s, uint64_t seed = DEFAULT_SEED) {
+    return bytes(s.data(), s.size(), seed);
+}
+
+} // namespace Hash
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Read-only memory-mapped file
+// Binary loaders interpret fixed-layout records directly from the mapping
+// instead of copying the file through a stream first.
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    // Non-copyable
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Movable
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    // Map the whole file; returns false if it cannot be opened or mapped
+    bool open(const std::string& path);
+    void close();
+
+    bool isOpen() const { return m_data != nullptr; }
+    const uint8_t* data() const { return m_data; }
+    size_t size() const { return m_size; }
+
+private:
+    const uint8_t* m_data{nullptr};
+    size_t m_size{0};
+    bool m_mapped{false};             // true = mmap'ed, false = read into m_fallback
+    std::vector<uint8_t> m_fallback;  // Used on platforms without mmap
+};
@@ -0,0 +1,97 @@
+#include "RangeAllocator.h"
+#include <iterator>
+
+RangeAllocator::RangeAllocator(uint32_t capacity) {
+    grow(capacity);
+}
+
+uint32_t RangeAllocator::allocate(uint32_t size) {
+    if (size == 0) {
+        return INVALID_OFFSET;
+    }
+
+    auto best = m_freeBySize.lower_bound({size, 0});
+    if (best == m_freeBySize.end()) {
+        return INVALID_OFFSET;
+    }
+
+    const uint32_t offset = best->second;
+    take(m_freeRanges.find(offset), size);
+    return offset;
+}
+
+uint32_t RangeAllocator::allocateBelow(uint32_t size, uint32_t limit) {
+    if (size == 0) {
+        return INVALID_OFFSET;
+    }
+
+    for (auto it = m_freeRanges.begin(); it != m_freeRanges.end() && it->first < limit; ++it) {
+        if (it->second >= size && it->first + size <= limit) {
+            const uint32_t offset = it->first;
+            take(it, size);
+            return offset;
+        }
+    }
+    return INVALID_OFFSET;
+}
+
+void RangeAllocator::free(uint32_t offset, uint32_t size) {
+    if (size == 0 || offset == INVALID_OFFSET) {
+        return;
+    }
+
+    m_used -= size;
+
+    // Merge with the following range
+    auto next = m_freeRanges.lower_bound(offset);
+    if (next != m_freeRanges.end() && offset + size == next->first) {
+        size += next->second;
+        next = std::next(next);
+        eraseFree(std::prev(next));
+    }
+
+    // Merge with the preceding range
+    if (next != m_freeRanges.begin()) {
+        auto prev = std::prev(next);
+        if (prev->first + prev->second == offset) {
+            offset = prev->first;
+            size += prev->second;
+            eraseFree(prev);
+        }
+    }
+
+    insertFree(offset, size);
+}
+
+void RangeAllocator::grow(uint32_t newCapacity) {
+    if (newCapacity <= m_capacity) {
+        return;
+    }
+
+    // Added space is a free range at the end (merged with a trailing free range)
+    const uint32_t added = newCapacity - m_capacity;
+    const uint32_t offset = m_capacity;
+    m_capacity = newCapacity;
+    m_used += added;  // free() subtracts it again
+    free(offset, added);
+}
+
+void RangeAllocator::take(std::map<uint32_t, uint32_t>::iterator range, uint32_t size) {
+    const uint32_t offset = range->first;
+    const uint32_t remaining = range->second - size;
+    eraseFree(range);
+    if (remaining > 0) {
+        insertFree(offset + size, remaining);
+    }
+    m_used += size;
+}
+
+void RangeAllocator::insertFree(uint32_t offset, uint32_t size) {
+    m_freeRanges.emplace(offset, size);
+    m_freeBySize.emplace(size, offset);
+}
+
+void RangeAllocator::eraseFree(std::map<uint32_t, uint32_t>::iterator range) {
+    m_freeBySize.erase({range->second, range->first});
+    m_freeRanges.erase(range);
+}
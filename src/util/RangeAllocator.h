@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <set>
+#include <utility>
+
+// Best-fit allocator for ranges inside a linear buffer (offsets in
+// caller-defined units, e.g. vertices or indices). Only bookkeeping: the
+// caller owns the memory. Free ranges are indexed by offset (for merging
+// freed neighbours) and by size (for O(log n) best-fit lookups).
+class RangeAllocator {
+public:
+    static constexpr uint32_t INVALID_OFFSET = std::numeric_limits<uint32_t>::max();
+
+    explicit RangeAllocator(uint32_t capacity = 0);
+
+    // Smallest free range that fits; INVALID_OFFSET if none is large enough
+    uint32_t allocate(uint32_t size);
+
+    // Lowest free range that fits and ends at or before limit (for moving an
+    // allocation towards the start); INVALID_OFFSET if there is none
+    uint32_t allocateBelow(uint32_t size, uint32_t limit);
+
+    void free(uint32_t offset, uint32_t size);
+
+    // Extend the managed range (existing allocations keep their offsets)
+    void grow(uint32_t newCapacity);
+
+    uint32_t getCapacity() const { return m_capacity; }
+    uint32_t getUsed() const { return m_used; }
+
+    // Fragmentation: free space split over many ranges cannot hold one large allocation
+    size_t getFreeRangeCount() const { return m_freeRanges.size(); }
+    uint32_t getLargestFreeRange() const { return m_freeBySize.empty() ? 0 : m_freeBySize.rbegin()->first; }
+
+private:
+    void take(std::map<uint32_t, uint32_t>::iterator range, uint32_t size);
+    void insertFree(uint32_t offset, uint32_t size);
+    void eraseFree(std::map<uint32_t, uint32_t>::iterator range);
+
+    std::map<uint32_t, uint32_t> m_freeRanges;               // offset -> size
+    std::set<std::pair<uint32_t, uint32_t>> m_freeBySize;    // (size, offset)
+    uint32_t m_capacity{0};
+    uint32_t m_used{0};
+};
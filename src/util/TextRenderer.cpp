@@ -1,5 +1,9 @@
 #include "TextRenderer.h"
-#include <vector>
+#include <glm/gtc/packing.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
 
 // Simple 8x8 bitmap font data (printable ASCII 32-126)
 // Each character is 8 bytes, one per row, bits are pixels left-to-right
@@ -196,35 +200,41 @@ static const unsigned char FONT_DATA[] = {
     0x76, 0xDC, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+namespace {
+    constexpr size_t INITIAL_STATIC_VERTICES = 6 * 2048;
+    constexpr size_t INITIAL_FRAME_VERTICES = 6 * 4096;
+}
+
 TextRenderer::TextRenderer() = default;
 
 TextRenderer::~TextRenderer() {
+    release();
     if (m_fontTexture) glDeleteTextures(1, &m_fontTexture);
     if (m_vao) glDeleteVertexArrays(1, &m_vao);
-    if (m_vbo) glDeleteBuffers(1, &m_vbo);
 }
 
 void TextRenderer::init() {
     m_shader = std::make_unique<Shader>("shaders/text.vert", "shaders/text.frag");
     createFontTexture();
 
-    // Create VAO/VBO for dynamic quad rendering
     glCreateVertexArrays(1, &m_vao);
-    glCreateBuffers(1, &m_vbo);
-
-    // Allocate buffer for a single quad (6 vertices * 4 floats)
-    glNamedBufferStorage(m_vbo, 6 * 4 * sizeof(float), nullptr, GL_DYNAMIC_STORAGE_BIT);
 
     // Position attribute (location 0)
-    glVertexArrayVertexBuffer(m_vao, 0, m_vbo, 0, 4 * sizeof(float));
     glEnableVertexArrayAttrib(m_vao, 0);
-    glVertexArrayAttribFormat(m_vao, 0, 2, GL_FLOAT, GL_FALSE, 0);
+    glVertexArrayAttribFormat(m_vao, 0, 2, GL_FLOAT, GL_FALSE, offsetof(Vertex, x));
     glVertexArrayAttribBinding(m_vao, 0, 0);
 
     // TexCoord attribute (location 1)
     glEnableVertexArrayAttrib(m_vao, 1);
-    glVertexArrayAttribFormat(m_vao, 1, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float));
+    glVertexArrayAttribFormat(m_vao, 1, 2, GL_FLOAT, GL_FALSE, offsetof(Vertex, u));
     glVertexArrayAttribBinding(m_vao, 1, 0);
+
+    // Color attribute (location 2)
+    glEnableVertexArrayAttrib(m_vao, 2);
+    glVertexArrayAttribFormat(m_vao, 2, 4, GL_UNSIGNED_BYTE, GL_TRUE, offsetof(Vertex, color));
+    glVertexArrayAttribBinding(m_vao, 2, 0);
+
+    allocate(INITIAL_STATIC_VERTICES, INITIAL_FRAME_VERTICES);
 }
 
 void TextRenderer::createFontTexture() {
@@ -249,6 +259,13 @@ void TextRenderer::createFontTexture() {
         }
     }
 
+    // Solid cell sampled by quads, so glyphs and quads share one shader path
+    for (int y = 0; y < GLYPH_HEIGHT; ++y) {
+        int texY = (SOLID_CELL / FONT_COLS) * GLYPH_HEIGHT + y;
+        int texX = (SOLID_CELL % FONT_COLS) * GLYPH_WIDTH;
+        std::fill_n(texData.begin() + texY * texWidth + texX, GLYPH_WIDTH, 255);
+    }
+
     glCreateTextures(GL_TEXTURE_2D, 1, &m_fontTexture);
     glTextureStorage2D(m_fontTexture, 1, GL_R8, texWidth, texHeight);
     glTextureSubImage2D(m_fontTexture, 0, 0, 0, texWidth, texHeight, GL_RED, GL_UNSIGNED_BYTE, texData.data());
@@ -258,28 +275,72 @@ void TextRenderer::createFontTexture() {
     glTextureParameteri(m_fontTexture, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 }
 
+// ========== Frame Batch ==========
+
 void TextRenderer::begin(int screenWidth, int screenHeight) {
     m_screenWidth = screenWidth;
     m_screenHeight = screenHeight;
 
-    glViewport(0, 0, screenWidth, screenHeight);
-    glDisable(GL_DEPTH_TEST);
-    glDisable(GL_CULL_FACE);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-    m_shader->use();
-    m_shader->setVec2("screenSize", glm::vec2(screenWidth, screenHeight));
-    glBindTextureUnit(0, m_fontTexture);
-    m_shader->setInt("fontTexture", 0);
-    glBindVertexArray(m_vao);
+    // Wait until the GPU has finished the frame that last used this region
+    m_frame = (m_frame + 1) % FRAME_COUNT;
+    m_cursor = 0;
+    waitFence(m_fences[m_frame]);
+
+    m_segments.clear();
+    m_recording = -1;
 }
 
 void TextRenderer::end() {
-    glBindVertexArray(0);
-    glDisable(GL_BLEND);
-    glEnable(GL_DEPTH_TEST);
-    glEnable(GL_CULL_FACE);
+    m_recording = -1;
+    m_drawCalls = 0;
+
+    if (m_blocksDirty) {
+        uploadBlocks();
+    }
+
+    // Resolve segments to buffer offsets; adjacent ranges merge into one
+    std::vector<GLint> firsts;
+    std::vector<GLsizei> counts;
+    const size_t frameBase = m_staticCapacity + static_cast<size_t>(m_frame) * m_frameCapacity;
+    for (const Segment& segment : m_segments) {
+        if (segment.count == 0) continue;
+        GLint first = static_cast<GLint>(segment.block < 0
+            ? frameBase + segment.first
+            : m_blocks[segment.block].first);
+        if (!firsts.empty() && firsts.back() + counts.back() == first) {
+            counts.back() += static_cast<GLsizei>(segment.count);
+        } else {
+            firsts.push_back(first);
+            counts.push_back(static_cast<GLsizei>(segment.count));
+        }
+    }
+
+    if (!firsts.empty() && m_mapped) {
+        glViewport(0, 0, m_screenWidth, m_screenHeight);
+        glDisable(GL_DEPTH_TEST);
+        glDisable(GL_CULL_FACE);
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+        m_shader->use();
+        m_shader->setVec2("screenSize", glm::vec2(m_screenWidth, m_screenHeight));
+        glBindTextureUnit(0, m_fontTexture);
+        m_shader->setInt("fontTexture", 0);
+        glBindVertexArray(m_vao);
+
+        glMultiDrawArrays(GL_TRIANGLES, firsts.data(), counts.data(), static_cast<GLsizei>(firsts.size()));
+        m_drawCalls = 1;
+
+        glBindVertexArray(0);
+        glDisable(GL_BLEND);
+        glEnable(GL_DEPTH_TEST);
+        glEnable(GL_CULL_FACE);
+    }
+
+    if (m_fences[m_frame]) {
+        glDeleteSync(m_fences[m_frame]);
+    }
+    m_fences[m_frame] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
 }
 
 void TextRenderer::renderText(const std::string& text, float x, float y, float scale,
@@ -288,14 +349,13 @@ void TextRenderer::renderText(const std::string& text, float x, float y, float s
     const float texHeight = static_cast<float>(FONT_ROWS * GLYPH_HEIGHT);
     const float charW = GLYPH_WIDTH * scale;
     const float charH = GLYPH_HEIGHT * scale;
-
-    m_shader->setVec4("textColor", color);
-    m_shader->setVec4("bgColor", glm::vec4(0.0f, 0.0f, 0.0f, 0.0f));
+    const uint32_t packed = glm::packUnorm4x8(color);
 
     for (size_t i = 0; i < text.length(); ++i) {
+        // Spaces and unsupported characters leave a gap
         char c = text[i];
-        if (c < FIRST_CHAR || c >= FIRST_CHAR + CHAR_COUNT) {
-            c = ' ';
+        if (c <= FIRST_CHAR || c >= FIRST_CHAR + CHAR_COUNT) {
+            continue;
         }
 
         int charIdx = c - FIRST_CHAR;
@@ -308,39 +368,177 @@ void TextRenderer::renderText(const std::string& text, float x, float y, float s
         float v1 = ((row + 1) * GLYPH_HEIGHT) / texHeight;
 
         float xpos = x + i * charW;
-        float ypos = y;
-
-        float vertices[] = {
-            // Position          // TexCoord
-            xpos,          ypos,          u0, v0,
-            xpos + charW,  ypos,          u1, v0,
-            xpos,          ypos + charH,  u0, v1,
-
-            xpos + charW,  ypos,          u1, v0,
-            xpos + charW,  ypos + charH,  u1, v1,
-            xpos,          ypos + charH,  u0, v1,
-        };
-
-        glNamedBufferSubData(m_vbo, 0, sizeof(vertices), vertices);
-        glDrawArrays(GL_TRIANGLES, 0, 6);
+        appendQuad(xpos, y, xpos + charW, y + charH, u0, v0, u1, v1, packed);
     }
 }
 
 void TextRenderer::renderQuad(float x, float y, float width, float height,
                              const glm::vec4& color) {
-    m_shader->setVec4("textColor", glm::vec4(0.0f, 0.0f, 0.0f, 0.0f));
-    m_shader->setVec4("bgColor", color);
+    // Sample the center of the solid cell
+    const float u = ((SOLID_CELL % FONT_COLS) + 0.5f) / FONT_COLS;
+    const float v = ((SOLID_CELL / FONT_COLS) + 0.5f) / FONT_ROWS;
+    appendQuad(x, y, x + width, y + height, u, v, u, v, glm::packUnorm4x8(color));
+}
 
-    float vertices[] = {
-        x,         y,          0.0f, 0.0f,
-        x + width, y,          0.0f, 0.0f,
-        x,         y + height, 0.0f, 0.0f,
+void TextRenderer::appendQuad(float x0, float y0, float x1, float y1,
+                              float u0, float v0, float u1, float v1, uint32_t color) {
+    const Vertex quad[6] = {
+        {x0, y0, u0, v0, color},
+        {x1, y0, u1, v0, color},
+        {x0, y1, u0, v1, color},
 
-        x + width, y,          0.0f, 0.0f,
-        x + width, y + height, 0.0f, 0.0f,
-        x,         y + height, 0.0f, 0.0f,
+        {x1, y0, u1, v0, color},
+        {x1, y1, u1, v1, color},
+        {x0, y1, u0, v1, color},
     };
 
-    glNamedBufferSubData(m_vbo, 0, sizeof(vertices), vertices);
-    glDrawArrays(GL_TRIANGLES, 0, 6);
+    if (m_recording >= 0) {
+        std::vector<Vertex>& vertices = m_blocks[m_recording].vertices;
+        vertices.insert(vertices.end(), quad, quad + 6);
+        m_segments.back().count += 6;
+        return;
+    }
+
+    if (m_cursor + 6 > m_frameCapacity) {
+        // Nothing of this frame is drawn before end(), so the frame's vertices
+        // can move to a larger buffer
+        allocate(m_staticCapacity, m_frameCapacity * 2);
+    }
+    if (!m_mapped) return;
+
+    const size_t offset = m_staticCapacity + static_cast<size_t>(m_frame) * m_frameCapacity + m_cursor;
+    std::memcpy(m_mapped + offset, quad, sizeof(quad));
+
+    if (m_segments.empty() || m_segments.back().block >= 0) {
+        m_segments.push_back({-1, static_cast<uint32_t>(m_cursor), 0});
+    }
+    m_segments.back().count += 6;
+    m_cursor += 6;
+}
+
+// ========== Cached Blocks ==========
+
+int TextRenderer::createBlock() {
+    m_blocks.emplace_back();
+    return static_cast<int>(m_blocks.size()) - 1;
+}
+
+bool TextRenderer::drawBlock(int block, const std::string& key) {
+    if (block < 0 || block >= static_cast<int>(m_blocks.size())) return true;
+
+    Block& cached = m_blocks[block];
+    if (cached.key == key) {
+        m_segments.push_back({block, 0, static_cast<uint32_t>(cached.vertices.size())});
+        return true;
+    }
+
+    // Contents changed: record it again, written to the buffer in end()
+    cached.key = key;
+    cached.vertices.clear();
+    m_segments.push_back({block, 0, 0});
+    m_recording = block;
+    m_blocksDirty = true;
+    return false;
+}
+
+void TextRenderer::endBlock() {
+    m_recording = -1;
+}
+
+void TextRenderer::uploadBlocks() {
+    m_blocksDirty = false;
+
+    size_t total = 0;
+    for (const Block& block : m_blocks) {
+        total += block.vertices.size();
+    }
+
+    if (total > m_staticCapacity) {
+        // A fresh buffer has no reads in flight; allocate() writes the blocks
+        allocate(std::max(total, m_staticCapacity * 2), m_frameCapacity);
+        return;
+    }
+
+    // Earlier frames may still read the static region
+    for (int i = 0; i < FRAME_COUNT; ++i) {
+        if (i != m_frame) {
+            waitFence(m_fences[i]);
+        }
+    }
+    writeBlocks();
+}
+
+void TextRenderer::writeBlocks() {
+    size_t first = 0;
+    for (Block& block : m_blocks) {
+        block.first = static_cast<uint32_t>(first);
+        if (m_mapped && !block.vertices.empty()) {
+            std::memcpy(m_mapped + first, block.vertices.data(), block.vertices.size() * sizeof(Vertex));
+        }
+        first += block.vertices.size();
+    }
+}
+
+// ========== Buffer ==========
+
+void TextRenderer::allocate(size_t staticVertices, size_t frameVertices) {
+    // Keep what the current frame has written so far
+    std::vector<Vertex> pending;
+    if (m_mapped && m_cursor > 0) {
+        const Vertex* frameStart = m_mapped + m_staticCapacity + static_cast<size_t>(m_frame) * m_frameCapacity;
+        pending.assign(frameStart, frameStart + m_cursor);
+    }
+
+    // Orphans the old buffer; the driver keeps it alive for in-flight frames
+    release();
+
+    m_staticCapacity = staticVertices;
+    m_frameCapacity = frameVertices;
+    const size_t totalBytes = (m_staticCapacity + m_frameCapacity * FRAME_COUNT) * sizeof(Vertex);
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+    glCreateBuffers(1, &m_vbo);
+    glNamedBufferStorage(m_vbo, static_cast<GLsizeiptr>(totalBytes), nullptr, flags);
+    m_mapped = static_cast<Vertex*>(glMapNamedBufferRange(m_vbo, 0, static_cast<GLsizeiptr>(totalBytes), flags));
+    if (!m_mapped) {
+        std::cerr << "TextRenderer: failed to map " << totalBytes << " bytes" << std::endl;
+        return;
+    }
+    glVertexArrayVertexBuffer(m_vao, 0, m_vbo, 0, sizeof(Vertex));
+
+    if (!pending.empty()) {
+        std::memcpy(m_mapped + m_staticCapacity + static_cast<size_t>(m_frame) * m_frameCapacity,
+                    pending.data(), pending.size() * sizeof(Vertex));
+    }
+
+    writeBlocks();
+}
+
+void TextRenderer::release() {
+    for (GLsync& fence : m_fences) {
+        if (fence) {
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+    }
+    if (m_vbo) {
+        glUnmapNamedBuffer(m_vbo);
+        glDeleteBuffers(1, &m_vbo);
+        m_vbo = 0;
+    }
+    m_mapped = nullptr;
+}
+
+void TextRenderer::waitFence(GLsync& fence) {
+    if (!fence) return;
+
+    GLenum status = glClientWaitSync(fence, 0, 0);
+    while (status == GL_TIMEOUT_EXPIRED) {
+        status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);  // 1 ms
+    }
+    if (status == GL_WAIT_FAILED) {
+        std::cerr << "TextRenderer: fence wait failed" << std::endl;
+    }
+    glDeleteSync(fence);
+    fence = nullptr;
 }
@@ -3,39 +3,91 @@
 #include "core/Shader.h"
 #include <glad/gl.h>
 #include <glm/glm.hpp>
+#include <cstdint>
 #include <string>
 #include <memory>
+#include <vector>
 
 // Shared bitmap font text renderer for UI overlays
 // Uses an 8x8 bitmap font supporting ASCII 32-126
+//
+// Glyphs and quads of a whole frame are written into one persistently mapped,
+// triple-buffered vertex buffer and drawn with a single multi-draw in end().
+// Text that rarely changes can be recorded into a cached block, which lives in
+// a static region of the same buffer and is only rewritten when its key changes.
 class TextRenderer {
 public:
+    static constexpr int FRAME_COUNT = 3;
+
     TextRenderer();
     ~TextRenderer();
 
+    TextRenderer(const TextRenderer&) = delete;
+    TextRenderer& operator=(const TextRenderer&) = delete;
+
     // Initialize GPU resources (call after OpenGL context is ready)
     void init();
 
-    // Begin a rendering batch (sets up state)
+    // Begin a rendering batch (starts the frame's vertex region)
     void begin(int screenWidth, int screenHeight);
 
-    // End a rendering batch (restores state)
+    // End a rendering batch (draws everything queued since begin, restores state)
     void end();
 
-    // Render text at position with scale and color
+    // Queue text at position with scale and color
     void renderText(const std::string& text, float x, float y, float scale,
                    const glm::vec4& color);
 
-    // Render a solid quad (for backgrounds, borders, progress bars)
+    // Queue a solid quad (for backgrounds, borders, progress bars)
     void renderQuad(float x, float y, float width, float height,
                    const glm::vec4& color);
 
+    // ========== Cached Blocks ==========
+
+    // Handle for a block of static text
+    int createBlock();
+
+    // Queue the block if it was recorded with this key and return true.
+    // Otherwise return false and record the following renderText/renderQuad
+    // calls into the block until endBlock(); the block is queued at this point.
+    bool drawBlock(int block, const std::string& key);
+    void endBlock();
+
+    // Draw calls issued by the last end()
+    uint32_t getDrawCallCount() const { return m_drawCalls; }
+
     // Get character dimensions
     static constexpr int getCharWidth() { return GLYPH_WIDTH; }
     static constexpr int getCharHeight() { return GLYPH_HEIGHT; }
 
 private:
+    struct Vertex {
+        float x, y;
+        float u, v;
+        uint32_t color;   // RGBA8
+    };
+
+    struct Block {
+        std::string key;
+        std::vector<Vertex> vertices;
+        uint32_t first{0};   // Offset in the static region
+    };
+
+    // Consecutive range of the frame's draw; block < 0 means the frame region
+    struct Segment {
+        int block;
+        uint32_t first;
+        uint32_t count;
+    };
+
     void createFontTexture();
+    void appendQuad(float x0, float y0, float x1, float y1,
+                    float u0, float v0, float u1, float v1, uint32_t color);
+    void allocate(size_t staticVertices, size_t frameVertices);
+    void release();
+    void uploadBlocks();
+    void writeBlocks();
+    void waitFence(GLsync& fence);
 
     std::unique_ptr<Shader> m_shader;
     GLuint m_fontTexture{0};
@@ -45,10 +97,25 @@ private:
     int m_screenWidth{0};
     int m_screenHeight{0};
 
+    // Buffer layout: [static blocks][frame 0][frame 1][frame 2]
+    Vertex* m_mapped{nullptr};
+    size_t m_staticCapacity{0};
+    size_t m_frameCapacity{0};
+    int m_frame{0};
+    size_t m_cursor{0};              // Vertices written to the current frame region
+    GLsync m_fences[FRAME_COUNT]{};
+
+    std::vector<Block> m_blocks;
+    std::vector<Segment> m_segments;
+    int m_recording{-1};             // Block being recorded, or -1
+    bool m_blocksDirty{false};
+    uint32_t m_drawCalls{0};
+
     static constexpr int GLYPH_WIDTH = 8;
     static constexpr int GLYPH_HEIGHT = 8;
     static constexpr int FIRST_CHAR = 32;   // Space
     static constexpr int CHAR_COUNT = 95;   // Printable ASCII
     static constexpr int FONT_COLS = 16;
     static constexpr int FONT_ROWS = 6;
+    static constexpr int SOLID_CELL = CHAR_COUNT;  // Unused last cell, filled white for quads
 };